@@ -0,0 +1,308 @@
+#!/bin/bash
+# Pipeline benchmark suite, run by `make bench`.
+#
+# Times the mandatory and bonus binaries against the equivalent bash pipeline
+# and appends one JSON object per measurement to bench_output.txt:
+#
+#   throughput  2-stage pipelines over synthetic inputs, per command mix and
+#               launch mode (fork, posix_spawn, splice relays)
+#   stages      bonus pipelines of 2 to 1000 `cat` stages
+#   heredoc     bonus here_doc bodies, copied to a memfd or streamed
+#   shards      bonus grep|tr over one input split into 2 to 8 byte ranges
+#               (PIPEX_SHARDS), with the speedup against the single pipeline
+#   setup       empty input, so the wall time is the setup and teardown cost,
+#               per launch mode and command lookup (PATH index, command cache)
+#   path        bonus pipelines of 2, 16 and 200 `cat` stages with a long
+#               PATH, resolved by search_path() (PIPEX_PATH_INDEX=0) and by
+#               the PATH index (PIPEX_PATH_INDEX=1)
+#   args        split_args() against the double ft_split() it replaced, in ns
+#               per command, timed in-process by bench_args
+#
+# Every pipeline object carries the median and best wall time in ns, the
+# median wall time per stage, the throughput in MB/s, the peak RSS in KB of
+# the largest process of the pipeline, the exit status and whether the
+# output matched the bash pipeline. The setup cost grows linearly with the
+# number of stages, so the time per stage of the setup suite should stay
+# flat from 2 to 1000 stages.
+#
+# Tunables (environment):
+#   BENCH_SIZES        input sizes               (default "1M 16M 128M")
+#   BENCH_STAGES       stage counts              (default
+#                      "2 4 8 10 16 100 1000")
+#   BENCH_STAGE_SIZE   input of the stage suite  (default 16M)
+#   BENCH_HEREDOC      here_doc body sizes       (default "1M 16M")
+#   BENCH_SHARDS       shard counts              (default "2 4 8")
+#   BENCH_SHARD_SIZE   input of the shard suite  (default 128M)
+#   BENCH_RUNS         runs per measurement      (default 3)
+#   BENCH_SETUP_RUNS   runs per setup point      (default 50)
+#   BENCH_PATH_STAGES  stage counts, path suite  (default "2 16 200")
+#   BENCH_PATH_DIRS    generated PATH dirs       (default 200)
+#   BENCH_PATH_FILES   files per generated dir   (default 64)
+#   BENCH_ARGS_ITERS   commands split per impl   (default 1000000)
+#   BENCH_DIR          scratch directory         (default /tmp/pipex-bench)
+#   BENCH_OUTPUT       results file              (default ./bench_output.txt)
+#
+# Sizes take IEC suffixes, so BENCH_SIZES="1M 1G 10G" covers the full range.
+# Inputs are generated once and kept in BENCH_DIR; 10G needs twice that much
+# free space for the input and the outputs.
+
+set -u
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+PIPEX=$ROOT/build/pipex
+PIPEX_BONUS=$ROOT/build_bonus/pipex
+RUN=$ROOT/build/bench_run
+ARGS=$ROOT/build/bench_args
+DIR=${BENCH_DIR:-/tmp/pipex-bench}
+OUT=${BENCH_OUTPUT:-$ROOT/bench_output.txt}
+SIZES=${BENCH_SIZES:-1M 16M 128M}
+STAGES=${BENCH_STAGES:-2 4 8 10 16 100 1000}
+STAGE_SIZE=${BENCH_STAGE_SIZE:-16M}
+HEREDOC=${BENCH_HEREDOC:-1M 16M}
+SHARDS=${BENCH_SHARDS:-2 4 8}
+SHARD_SIZE=${BENCH_SHARD_SIZE:-128M}
+RUNS=${BENCH_RUNS:-3}
+SETUP_RUNS=${BENCH_SETUP_RUNS:-50}
+PATH_STAGES=${BENCH_PATH_STAGES:-2 16 200}
+PATH_DIRS=${BENCH_PATH_DIRS:-200}
+PATH_FILES=${BENCH_PATH_FILES:-64}
+ARGS_ITERS=${BENCH_ARGS_ITERS:-1000000}
+
+MIXES=(
+	"copy|cat|cat"
+	"upper|tr a-z A-Z|wc -l"
+	"grep|grep -F pipe|wc -c"
+)
+MODES=(
+	"pipex|"
+	"pipex+spawn|PIPEX_LAUNCH=spawn"
+	"pipex+splice|PIPEX_SPLICE=1"
+)
+SETUP_MODES=(
+	"pipex|"
+	"pipex+spawn|PIPEX_LAUNCH=spawn"
+	"pipex+search|PIPEX_PATH_INDEX=0"
+	"pipex+index|PIPEX_PATH_INDEX=1"
+	"pipex+cache|PIPEX_CMD_CACHE=$DIR/cmd-cache"
+)
+
+# Writes a 1 MiB seed of pseudo-random lowercase lines, 1 to 16 words long.
+seed() {
+	awk 'BEGIN {
+		srand(42)
+		split("pipe fork exec stage relay splice heredoc arena link " \
+			"buffer stream kernel signal status child parent", w, " ")
+		while (n < 1048576) {
+			k = 1 + int(rand() * 16); line = w[1 + int(rand() * 16)]
+			for (i = 1; i < k; i++) line = line " " w[1 + int(rand() * 16)]
+			print line; n += length(line) + 1
+		}
+	}' | head -c 1048576 > "$DIR/seed"
+}
+
+# Prints the path of an input of the given size, generating it if needed.
+input() {
+	local bytes file
+	bytes=$(numfmt --from=iec "$1")
+	file=$DIR/in_$1
+	if [ "$(stat -c %s "$file" 2>/dev/null)" != "$bytes" ]; then
+		while cat "$DIR/seed"; do :; done 2>/dev/null | head -c "$bytes" \
+			> "$file"
+	fi
+	echo "$file"
+}
+
+# Prints a here_doc stream: a body of the given size followed by "EOF".
+heredoc_input() {
+	local file=$DIR/hd_$1
+	if [ ! -f "$file" ]; then
+		{ head -c "$(numfmt --from=iec "$1")" "$(input "$1")" | sed '$d'; \
+			echo EOF; } > "$file"
+	fi
+	echo "$file"
+}
+
+# Prints the median wall time of a bench_run or record result.
+wall_ns() {
+	sed 's/.*"wall_ns":\([0-9]*\).*/\1/' <<< "$1"
+}
+
+# record SUITE IMPL MIX STAGES BYTES MATCH STDIN CMD...
+# Runs CMD through bench_run and appends the JSON result.
+record() {
+	local suite=$1 impl=$2 mix=$3 stages=$4 bytes=$5 match=$6 stdin=$7
+	local res wall
+	shift 7
+	res=$("$RUN" "$RUNS" "$stdin" "$@") || return
+	wall=$(wall_ns "$res")
+	printf '{"suite":"%s","impl":"%s","mix":"%s","stages":%d,"bytes":%d,' \
+		"$suite" "$impl" "$mix" "$stages" "$bytes"
+	printf '"ns_per_stage":%d,"mb_s":%d,"match":%s,%s}\n' \
+		"$((wall / stages))" "$((bytes * 1000 / wall))" "$match" "$res"
+}
+
+# Prints true if both files are identical, false otherwise.
+same() {
+	cmp -s "$1" "$2" && echo true || echo false
+}
+
+bench_throughput() {
+	local size in bytes mix name c1 c2 mode impl env
+	for size in $SIZES; do
+		in=$(input "$size")
+		bytes=$(stat -c %s "$in")
+		for mix in "${MIXES[@]}"; do
+			IFS='|' read -r name c1 c2 <<< "$mix"
+			record throughput bash "$name" 2 "$bytes" true - \
+				bash -c "$c1 < '$in' | $c2 > '$DIR/ref'"
+			for mode in "${MODES[@]}"; do
+				IFS='|' read -r impl env <<< "$mode"
+				env $env "$PIPEX" "$in" "$c1" "$c2" "$DIR/out"
+				record throughput "$impl" "$name" 2 "$bytes" \
+					"$(same "$DIR/ref" "$DIR/out")" - \
+					env $env "$PIPEX" "$in" "$c1" "$c2" "$DIR/out"
+			done
+		done
+	done
+}
+
+bench_stages() {
+	local n in bytes args line
+	in=$(input "$STAGE_SIZE")
+	bytes=$(stat -c %s "$in")
+	for n in $STAGES; do
+		args=()
+		line="cat < '$in'"
+		for _ in $(seq "$n"); do args+=(cat); done
+		for _ in $(seq $((n - 1))); do line="$line | cat"; done
+		record stages bash cat "$n" "$bytes" true - \
+			bash -c "$line > '$DIR/ref'"
+		"$PIPEX_BONUS" "$in" "${args[@]}" "$DIR/out"
+		record stages pipex cat "$n" "$bytes" \
+			"$(same "$DIR/ref" "$DIR/out")" - \
+			"$PIPEX_BONUS" "$in" "${args[@]}" "$DIR/out"
+	done
+}
+
+# Prints true if one here_doc run of pipex appends the same as bash.
+heredoc_same() {
+	local hd=$1
+	shift
+	rm -f "$DIR/hd_ref" "$DIR/hd_out"
+	sed '/^EOF$/Q' < "$hd" > "$DIR/hd_ref"
+	"$@" here_doc EOF cat cat "$DIR/hd_out" < "$hd"
+	same "$DIR/hd_ref" "$DIR/hd_out"
+}
+
+bench_heredoc() {
+	local size hd bytes
+	for size in $HEREDOC; do
+		hd=$(heredoc_input "$size")
+		bytes=$(stat -c %s "$hd")
+		record heredoc bash copy 2 "$bytes" true "$hd" \
+			bash -c "sed '/^EOF\$/Q' | cat >> '$DIR/hd_ref'"
+		record heredoc pipex copy 2 "$bytes" \
+			"$(heredoc_same "$hd" "$PIPEX_BONUS")" "$hd" \
+			"$PIPEX_BONUS" here_doc EOF cat cat "$DIR/hd_out"
+		record heredoc pipex+stream copy 2 "$bytes" \
+			"$(heredoc_same "$hd" env PIPEX_HEREDOC_STREAM=1 "$PIPEX_BONUS")" \
+			"$hd" env PIPEX_HEREDOC_STREAM=1 "$PIPEX_BONUS" here_doc EOF \
+			cat cat "$DIR/hd_out"
+		rm -f "$DIR/hd_ref" "$DIR/hd_out"
+	done
+}
+
+# Compares the single pipeline with PIPEX_SHARDS runs of it. Every sharded
+# result carries its speedup against the single one.
+bench_shards() {
+	local in bytes k res base
+	local c1="grep -F pipe" c2="tr a-z A-Z"
+	in=$(input "$SHARD_SIZE")
+	bytes=$(stat -c %s "$in")
+	"$PIPEX_BONUS" "$in" "$c1" "$c2" "$DIR/ref"
+	res=$(record shards pipex grep 2 "$bytes" true - \
+		"$PIPEX_BONUS" "$in" "$c1" "$c2" "$DIR/out")
+	echo "$res"
+	base=$(wall_ns "$res")
+	for k in $SHARDS; do
+		PIPEX_SHARDS=$k "$PIPEX_BONUS" "$in" "$c1" "$c2" "$DIR/out"
+		res=$(record shards "pipex+shards=$k" grep 2 "$bytes" \
+			"$(same "$DIR/ref" "$DIR/out")" - \
+			env PIPEX_SHARDS="$k" "$PIPEX_BONUS" "$in" "$c1" "$c2" "$DIR/out")
+		echo "${res%\}},\"speedup\":$(awk -v b="$base" -v w="$(wall_ns "$res")" \
+			'BEGIN { printf "%.2f", b / w }')}"
+	done
+	rm -f "$DIR/ref"
+}
+
+bench_setup() {
+	local n args line mode impl env
+	for n in $STAGES; do
+		args=()
+		line="cat < /dev/null"
+		for _ in $(seq "$n"); do args+=(cat); done
+		for _ in $(seq $((n - 1))); do line="$line | cat"; done
+		RUNS=$SETUP_RUNS record setup bash cat "$n" 0 true - \
+			bash -c "$line > '$DIR/out'"
+		if [ "$n" = 2 ]; then
+			RUNS=$SETUP_RUNS record setup pipex-mandatory cat 2 0 true - \
+				"$PIPEX" /dev/null cat cat "$DIR/out"
+		fi
+		for mode in "${SETUP_MODES[@]}"; do
+			IFS='|' read -r impl env <<< "$mode"
+			RUNS=$SETUP_RUNS record setup "$impl" cat "$n" 0 true - \
+				env $env "$PIPEX_BONUS" /dev/null "${args[@]}" "$DIR/out"
+		done
+	done
+}
+
+# Prints a PATH of PATH_DIRS generated directories of PATH_FILES files each,
+# none of them a command, followed by the real PATH.
+long_path() {
+	local d f path=
+	for ((d = 0; d < PATH_DIRS; d++)); do
+		if [ ! -d "$DIR/path/$d" ]; then
+			mkdir -p "$DIR/path/$d"
+			for ((f = 0; f < PATH_FILES; f++)); do
+				: > "$DIR/path/$d/tool$f"
+			done
+		fi
+		path=$path$DIR/path/$d:
+	done
+	echo "$path$PATH"
+}
+
+# Times the setup of pipelines whose commands are found only after the
+# generated PATH directories, with and without the PATH index.
+bench_path() {
+	local n args path impl env res
+	path=$(long_path)
+	for n in $PATH_STAGES; do
+		args=()
+		for _ in $(seq "$n"); do args+=(cat); done
+		for env in PIPEX_PATH_INDEX=0 PIPEX_PATH_INDEX=1; do
+			impl=pipex+search
+			[ "$env" = PIPEX_PATH_INDEX=1 ] && impl=pipex+index
+			res=$(RUNS=$SETUP_RUNS record path "$impl" cat "$n" 0 true - \
+				env PATH="$path" $env "$PIPEX_BONUS" /dev/null "${args[@]}" \
+				"$DIR/out")
+			echo "${res%\}},\"path_dirs\":$PATH_DIRS}"
+		done
+	done
+}
+
+bench_args() {
+	"$ARGS" "$ARGS_ITERS"
+}
+
+mkdir -p "$DIR" || exit 1
+[ -f "$DIR/seed" ] || seed
+{
+	bench_setup
+	bench_throughput
+	bench_stages
+	bench_heredoc
+	bench_shards
+	bench_path
+	bench_args
+} | tee "$OUT"
+echo "Results written to $OUT" >&2
@@ -0,0 +1,138 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_args.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 10:21:58 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 10:21:58 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+#define BENCH_CMDS 3
+
+/**
+ * @brief Returns the monotonic clock in nanoseconds.
+ */
+static long	clock_ns(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1000000000L + ts.tv_nsec);
+}
+
+/**
+ * @brief Splits a command the way pipex did before split_args(): once with
+ *        ft_split() to resolve it and once more to execute it, each vector
+ *        freed token by token.
+ *
+ * @param cmd The command.
+ * @return 0 on success, 1 if memory could not be allocated.
+ */
+static int	old_split(const char *cmd)
+{
+	char	**args;
+	int		i;
+
+	i = 0;
+	while (i++ < 2)
+	{
+		args = ft_split(cmd, ' ');
+		if (!args)
+			return (1);
+		ft_matrix_free((void **)args, 0);
+	}
+	return (0);
+}
+
+/**
+ * @brief Times one tokenizer over a command.
+ *
+ * @param cmd The command.
+ * @param n Number of iterations.
+ * @param arena The arena given to split_args(), rewound after every call,
+ *              or NULL to time old_split() instead.
+ * @return Nanoseconds per command, or -1 if memory could not be allocated.
+ */
+static long	time_split(const char *cmd, long n, t_arena *arena)
+{
+	t_arena_mark	mark;
+	long			start;
+	long			i;
+
+	if (arena)
+		mark = ft_arena_mark(arena);
+	start = clock_ns();
+	i = 0;
+	while (i++ < n)
+	{
+		if (arena && !split_args(arena, cmd))
+			return (-1);
+		if (arena)
+			ft_arena_reset(arena, mark);
+		else if (old_split(cmd))
+			return (-1);
+	}
+	return ((clock_ns() - start) / n);
+}
+
+/**
+ * @brief Writes one result as a JSON object on the standard output.
+ *
+ * @param impl Name of the tokenizer.
+ * @param cmd The command.
+ * @param n Number of iterations.
+ * @param ns Nanoseconds per command.
+ */
+static void	report(const char *impl, const char *cmd, long n, long ns)
+{
+	char		buf[512];
+	t_outbuf	out;
+
+	ft_outbuf_init(&out, STDOUT_FILENO, buf, sizeof(buf));
+	ft_bprintf(&out, "{\"suite\":\"args\",\"impl\":\"%s\",\"cmd\":\"%s\","
+		"\"iterations\":", impl, cmd);
+	ft_outbuf_num(&out, n, "0123456789");
+	ft_bprintf(&out, ",\"ns_per_cmd\":");
+	ft_outbuf_num(&out, ns, "0123456789");
+	ft_bprintf(&out, "}\n");
+	ft_outbuf_flush(&out);
+}
+
+/**
+ * @brief Times split_args() against the double ft_split() it replaced, on a
+ *        short, a medium and a long command.
+ *
+ * Usage: bench_args ITERATIONS
+ */
+int	main(int argc, char *argv[])
+{
+	static const char	*cmds[BENCH_CMDS] = {"cat",
+		"grep -v -e foo -e bar --color=never",
+		"awk -F : -v OFS=, -v n=1 -v m=2 '{print $1,$2}' /etc/passwd"};
+	t_arena				arena;
+	long				ns[2];
+	long				n;
+	int					i;
+
+	if (argc != 2 || ft_atoi(argv[1]) < 1)
+		return (ft_dprintf(2, "usage: %s ITERATIONS\n", argv[0]), 2);
+	n = ft_atoi(argv[1]);
+	ft_arena_init(&arena);
+	i = -1;
+	while (++i < BENCH_CMDS)
+	{
+		ns[0] = time_split(cmds[i], n, NULL);
+		ns[1] = time_split(cmds[i], n, &arena);
+		if (ns[0] < 0 || ns[1] < 0)
+			return (ft_arena_destroy(&arena), perror("bench_args"), 1);
+		report("ft_split", cmds[i], n, ns[0]);
+		report("split_args", cmds[i], n, ns[1]);
+	}
+	ft_arena_destroy(&arena);
+	return (0);
+}
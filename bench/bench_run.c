@@ -0,0 +1,154 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_run.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 09:19:53 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 09:23:19 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "libft.h"
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <time.h>
+
+#define BENCH_MAX_RUNS 256
+
+/**
+ * @brief Returns the monotonic clock in nanoseconds.
+ */
+static long	now_ns(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1000000000L + ts.tv_nsec);
+}
+
+/**
+ * @brief Runs the command once, with its standard input read from input and
+ *        its standard output discarded, and waits for it.
+ *
+ * @param argv The command and its arguments, looked up in PATH.
+ * @param input File for the standard input, or "-" to inherit it.
+ * @param rss Raised to the peak resident set size of the command, in KB.
+ *            wait4(2) folds in every descendant the command waited for, so
+ *            this is the largest process of the whole pipeline.
+ * @param status Set to the exit status, or 128 plus the signal number.
+ * @return The wall time of the run in nanoseconds, or -1 on failure.
+ */
+static long	run_once(char **argv, char *input, long *rss, int *status)
+{
+	struct rusage	usage;
+	long			start;
+	pid_t			pid;
+
+	start = now_ns();
+	pid = fork();
+	if (pid == 0)
+	{
+		if (ft_strncmp(input, "-", 2) != 0)
+			dup2(open(input, O_RDONLY), STDIN_FILENO);
+		dup2(open("/dev/null", O_WRONLY), STDOUT_FILENO);
+		execvp(argv[0], argv);
+		_exit(127);
+	}
+	if (pid == -1 || wait4(pid, status, 0, &usage) == -1)
+		return (-1);
+	start = now_ns() - start;
+	if (usage.ru_maxrss > *rss)
+		*rss = usage.ru_maxrss;
+	if (WIFSIGNALED(*status))
+		*status = 128 + WTERMSIG(*status);
+	else
+		*status = WEXITSTATUS(*status);
+	return (start);
+}
+
+/**
+ * @brief Sorts the wall times of the runs in ascending order.
+ *
+ * @param walls The wall times.
+ * @param n Number of runs.
+ */
+static void	sort_walls(long *walls, int n)
+{
+	long	wall;
+	int		i;
+	int		j;
+
+	i = 0;
+	while (++i < n)
+	{
+		wall = walls[i];
+		j = i;
+		while (j > 0 && walls[j - 1] > wall)
+		{
+			walls[j] = walls[j - 1];
+			--j;
+		}
+		walls[j] = wall;
+	}
+}
+
+/**
+ * @brief Writes the results as JSON members on the standard output.
+ *
+ * @param walls The sorted wall times.
+ * @param n Number of runs.
+ * @param stats Peak resident set size of the command and exit status.
+ */
+static void	report(long *walls, int n, long *stats)
+{
+	char		buf[512];
+	t_outbuf	out;
+
+	ft_outbuf_init(&out, STDOUT_FILENO, buf, sizeof(buf));
+	ft_bprintf(&out, "\"runs\":%d,\"wall_ns\":", n);
+	ft_outbuf_num(&out, walls[n / 2], "0123456789");
+	ft_bprintf(&out, ",\"min_ns\":");
+	ft_outbuf_num(&out, walls[0], "0123456789");
+	ft_bprintf(&out, ",\"rss_kb\":");
+	ft_outbuf_num(&out, stats[0], "0123456789");
+	ft_bprintf(&out, ",\"status\":%d\n", (int)stats[1]);
+	ft_outbuf_flush(&out);
+}
+
+/**
+ * @brief Runs a command several times and reports its median wall time,
+ *        peak memory and exit status.
+ *
+ * Usage: bench_run RUNS INPUT COMMAND [ARGS...]
+ */
+int	main(int argc, char *argv[])
+{
+	long	walls[BENCH_MAX_RUNS];
+	long	stats[2];
+	int		status;
+	int		n;
+	int		i;
+
+	if (argc < 4)
+		return (ft_dprintf(2, "usage: %s RUNS INPUT CMD...\n",
+				argv[0]), 2);
+	n = ft_atoi(argv[1]);
+	if (n < 1 || n > BENCH_MAX_RUNS)
+		return (ft_dprintf(2, "%s: RUNS must be 1-%d\n", argv[0],
+				BENCH_MAX_RUNS), 2);
+	stats[0] = 0;
+	i = -1;
+	while (++i < n)
+	{
+		walls[i] = run_once(argv + 3, argv[2], &stats[0], &status);
+		if (walls[i] < 0)
+			return (perror("bench_run"), 1);
+	}
+	stats[1] = status;
+	sort_walls(walls, n);
+	report(walls, n, stats);
+	return (0);
+}
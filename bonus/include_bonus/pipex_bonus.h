@@ -6,18 +6,754 @@
 /*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/03/21 13:33:49 by pablo             #+#    #+#             */
-/*   Updated: 2025/05/26 19:31:33 by pabmart2         ###   ########.fr       */
+/*   Updated: 2026/10/17 11:05:54 by pabmart2         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #ifndef PIPEX_BONUS_H
 # define PIPEX_BONUS_H
+# ifndef _GNU_SOURCE
+#  define _GNU_SOURCE
+# endif
 # include "libft.h"
 # include <fcntl.h>
+# include <limits.h>
+# include <linux/futex.h>
+# include <poll.h>
+# include <pthread.h>
+# include <signal.h>
+# include <spawn.h>
+# include <stdatomic.h>
+# include <stddef.h>
+# include <sys/epoll.h>
+# include <sys/eventfd.h>
+# include <sys/file.h>
+# include <sys/ioctl.h>
+# include <sys/mman.h>
+# include <sys/resource.h>
+# include <sys/sendfile.h>
+# include <sys/stat.h>
+# include <sys/syscall.h>
 # include <sys/types.h>
 # include <sys/wait.h>
+# include <time.h>
 # include <unistd.h>
 
+# define LAUNCH_FORK 0
+# define LAUNCH_SPAWN 1
+# define RELAY_CHUNK 65536
+# define PIPE_MAX_FILE "/proc/sys/fs/pipe-max-size"
+# define PIPE_MAX_DEFAULT 1048576
+# define PIPE_TUNE_MS 1
+# define PIPE_TUNE_STREAK 4
+# define RELAY_SAMPLE_MS 1
+# define TIMEOUT_GRACE_MS 2000
+# define SUPERVISE_POLL_MS 10
+# define CMD_CACHE_FILE "/dev/shm/pipex-cmd-cache-%u"
+# define CMD_CACHE_MAGIC 0x50584301
+# define CMD_CACHE_SLOTS 256
+# define CMD_CACHE_NAME 64
+# define CMD_CACHE_PATH 256
+# define CMD_CACHE_DIRS 32
+# define CMD_CACHE_FNV 14695981039346656037UL
+# define PATH_INDEX_STAGES 64
+# define PATH_INDEX_SLOTS 1024
+# define PATH_INDEX_POOL 16384
+# define PATH_INDEX_DIRENT 32768
+# define REPORT_BUF 8192
+# define HEREDOC_NAME "pipex-heredoc"
+# define HEREDOC_TMPDIR "/tmp"
+# define HEREDOC_CHUNK 65536
+# define BATCH_CHUNK 65536
+# define SHARD_MAX 64
+# define SHARD_NAME "pipex-shard"
+# define SHARD_COPY 1048576
+# define FANOUT_SEP "--"
+# define FANOUT_PATH 24
+# define DAG_SEP ':'
+# define DAG_PATH 24
+# define BUILTIN_BUF 65536
+# define BUILTIN_RING 262144
+# define BUILTIN_SET 1024
+# define BUILTIN_LINES 10
+# define BUILTIN_SIG SIGUSR1
+# define BUILTIN_WAKE_MS 10
+
+/**
+ * @struct s_pipex_opts
+ * @brief Runtime options read from the environment at startup.
+ *
+ * @param launch
+ * Backend used to start each stage: LAUNCH_FORK (default) or LAUNCH_SPAWN,
+ * selected with PIPEX_LAUNCH=fork|spawn.
+ *
+ * @param stats
+ * Non-zero when PIPEX_STATS is set (and not "0"). A JSON report is written
+ * to stderr at exit.
+ *
+ * @param splice
+ * Non-zero when PIPEX_SPLICE is set (and not "0"). The parent owns the
+ * input (infile or heredoc) and the outfile and moves their data with
+ * splice(2), see t_relay.
+ *
+ * @param instrument
+ * Non-zero when PIPEX_INSTRUMENT is set (and not "0"). Every link between
+ * stages is pumped by the parent so its traffic can be measured, see
+ * t_relay.
+ *
+ * @param pipefail
+ * Non-zero when PIPEX_PIPEFAIL is set (and not "0"). The first stage to
+ * fail tears down every stage upstream of it and gives the exit status, see
+ * check_pipefail().
+ *
+ * @param pipe_size
+ * Value of PIPEX_PIPE_SIZE, or NULL if unset. It is a comma separated list of
+ * capacities, one per link, see pipe_size_opt().
+ *
+ * @param timeout_ms
+ * Wall-clock limit of the whole pipeline from PIPEX_TIMEOUT, in
+ * milliseconds, or 0 if unset. See duration_opt().
+ *
+ * @param stage_timeout
+ * Value of PIPEX_STAGE_TIMEOUT, or NULL if unset. It is a comma separated
+ * list of wall-clock limits, one per stage, see duration_opt().
+ *
+ * @param path_index
+ * Minimum number of stages for which the PATH index is built, from
+ * PIPEX_PATH_INDEX, or PATH_INDEX_STAGES if unset. 0 never builds it. See
+ * path_index_build().
+ *
+ * @param heredoc_stream
+ * Non-zero when PIPEX_HEREDOC_STREAM is set (and not "0"). The heredoc is
+ * not stored: the parent forwards it to the first command as it is read,
+ * see set_heredoc().
+ *
+ * @param shards
+ * Number of byte ranges the infile is split into, from PIPEX_SHARDS, or 0 if
+ * unset. Above 1 the pipeline runs once per range, see shard_loop().
+ *
+ * @param builtins
+ * Non-zero when PIPEX_BUILTINS is set (and not "0"). The trivial filters
+ * plan_builtin() supports run as threads of pipex instead of commands.
+ */
+typedef struct s_pipex_opts
+{
+	char	launch;
+	char	stats;
+	char	splice;
+	char	instrument;
+	char	pipefail;
+	char	*pipe_size;
+	long	timeout_ms;
+	char	*stage_timeout;
+	int		path_index;
+	char	heredoc_stream;
+	long	shards;
+	char	builtins;
+}			t_popts;
+
+/**
+ * @struct s_heredoc
+ * @brief State of the heredoc reader, see heredoc_step().
+ *
+ * @param eof
+ * The delimiter, without its newline.
+ *
+ * @param eof_len
+ * Length of the delimiter.
+ *
+ * @param buf
+ * HEREDOC_CHUNK bytes of input. Only the start of a line that may still be
+ * the delimiter is kept between reads.
+ *
+ * @param len
+ * Bytes held in buf.
+ *
+ * @param tainted
+ * Non-zero if the start of the current line was already forwarded, so it
+ * cannot be the delimiter.
+ *
+ * @param prompt
+ * Non-zero if stdin is a terminal, so "heredoc >" is printed before each
+ * line.
+ *
+ * @param done
+ * Set once the delimiter or the end of the input has been read.
+ */
+typedef struct s_heredoc
+{
+	const char	*eof;
+	size_t		eof_len;
+	char		*buf;
+	size_t		len;
+	char		tainted;
+	char		prompt;
+	char		done;
+}				t_heredoc;
+
+/**
+ * @struct s_relay
+ * @brief A data path between two descriptors pumped by the parent.
+ *
+ * @param in
+ * Descriptor data is read from, or -1 once the relay is finished.
+ *
+ * @param out
+ * Descriptor data is written to, or -1 once the relay is finished.
+ *
+ * @param poll_in
+ * Non-zero if in is a pipe that must be polled for POLLIN.
+ *
+ * @param poll_out
+ * Non-zero if out is a pipe that must be polled for POLLOUT.
+ *
+ * @param heredoc
+ * Reader the data goes through when the relay streams the heredoc, NULL
+ * otherwise. See heredoc_step().
+ *
+ * @param use_rw
+ * Set when splice(2) is not supported by one of the ends (for instance an
+ * outfile opened with O_APPEND), so data is copied with read(2)/write(2).
+ *
+ * @param left
+ * Bytes the relay may still move before it finishes, or SIZE_MAX if it runs
+ * until EOF. Only bounded for the input of a shard, see t_shard.
+ *
+ * @param slot
+ * Indexes of in and out in the current poll set, or -1.
+ *
+ * @param bytes
+ * Bytes moved so far.
+ *
+ * @param reads
+ * Successful reads from in so far. A splice(2) counts as a read and a write.
+ *
+ * @param writes
+ * Successful writes to out so far.
+ *
+ * @param blocked
+ * Non-zero if in was a full pipe at the last sample, meaning its writer is
+ * blocked.
+ *
+ * @param waiting
+ * Non-zero if out was an empty pipe at the last sample, meaning its reader
+ * is waiting for data.
+ *
+ * @param blocked_ns
+ * Time in was found full, in nanoseconds. Only sampled with PIPEX_INSTRUMENT.
+ *
+ * @param wait_ns
+ * Time out was found empty, in nanoseconds. Only sampled with
+ * PIPEX_INSTRUMENT.
+ */
+typedef struct s_relay
+{
+	int		in;
+	int		out;
+	char		poll_in;
+	char		poll_out;
+	t_heredoc	*heredoc;
+	char		use_rw;
+	size_t		left;
+	int		slot[2];
+	size_t		bytes;
+	size_t		reads;
+	size_t		writes;
+	char		blocked;
+	char		waiting;
+	long		blocked_ns;
+	long		wait_ns;
+}				t_relay;
+
+/**
+ * @struct s_link
+ * @brief Capacity bookkeeping of a pipe between two stages.
+ *
+ * @param rd
+ * Parent copy of the read end, kept while the link is auto-tuned so its fill
+ * level can be sampled. It is -1 otherwise, and is closed as soon as the
+ * reading stage has exited so the writer still gets SIGPIPE.
+ *
+ * @param size
+ * Current capacity of the pipe in bytes.
+ *
+ * @param max
+ * Largest capacity the link may be given, from PIPE_MAX_FILE.
+ *
+ * @param autosize
+ * Non-zero if the capacity is auto-tuned.
+ *
+ * @param streak
+ * Consecutive samples that found the pipe full.
+ *
+ * @param grows
+ * Times the capacity has been doubled by the auto mode.
+ */
+typedef struct s_link
+{
+	int		rd;
+	int		size;
+	int		max;
+	char	autosize;
+	int		streak;
+	int		grows;
+}			t_link;
+
+/**
+ * @struct s_ring
+ * @brief Lock-free single-producer single-consumer byte ring carrying the
+ *        output of a builtin stage to the next one, see ring_write() and
+ *        ring_peek().
+ *
+ * @param data
+ * Storage of the ring, size bytes long.
+ *
+ * @param size
+ * Capacity of the ring, a power of two.
+ *
+ * @param head
+ * Bytes written so far. Only the producer stores it.
+ *
+ * @param tail
+ * Bytes read so far. Only the consumer stores it.
+ *
+ * @param seq
+ * Bumped after every change of the ring. A side that finds the ring full or
+ * empty sleeps on it with futex(2), see ring_wait().
+ *
+ * @param waiters
+ * Number of sides sleeping on seq, so a change only costs a futex wake when
+ * someone is waiting.
+ *
+ * @param eof
+ * Set by the producer once it is done.
+ *
+ * @param gone
+ * Set by the consumer once it is done, so the producer stops as it would on
+ * EPIPE.
+ */
+typedef struct s_ring
+{
+	char			*data;
+	size_t			size;
+	_Atomic size_t	head;
+	_Atomic size_t	tail;
+	_Atomic int		seq;
+	_Atomic int		waiters;
+	_Atomic char	eof;
+	_Atomic char	gone;
+}					t_ring;
+
+struct	s_builtin;
+
+/**
+ * @brief Processes one span of the input of a builtin stage.
+ *
+ * The span may be modified in place. Returns non-zero to stop reading,
+ * either because the builtin is done or because its output failed.
+ */
+typedef int			(*t_bfilter)(struct s_builtin *b, char *data, size_t len);
+
+/**
+ * @brief Writes what a builtin stage holds back until the end of its
+ *        input. Returns non-zero if the output failed.
+ */
+typedef int			(*t_bfinish)(struct s_builtin *b);
+
+/**
+ * @struct s_builtin
+ * @brief A stage run by a thread of pipex, see plan_builtin() and
+ *        start_builtins().
+ *
+ * @param filter
+ * Called for every span of input.
+ *
+ * @param finish
+ * Called once at the end of the input, or NULL.
+ *
+ * @param name
+ * Command name, used in error messages.
+ *
+ * @param count
+ * Lines left to copy for head, lines to keep for tail, or what wc counted.
+ *
+ * @param map
+ * Translation table of tr, or the set of bytes tr -d deletes.
+ *
+ * @param keep
+ * Lines kept by tail, allocated by the thread.
+ *
+ * @param kept
+ * Bytes used in keep.
+ *
+ * @param cap
+ * Capacity of keep.
+ *
+ * @param in
+ * Descriptor the stage reads from, or -1 if it reads rin.
+ *
+ * @param out
+ * Descriptor the stage writes to, or -1 if it writes rout.
+ *
+ * @param rin
+ * Ring fed by the previous builtin stage, or NULL.
+ *
+ * @param rout
+ * Ring feeding the next builtin stage, or NULL.
+ *
+ * @param buf
+ * BUILTIN_BUF bytes to read in into when the input is a descriptor.
+ *
+ * @param thread
+ * Thread running the stage.
+ *
+ * @param started
+ * Non-zero while the thread exists and has not been joined.
+ *
+ * @param done_fd
+ * Eventfd the thread signals once it is done. It is the pidfd of the stage,
+ * so wait_childs() watches it like the pidfd of a process.
+ *
+ * @param done
+ * Set once the thread is done, after done_fd is signalled.
+ *
+ * @param cancel
+ * Signal a deadline or a pipefail teardown sent to the stage, or 0, see
+ * cancel_builtin().
+ *
+ * @param wstatus
+ * Status the stage ended with, encoded like a wait(2) status.
+ *
+ * @param usage
+ * Resources used by the thread, from getrusage(RUSAGE_THREAD).
+ */
+typedef struct s_builtin
+{
+	t_bfilter		filter;
+	t_bfinish		finish;
+	char			*name;
+	long			count;
+	unsigned char	map[256];
+	char			*keep;
+	size_t			kept;
+	size_t			cap;
+	int				in;
+	int				out;
+	t_ring			*rin;
+	t_ring			*rout;
+	char			*buf;
+	pthread_t		thread;
+	char			started;
+	int				done_fd;
+	_Atomic int		done;
+	_Atomic int		cancel;
+	int				wstatus;
+	struct rusage	usage;
+}					t_builtin;
+
+/**
+ * @struct s_stage
+ * @brief Per-stage bookkeeping kept by the parent.
+ *
+ * @param pid
+ * PID of the stage, or -1 if it could not be launched.
+ *
+ * @param status
+ * Exit status of the stage once it has been waited for, 128 plus the signal
+ * number if it was killed, or the status it would have exited with if it
+ * could not be launched.
+ *
+ * @param launch_ns
+ * Wall-clock time the parent spent inside fork() or posix_spawn() for this
+ * stage, in nanoseconds.
+ *
+ * @param usage
+ * Resources used by the stage, as returned by wait4() when it was reaped.
+ * It is all zeros if the stage could not be launched.
+ *
+ * @param pidfd
+ * Process file descriptor of the stage from pidfd_open(2), opened and
+ * watched by wait_childs() once every stage is launched, so launching holds
+ * no descriptor per stage. It is -1 before that, once the stage is reaped,
+ * or if it cannot be opened.
+ *
+ * @param deadline_ns
+ * CLOCK_MONOTONIC time, in nanoseconds, at which the stage is signalled
+ * next, or 0 if it has no deadline. See check_deadlines().
+ *
+ * @param signals
+ * Number of signals sent because of a deadline or a pipefail teardown: 1
+ * after SIGTERM, 2 after SIGKILL. See signal_stage().
+ *
+ * @param reaped
+ * Non-zero once the stage has been waited for.
+ *
+ * @param path
+ * Executable of the stage, resolved by plan_stages() before any stage is
+ * launched.
+ *
+ * @param args
+ * NULL-terminated argument vector of the stage, split by plan_stages() with
+ * split_args(). Both live in the run arena, see t_pinfo.
+ *
+ * @param quoted
+ * One flag per argument, 1 if it was quoted or escaped, see split_args().
+ *
+ * @param builtin
+ * The thread running the stage if it is a builtin, or NULL. Its pid is then
+ * the one of pipex itself.
+ */
+typedef struct s_stage
+{
+	pid_t			pid;
+	int				status;
+	long			launch_ns;
+	struct rusage	usage;
+	int				pidfd;
+	long			deadline_ns;
+	char			signals;
+	char			reaped;
+	char			*path;
+	char			**args;
+	char			*quoted;
+	t_builtin		*builtin;
+}					t_stage;
+
+/**
+ * @struct s_cmd_entry
+ * @brief A command resolved through PATH, as stored in the command cache.
+ *
+ * @param seq
+ * Seqlock of the entry. It is odd while a writer is updating it.
+ *
+ * @param path_hash
+ * Hash of the PATH string the command was resolved with.
+ *
+ * @param name
+ * Name of the command with a leading '/', as joined to the PATH entries.
+ *
+ * @param path
+ * Absolute path the command was resolved to.
+ *
+ * @param dir
+ * Index of the PATH directory holding the command.
+ *
+ * @param mtimes
+ * Modification time of every PATH directory up to dir, taken before they
+ * were searched.
+ */
+typedef struct s_cmd_entry
+{
+	unsigned int	seq;
+	unsigned long	path_hash;
+	char			name[CMD_CACHE_NAME];
+	char			path[CMD_CACHE_PATH];
+	int				dir;
+	struct timespec	mtimes[CMD_CACHE_DIRS];
+}					t_cmd_entry;
+
+/**
+ * @struct s_cmd_file
+ * @brief Layout of the command cache file.
+ *
+ * @param magic
+ * CMD_CACHE_MAGIC once the file has been laid out.
+ *
+ * @param entries
+ * Direct-mapped table of entries, indexed by the hash of the command name
+ * and PATH.
+ */
+typedef struct s_cmd_file
+{
+	unsigned int	magic;
+	t_cmd_entry		entries[CMD_CACHE_SLOTS];
+}					t_cmd_file;
+
+/**
+ * @struct s_cmd_cache
+ * @brief Handle of the command cache of a pipex instance.
+ *
+ * @param map
+ * Shared mapping of the cache file.
+ *
+ * @param fd
+ * The cache file, locked with flock(2) while an entry is written.
+ *
+ * @param state
+ * 0 until the cache is opened, 1 once mapped, -1 if it is disabled.
+ */
+typedef struct s_cmd_cache
+{
+	t_cmd_file	*map;
+	int			fd;
+	char		state;
+}				t_cmd_cache;
+
+/**
+ * @struct s_dirent64
+ * @brief Directory entry as returned by getdents64(2).
+ *
+ * @param d_ino
+ * Inode number.
+ *
+ * @param d_off
+ * Offset of the next entry, opaque.
+ *
+ * @param d_reclen
+ * Size of this entry, including its name and padding.
+ *
+ * @param d_type
+ * File type, DT_UNKNOWN on filesystems that do not report it.
+ *
+ * @param d_name
+ * NUL-terminated name of the entry.
+ */
+typedef struct s_dirent64
+{
+	unsigned long	d_ino;
+	long			d_off;
+	unsigned short	d_reclen;
+	unsigned char	d_type;
+	char			d_name[];
+}					t_dirent64;
+
+/**
+ * @struct s_path_slot
+ * @brief A name of the PATH index.
+ *
+ * @param hash
+ * Hash of the name, see fnv_hash().
+ *
+ * @param name
+ * Offset of the name in the string pool plus one, or 0 if the slot is free.
+ *
+ * @param dir
+ * Index in PATH of the first directory that has an entry with this name.
+ */
+typedef struct s_path_slot
+{
+	unsigned long	hash;
+	size_t			name;
+	size_t			dir;
+}					t_path_slot;
+
+/**
+ * @struct s_path_index
+ * @brief In-memory index of every name found in the PATH directories.
+ *
+ * @param slots
+ * Open addressing hash table, kept at most half full.
+ *
+ * @param mask
+ * Number of slots minus one. The number of slots is a power of two.
+ *
+ * @param used
+ * Number of names in the table.
+ *
+ * @param pool
+ * Every name, NUL-terminated, one after the other.
+ *
+ * @param pool_len
+ * Bytes of the pool in use.
+ *
+ * @param pool_cap
+ * Bytes allocated for the pool.
+ *
+ * @param n_dirs
+ * Number of PATH directories indexed.
+ *
+ * @param state
+ * 1 once every directory is indexed, 0 otherwise.
+ *
+ * @param arena
+ * Scratch arena holding the table and the pool. Growing either leaves the
+ * old copy in it until path_index_clean().
+ */
+typedef struct s_path_index
+{
+	t_path_slot		*slots;
+	size_t			mask;
+	size_t			used;
+	char			*pool;
+	size_t			pool_len;
+	size_t			pool_cap;
+	size_t			n_dirs;
+	char			state;
+	t_arena			arena;
+}					t_path_index;
+
+/**
+ * @struct s_shard
+ * @brief One byte range of the infile in shard mode, see shard_loop().
+ *
+ * @param fd
+ * Ends of the range: [0] is the infile positioned at offset, opened by the
+ * worker, and [1] the outfile for the first range or an anonymous file
+ * collecting the output of the others.
+ *
+ * @param offset
+ * Start of the range in the infile. It always follows a newline.
+ *
+ * @param len
+ * Length of the range. Every range but the last ends with a newline.
+ *
+ * @param pid
+ * Worker running the pipeline over the range, or 0 once it is reaped.
+ *
+ * @param status
+ * Exit status of the worker, or 128 plus the signal number that killed it.
+ *
+ * @param start_ns
+ * CLOCK_MONOTONIC time, in nanoseconds, at which the worker was started.
+ *
+ * @param wall_ns
+ * Wall time of the worker, in nanoseconds.
+ *
+ * @param usage
+ * Resources used by the worker and every stage it ran.
+ */
+typedef struct s_shard
+{
+	int				fd[2];
+	off_t			offset;
+	size_t			len;
+	pid_t			pid;
+	int				status;
+	long			start_ns;
+	long			wall_ns;
+	struct rusage	usage;
+}					t_shard;
+
+/**
+ * @struct s_shards
+ * @brief State of a shard mode run, see shard_loop().
+ *
+ * @param shards
+ * Every range of the infile, in order.
+ *
+ * @param n
+ * Number of ranges.
+ *
+ * @param running
+ * Number of workers running.
+ *
+ * @param wall_ns
+ * Wall time of the whole run, output concatenation included, in
+ * nanoseconds.
+ *
+ * @param busy_ns
+ * Sum of the wall times of the workers, in nanoseconds: about what running
+ * the ranges one after the other would take.
+ */
+typedef struct s_shards
+{
+	t_shard			shards[SHARD_MAX];
+	size_t			n;
+	size_t			running;
+	long			wall_ns;
+	long			busy_ns;
+}					t_shards;
+
 /**
  * @struct s_pipex_info
  * @brief Structure to store information required for pipex execution.
@@ -25,190 +761,1832 @@
  * @param i
  * Index or counter used during pipex operations.
  *
+ * @param first
+ * Index in argv of the first command (3 with here_doc, 2 otherwise).
+ *
  * @param pipes
- * 2D array of integers representing file descriptors for pipes.
+ * Pipe ends held by the parent while the stages are launched: [0] and [1]
+ * become the standard input and output of the stage being launched, and
+ * [2] is the read end kept for the next one. Unused ends are -1, see
+ * open_stage_pipe().
  *
  * @param paths
  * Array of strings containing possible executable paths.
  *
- * @param heredoc_tmp_file
- * Temporary file name for heredoc input.
+ * @param arena
+ * Arena every allocation of the run is taken from, including this
+ * structure. It is destroyed by clean_pinfo().
+ *
+ * @param heredoc_fd
+ * Anonymous file holding the heredoc input, read from offset 0 by the first
+ * stage, or -1 without here_doc or when it is streamed. See set_heredoc().
+ *
+ * @param heredoc
+ * Reader of a streamed heredoc, pumped by relays[0], or NULL. See
+ * set_heredoc().
+ *
+ * @param opts
+ * Runtime options, see t_popts.
+ *
+ * @param cmd_cache
+ * The command cache, see cmd_cache_open().
+ *
+ * @param path_index
+ * PATH index shared by every job of a batch, built once by the batch parent,
+ * or NULL to let plan_stages() build its own. See batch_loop().
+ *
+ * @param shard
+ * Range of the infile piped by this shard worker, or NULL outside shard
+ * mode. See shard_loop().
+ *
+ * @param n_stages
+ * Number of commands in the pipeline.
+ *
+ * @param stages
+ * Bookkeeping of every stage, indexed from 0.
+ *
+ * @param relays
+ * Relays pumped by the parent, NULL if there are none. With PIPEX_SPLICE,
+ * relays[0] feeds the first command and relays[1] drains the last one. A
+ * streamed heredoc is fed by relays[0] too. With PIPEX_INSTRUMENT,
+ * relays[2 + k] pumps the k-th link between stages.
+ *
+ * @param n_relays
+ * Number of relays.
+ *
+ * @param relay_ends
+ * Pipe ends handed to the commands by the endpoint relays: [0] becomes the
+ * standard input of the first command and [1] the standard output of the
+ * last one. They are -1 when unused.
+ *
+ * @param links
+ * Capacity bookkeeping of the pipe between each stage and the next one, NULL
+ * unless PIPEX_PIPE_SIZE is set.
+ *
+ * @param n_links
+ * Number of links, n_stages - 1 once they are set.
+ *
+ * @param tuned_at
+ * Time of the last auto-tuning sample.
+ *
+ * @param sampled_at
+ * Time of the last PIPEX_INSTRUMENT sample of the relays.
+ *
+ * @param deadline_ns
+ * CLOCK_MONOTONIC time, in nanoseconds, at which PIPEX_TIMEOUT expires, or 0
+ * if unset.
+ *
+ * @param failed
+ * With PIPEX_PIPEFAIL, index of the stage blamed for the failure, see
+ * check_pipefail(). Only valid if failed_at is set.
+ *
+ * @param failed_at
+ * CLOCK_MONOTONIC time, in nanoseconds, at which that stage was found
+ * failed, or 0 if none has failed.
+ *
+ * @param teardown_ns
+ * Time from failed_at until the last stage upstream of the failed one was
+ * reaped, in nanoseconds.
+ */
+typedef struct s_pipex_info
+{
+	int				i;
+	int				first;
+	int				pipes[3];
+	char			**paths;
+	t_arena			*arena;
+	int				heredoc_fd;
+	t_heredoc		*heredoc;
+	t_popts			opts;
+	t_cmd_cache		cmd_cache;
+	t_path_index	*path_index;
+	t_shard			*shard;
+	size_t			n_stages;
+	t_stage			*stages;
+	t_relay			*relays;
+	size_t			n_relays;
+	int				relay_ends[2];
+	t_link			*links;
+	size_t			n_links;
+	struct timespec	tuned_at;
+	struct timespec	sampled_at;
+	long				deadline_ns;
+	size_t			failed;
+	long				failed_at;
+	long				teardown_ns;
+}					t_pinfo;
+
+/**
+ * @struct s_job
+ * @brief One pipeline of a batch manifest, see load_manifest().
+ *
+ * @param argv
+ * Arguments of the job laid out like those of pipex, so argv[1] is the
+ * infile and argv[argc - 1] the outfile. argv[0] is the manifest name.
+ *
+ * @param argc
+ * Number of arguments in argv.
+ *
+ * @param pid
+ * Worker running the job, or 0 before it starts and once it is reaped.
+ *
+ * @param status
+ * Exit status of the job, or 128 plus the signal number that killed it.
+ *
+ * @param start_ns
+ * CLOCK_MONOTONIC time, in nanoseconds, at which the job was started.
+ *
+ * @param wall_ns
+ * Wall time of the job, in nanoseconds.
+ *
+ * @param usage
+ * Resources used by the worker and every stage of the job.
+ */
+typedef struct s_job
+{
+	char			**argv;
+	int				argc;
+	pid_t			pid;
+	int				status;
+	long			start_ns;
+	long			wall_ns;
+	struct rusage	usage;
+}					t_job;
+
+/**
+ * @struct s_batch
+ * @brief State of a batch run, see batch_loop().
+ *
+ * @param pinfo
+ * Template every worker runs its job from, with PATH split, the options
+ * read and the resolver state set up once.
+ *
+ * @param jobs
+ * Every job of the manifest, in order.
+ *
+ * @param n_jobs
+ * Number of jobs.
+ *
+ * @param next
+ * Index of the next job to start.
+ *
+ * @param oldest
+ * Index of the oldest job that may still be running.
+ *
+ * @param running
+ * Number of workers running.
+ *
+ * @param workers
+ * Maximum number of concurrent workers, from PIPEX_JOBS or the number of
+ * online CPUs.
+ *
+ * @param wall_ns
+ * Wall time of the whole batch, in nanoseconds.
+ */
+typedef struct s_batch
+{
+	t_pinfo			*pinfo;
+	t_job			*jobs;
+	size_t			n_jobs;
+	size_t			next;
+	size_t			oldest;
+	size_t			running;
+	long			workers;
+	long			wall_ns;
+}					t_batch;
+
+/**
+ * @struct s_branch
+ * @brief One branch of a fan-out, see fanout_loop().
+ *
+ * @param job
+ * The pipeline of the branch, laid out like a batch job. Its input is
+ * "/dev/fd/N" for fd[0].
+ *
+ * @param fd
+ * Pipe feeding the branch: [0] is opened by its first stage and [1] is
+ * written by the parent.
+ *
+ * @param lag
+ * Pipe holding the data teed to the branch that fd[1] could not take yet.
+ * It has the capacity of the trunk pipe, so a whole round always fits.
+ *
+ * @param pending
+ * Bytes waiting in lag.
+ *
+ * @param bytes
+ * Bytes handed to the branch.
+ *
+ * @param stalls
+ * Number of rounds the branch could not take at once, holding the trunk
+ * back until it drained them.
+ *
+ * @param stalled_at
+ * CLOCK_MONOTONIC time, in nanoseconds, at which the current stall started,
+ * or 0.
+ *
+ * @param blocked_ns
+ * Time the branch held the trunk back, in nanoseconds.
+ */
+typedef struct s_branch
+{
+	t_job			job;
+	int				fd[2];
+	int				lag[2];
+	size_t			pending;
+	size_t			bytes;
+	size_t			stalls;
+	long			stalled_at;
+	long			blocked_ns;
+}					t_branch;
+
+/**
+ * @struct s_fanout
+ * @brief State of a fan-out run, see fanout_loop().
+ *
+ * @param pinfo
+ * Template every worker runs its pipeline from.
+ *
+ * @param trunk
+ * The pipeline producing the data, laid out like a batch job. Its outfile
+ * is "/dev/fd/N" for tee[1].
+ *
+ * @param tee
+ * Pipe the trunk writes to: [1] is opened by its last stage and [0] is
+ * duplicated into every branch by the parent.
+ *
+ * @param branches
+ * Every branch, in command line order.
+ *
+ * @param n_branches
+ * Number of branches.
+ *
+ * @param live
+ * Number of branches the parent still feeds.
+ *
+ * @param running
+ * Number of workers running.
+ *
+ * @param bytes
+ * Bytes produced by the trunk.
+ *
+ * @param wall_ns
+ * Wall time of the whole run, in nanoseconds.
+ */
+typedef struct s_fanout
+{
+	t_pinfo			*pinfo;
+	t_job			trunk;
+	int				tee[2];
+	t_branch		*branches;
+	size_t			n_branches;
+	size_t			live;
+	size_t			running;
+	size_t			bytes;
+	long			wall_ns;
+}					t_fanout;
+
+/**
+ * @struct s_dag_node
+ * @brief One stage of a DAG description, see dag_loop().
+ *
+ * @param name
+ * Name other stages refer to its output with.
+ *
+ * @param line
+ * Line of the description the stage is defined on.
+ *
+ * @param in
+ * File redirected to the standard input with "<", or NULL.
+ *
+ * @param out
+ * File redirected to the standard output with ">" or ">>", or NULL.
+ *
+ * @param append
+ * Non-zero if out was given with ">>".
+ *
+ * @param piped_in
+ * Non-zero if the standard input is the output of another stage.
+ *
+ * @param consumer
+ * Index of the stage reading the output, or -1 if the output goes to out
+ * or to the standard output of pipex.
+ *
+ * @param as_arg
+ * Non-zero if the consumer reads the output as a "/dev/fd/N" argument, zero
+ * if it reads it as its standard input.
+ *
+ * @param pipe
+ * Pipe carrying the output to the consumer, or -1.
+ */
+typedef struct s_dag_node
+{
+	char			*name;
+	int				line;
+	char			*in;
+	char			*out;
+	char			append;
+	char			piped_in;
+	long			consumer;
+	char			as_arg;
+	int				pipe[2];
+}					t_dag_node;
+
+/**
+ * @struct s_dag
+ * @brief State of a DAG run, see dag_loop().
+ *
+ * @param pinfo
+ * Pipeline information, whose stages are the nodes.
+ *
+ * @param nodes
+ * Every stage, in description order.
+ *
+ * @param cmds
+ * Command string of every stage, NULL-terminated, used as the argv of
+ * plan_stages() and report_stats() with pinfo->first set to 0.
+ *
+ * @param n
+ * Number of stages.
+ */
+typedef struct s_dag
+{
+	t_pinfo			*pinfo;
+	t_dag_node		*nodes;
+	char			**cmds;
+	size_t			n;
+}					t_dag;
+
+/**
+ * @brief Closes every descriptor held by a pinfo structure and destroys the
+ *        arena of the run, which releases the structure itself.
+ *
+ * The pipes, the relays, the links and the command cache are closed if they
+ * are still set.
+ *
+ * @param pinfo The structure to clean. It must not be used afterwards.
+ */
+void		clean_pinfo(t_pinfo *pinfo);
+
+/**
+ * @brief Reads the runtime options from the environment.
+ *
+ * Recognised variables:
+ *
+ * - PIPEX_LAUNCH: "spawn" launches stages with posix_spawn(), anything else
+ *   keeps the fork() path.
+ *
+ * - PIPEX_STATS: any value other than "0" enables the exit report.
+ *
+ * - PIPEX_SPLICE: any value other than "0" makes the parent pump the input
+ *   and the outfile with splice(2).
+ *
+ * - PIPEX_INSTRUMENT: any value other than "0" makes the parent pump every
+ *   link between stages and report its traffic.
+ *
+ * - PIPEX_PIPE_SIZE: capacity of the pipes between stages, see
+ *   pipe_size_opt().
+ *
+ * - PIPEX_TIMEOUT: wall-clock limit of the whole pipeline, see
+ *   duration_opt().
+ *
+ * - PIPEX_STAGE_TIMEOUT: wall-clock limit of each stage, see duration_opt().
+ *
+ * - PIPEX_PIPEFAIL: any value other than "0" enables the pipefail mode, see
+ *   check_pipefail().
+ *
+ * - PIPEX_PATH_INDEX: minimum number of stages for which the PATH index is
+ *   built, "0" to never build it, see path_index_build().
+ *
+ * - PIPEX_SHARDS: number of byte ranges the infile is split into and piped
+ *   in parallel, see shard_loop().
+ *
+ * @param opts The structure to fill. It must be zeroed.
+ */
+void		set_popts(t_popts *opts);
+
+/**
+ * @brief Reads the capacity requested for a link in PIPEX_PIPE_SIZE.
+ *
+ * The option is a comma separated list with one entry per link, the last
+ * entry applying to every remaining link. An entry is either a size in bytes
+ * with an optional K or M suffix, or "auto".
+ *
+ * @param spec The option value, or NULL.
+ * @param link Index of the link, from 0.
+ * @return The size in bytes, -1 for "auto" or 0 to keep the default.
+ */
+long		pipe_size_opt(const char *spec, size_t link);
+
+/**
+ * @brief Reads the wall-clock limit requested for an entry of a duration
+ *        list, as used by PIPEX_TIMEOUT and PIPEX_STAGE_TIMEOUT.
+ *
+ * The option is a comma separated list, the last entry applying to every
+ * remaining index. An entry is a number with an optional unit: "ms", "s" or
+ * "m". A bare number is taken as seconds.
+ *
+ * @param spec The option value, or NULL.
+ * @param index Index of the entry, from 0.
+ * @return The limit in milliseconds, or 0 for no limit.
+ */
+long		duration_opt(const char *spec, size_t index);
+
+/**
+ * @brief Allocates the capacity bookkeeping of the pipes between stages.
+ *
+ * Every link gets PIPE_MAX_FILE as its maximum. Its pipe does not exist yet,
+ * see open_link().
+ *
+ * @param pinfo Pipeline information with the stages already set.
+ * @return 0 on success, 1 if the links could not be allocated.
+ */
+int			set_links(t_pinfo *pinfo);
+
+/**
+ * @brief Applies PIPEX_PIPE_SIZE to the pipe of a link once it is created.
+ *
+ * Sizes are clamped to the maximum of the link. An auto link starts with the
+ * default capacity and keeps a copy of its read end so tune_links() can
+ * sample it.
+ *
+ * @param pinfo Pipeline information with the links allocated.
+ * @param index Index of the link, from 0.
+ * @param fd Read end of the pipe.
+ */
+void		open_link(t_pinfo *pinfo, size_t index, int fd);
+
+/**
+ * @brief Sets the capacity of a link, clamped to its maximum.
+ *
+ * If the kernel refuses the new size the link maximum is lowered to the
+ * current capacity, so the auto mode does not try again.
+ *
+ * @param link The link to resize.
+ * @param fd Any end of the pipe.
+ * @param size Requested capacity in bytes.
+ */
+void		resize_link(t_link *link, int fd, long size);
+
+/**
+ * @brief Samples every auto-tuned link and doubles the capacity of those
+ *        found full for PIPE_TUNE_STREAK samples in a row.
+ *
+ * A full pipe means its writer is blocked waiting for the reader. Samples
+ * are taken at most once every PIPE_TUNE_MS, so the function can be called
+ * as often as needed. Links whose reader has exited, or was never launched,
+ * are closed without reaping the reader, so the writer gets SIGPIPE even
+ * while the parent is busy pumping relays.
+ *
+ * @param pinfo Pipeline information.
+ * @return Number of links still being tuned.
+ */
+int			tune_links(t_pinfo *pinfo);
+
+/**
+ * @brief Stops tuning a link, closing the parent copy of its read end.
+ *
+ * @param link The link to close.
+ */
+void		close_link(t_link *link);
+
+/**
+ * @brief Closes every pipe end the parent still holds.
+ *
+ * If any `close` operation fails, it sets a status flag and reports a fatal
+ * error using `ft_perror`.
+ *
+ * @param pinfo Pipeline information holding the pipe ends.
+ */
+void		clean_pipes(t_pinfo *pinfo);
+
+/**
+ * @brief Creates the pipe the stage at pinfo->i writes to, just before it is
+ *        launched.
+ *
+ * Pipes are created one at a time with `pipe2(O_CLOEXEC)`, so a child only
+ * keeps the two ends it dup2()s onto its standard input and output. The
+ * capacity requested by PIPEX_PIPE_SIZE is applied to it and only then,
+ * with PIPEX_INSTRUMENT, is its read end handed to the relay of the link.
+ * The writing stage thus gets the requested or auto-tuned capacity, not the
+ * relay. See open_link() and probe_link(). The last stage gets no pipe, and
+ * neither does a builtin stage followed by another one, see
+ * launch_builtin().
+ *
+ * @param pinfo Pipeline information. pinfo->i is the argv index of the
+ *              stage about to be launched.
+ * @return 0 on success, 1 if the pipe could not be created, with an error
+ *         message printed using `perror()`.
+ */
+int			open_stage_pipe(t_pinfo *pinfo);
+
+/**
+ * @brief Drops the parent's copies of the ends handed to the stage just
+ *        launched and moves the read end of its pipe to the input slot.
+ *
+ * The parent thus never holds more than the three ends of the stage being
+ * launched, whatever the length of the pipeline, and the number of stages is
+ * not bounded by RLIMIT_NOFILE.
+ *
+ * @param pinfo Pipeline information holding the pipe ends.
+ */
+void		roll_pipes(t_pinfo *pinfo);
+
+/**
+ * @brief Executes a command based on its position in a pipeline.
+ *
+ * Runs in the forked child. Determines whether the command is the first,
+ * middle, or last in a sequence of piped commands, redirects its standard
+ * input and output to the endpoints or pipes accordingly and replaces the
+ * child with the command planned for it by plan_stages(), without allocating
+ * anything.
+ *
+ * @param pinfo Pointer to a t_pinfo structure where process information will
+ *              be stored or updated.
+ * @param argv Array of command-line arguments.
+ * @note Assumes that pipes and paths are already set up. Every other
+ *       descriptor of the parent is close-on-exec, so nothing is closed
+ *       before execution.
+ */
+void		execute_cmd(t_pinfo *pinfo, char *argv[]);
+
+/**
+ * @brief Launches the command at argv[pinfo->i] with posix_spawn().
+ *
+ * Everything the forked child does before execve() is done here in the
+ * parent instead: the endpoint file is opened and the dup2()/close() wiring
+ * is expressed as spawn file actions. The command was already planned by
+ * plan_stages().
+ * glibc implements posix_spawn() with clone(CLONE_VM | CLONE_VFORK), so the
+ * parent page tables are never copied.
+ *
+ * @param pinfo Pipeline information. pinfo->i is the argv index of the
+ *              command to launch.
+ * @param argv Array of command line arguments
+ *
+ * @return The PID of the new process, or -1 if it could not be launched. In
+ *         that case the stage status is set to 1, what the forked child
+ *         would have exited with.
+ */
+pid_t		handle_spawn(t_pinfo *pinfo, char *argv[]);
+
+/**
+ * @brief Sets a relay between two descriptors.
+ *
+ * If either descriptor is -1 the other one is closed and the relay is left
+ * finished, with both ends set to -1.
+ *
+ * @param relay The relay to initialize.
+ * @param in Descriptor data is read from.
+ * @param out Descriptor data is written to.
+ */
+void		init_relay(t_relay *relay, int in, int out);
+
+/**
+ * @brief Closes both ends of a relay and marks it as finished.
+ *
+ * Closing the write end lets the reading command see EOF, and closing the
+ * read end lets the writing command get SIGPIPE, exactly as if they were
+ * connected directly.
+ *
+ * @param relay The relay to close.
+ */
+void		close_relay(t_relay *relay);
+
+/**
+ * @brief Allocates the relays of the pipeline: the two endpoint relays and,
+ *        with PIPEX_INSTRUMENT, one per link.
+ *
+ * With PIPEX_SPLICE, the input and the outfile are opened in the parent and
+ * the pipes the endpoint relays hand to the first and last command are
+ * created. They are created with O_CLOEXEC, so the commands only keep the end
+ * duplicated onto their standard input or output. If an endpoint file cannot
+ * be opened its relay is left finished, and the command that needs it is
+ * not launched, just like a forked child would give up before execve().
+ *
+ * With PIPEX_HEREDOC_STREAM, relays[0] reads the heredoc from stdin instead
+ * of an endpoint file, whether PIPEX_SPLICE is set or not.
+ *
+ * @param pinfo Pipeline information with the stages already set.
+ * @param argv Array of command line arguments
+ * @return 0 on success, 1 on failure.
+ */
+int			set_relays(t_pinfo *pinfo, char *argv[]);
+
+/**
+ * @brief Makes the parent pump a link between stages.
+ *
+ * The writing stage keeps writing to the pipe of the link, whose read end
+ * becomes the input of relays[2 + index]. A new O_CLOEXEC pipe is created
+ * for the output of the relay and its read end replaces the old one, so the
+ * reading stage reads from it without knowing about the relay.
+ *
+ * @param pinfo Pipeline information with the relays allocated.
+ * @param index Index of the link, from 0.
+ * @param read_end Read end of the pipe of the link. It is replaced by the
+ *                 read end of the relay.
+ * @return 0 on success, 1 on failure.
+ */
+int			probe_link(t_pinfo *pinfo, size_t index, int *read_end);
+
+/**
+ * @brief Runs the periodic work of the relay pump and tells how long it may
+ *        sleep in poll(2).
+ *
+ * Auto-tuned links are sampled, see tune_links(), and with PIPEX_INSTRUMENT
+ * the fill level of every relay pipe is sampled once every RELAY_SAMPLE_MS.
+ * The time since the previous sample is added to blocked_ns if in was full
+ * then, and to wait_ns if out was empty. Stages past their deadline are
+ * signalled, see check_deadlines().
+ *
+ * @param pinfo Pipeline information.
+ * @return The poll(2) timeout in milliseconds, -1 if there is nothing to
+ *         sample and no deadline.
+ */
+int			relay_tick(t_pinfo *pinfo);
+
+/**
+ * @brief Closes the parent copy of the pipe ends handed to the commands.
+ *
+ * Must be called once every command has been launched.
+ *
+ * @param pinfo Pipeline information.
+ */
+void		close_relay_ends(t_pinfo *pinfo);
+
+/**
+ * @brief Moves one chunk of a relay through user space, for ends that do not
+ *        support splice(2).
+ *
+ * At most relay_chunk() bytes are read.
+ *
+ * @param relay The relay to pump.
+ * @return Bytes moved, 0 at EOF or -1 on error, like splice(2).
+ */
+ssize_t		relay_rw(t_relay *relay);
+
+/**
+ * @brief Returns the number of bytes the next step of a relay may move.
+ *
+ * @param relay The relay to pump.
+ * @return RELAY_CHUNK, or less if the relay is bounded and almost done.
+ */
+size_t		relay_chunk(t_relay *relay);
+
+/**
+ * @brief Accounts for the bytes moved by one step of a relay, and closes it
+ *        once a bounded relay has moved all it was allowed to.
+ *
+ * @param relay The relay that was pumped.
+ * @param moved Bytes moved by the step, more than 0.
+ */
+void		relay_moved(t_relay *relay, ssize_t moved);
+
+/**
+ * @brief Pumps every relay until all of them are finished.
+ *
+ * Pipe ends are polled and data is moved with splice(2), so it never goes
+ * through user space, falling back to read(2)/write(2) for ends that do not
+ * support it. A relay finishes at EOF, when its reader goes away (EPIPE) or
+ * on error.
+ *
+ * Auto-tuned links keep being sampled and deadlines keep being enforced
+ * while the relays are pumped.
+ *
+ * @param pinfo Pipeline information holding the relays.
+ *
+ * @note SIGPIPE must be ignored by the caller.
+ */
+void		run_relays(t_pinfo *pinfo);
+
+/**
+ * @brief Opens the file at one end of the pipeline.
+ *
+ * The input is a duplicate of the heredoc descriptor or argv[1]. The
+ * outfile is appended to with here_doc and truncated otherwise. A shard
+ * worker gets the ends of its range instead, see t_shard.
+ *
+ * @param pinfo Pipeline information with the stages already set.
+ * @param argv Array of command line arguments
+ * @param output Non-zero for the outfile, zero for the input.
+ * @return The new O_CLOEXEC file descriptor, or -1 with an error message
+ *         printed.
+ */
+int			open_endpoint(t_pinfo *pinfo, char *argv[], char output);
+
+/**
+ * @brief Returns the descriptor an end command must use for its endpoint.
+ *
+ * With PIPEX_SPLICE, or for the input of a streamed heredoc, it is the relay
+ * pipe end, otherwise the endpoint file is opened with open_endpoint() and
+ * must be closed by the caller.
+ *
+ * @param pinfo Pipeline information with the stages already set.
+ * @param argv Array of command line arguments
+ * @param output Non-zero for the last command, zero for the first one.
+ * @return The descriptor, or -1 if the endpoint file could not be opened.
+ */
+int			stage_endpoint(t_pinfo *pinfo, char *argv[], char output);
+
+/**
+ * @brief Redirects the standard input of the first command or the standard
+ *        output of the last one to its endpoint.
+ *
+ * @param pinfo Pipeline information with the stages already set.
+ * @param argv Array of command line arguments
+ * @param output Non-zero for the last command, zero for the first one.
+ * @return 0 on success, 1 on failure with an error message printed.
+ */
+int			redirect_endpoint(t_pinfo *pinfo, char *argv[], char output);
+
+/**
+ * @brief Returns the nanoseconds elapsed since start on CLOCK_MONOTONIC.
+ *
+ * @param start A time previously taken with clock_gettime(CLOCK_MONOTONIC).
+ * @return Elapsed time in nanoseconds.
+ */
+long		elapsed_ns(struct timespec *start);
+
+/**
+ * @brief Returns the current CLOCK_MONOTONIC time in nanoseconds.
+ *
+ * @return The current time in nanoseconds.
+ */
+long		now_ns(void);
+
+/**
+ * @brief Starts supervising a stage that has just been launched.
+ *
+ * Its deadline is set from
+ * PIPEX_STAGE_TIMEOUT and the pipeline deadline, whichever comes first. The
+ * pipeline deadline itself is set when the first stage is armed.
+ *
+ * @param pinfo Pipeline information.
+ * @param index Index of the stage, from 0.
+ */
+void		arm_stage(t_pinfo *pinfo, size_t index);
+
+/**
+ * @brief Signals every running stage whose deadline has passed.
+ *
+ * A stage past its deadline gets SIGTERM and a new deadline
+ * TIMEOUT_GRACE_MS later. If it is still running then, it gets SIGKILL.
+ * Stages are walked from the last one, so a builtin stage is cancelled
+ * before the end of its input could let it finish cleanly.
+ * A cancelled builtin stage is woken again every BUILTIN_WAKE_MS until its
+ * thread is done.
+ *
+ * @param pinfo Pipeline information.
+ * @return Milliseconds until the next deadline or wake-up, or -1 if there is
+ *         none.
+ */
+int			check_deadlines(t_pinfo *pinfo);
+
+/**
+ * @brief Sends the next signal of the escalation to a stage.
+ *
+ * The first call sends SIGTERM and sets the deadline of the stage
+ * TIMEOUT_GRACE_MS later, so check_deadlines() sends SIGKILL if the stage is
+ * still running then. The second call sends SIGKILL. A builtin stage is
+ * cancelled instead, see cancel_builtin().
+ *
+ * @param stage The stage to signal.
+ * @param now Current time in nanoseconds, see now_ns().
+ */
+void		signal_stage(t_stage *stage, long now);
+
+/**
+ * @brief Returns the shortest of two poll(2) timeouts.
+ *
+ * @param timeout A timeout in milliseconds, or -1 for none.
+ * @param ms Another timeout in milliseconds. It must not be -1.
+ * @return The shortest of both.
+ */
+int			sooner(int timeout, int ms);
+
+/**
+ * @brief Reaps every stage that has exited, without blocking.
+ *
+ * Stages are reaped from the last one, so a downstream stage is seen before
+ * the upstream stages it breaks, see check_pipefail().
+ *
+ * @param pinfo Pipeline information.
+ * @return Number of stages still running.
+ */
+size_t	reap_stages(t_pinfo *pinfo);
+
+/**
+ * @brief Applies PIPEX_PIPEFAIL once a stage has finished.
+ *
+ * The first stage found with a non-zero status fails the pipeline: every
+ * stage upstream of it gets SIGTERM, escalated to SIGKILL after
+ * TIMEOUT_GRACE_MS, and the parent closes the relays and link ends feeding
+ * them, so they stop at once instead of running until they hit SIGPIPE.
+ * Upstream stages reaped afterwards update teardown_ns.
+ *
+ * A stage killed by SIGPIPE was usually broken by a downstream stage that
+ * exited first, so a downstream stage found failed later takes the blame
+ * from it. Stages are reaped from the last one for the same reason.
+ *
+ * It does nothing unless PIPEX_PIPEFAIL is set.
+ *
+ * @param pinfo Pipeline information.
+ * @param index Index of the stage that has finished, from 0. Its status
+ *              must be set.
+ */
+void		check_pipefail(t_pinfo *pinfo, size_t index);
+
+/**
+ * @brief Returns the exit status of the pipeline.
+ *
+ * @param pinfo Pipeline information after every stage has been waited for.
+ * @return The status of the failed stage with PIPEX_PIPEFAIL, or the
+ *         status of the last stage otherwise.
+ */
+int			pipeline_status(t_pinfo *pinfo);
+
+/**
+ * @brief Writes the `"pipefail":{...}` member of the JSON run report, with
+ *        the failed stage, its status and teardown_ns.
+ *
+ * Nothing is written unless a stage has failed with PIPEX_PIPEFAIL.
+ *
+ * @param out Output buffer of the report.
+ * @param pinfo Pipeline information.
+ */
+void		report_pipefail(t_outbuf *out, t_pinfo *pinfo);
+
+/**
+ * @brief Tokenizes and resolves the command of every stage, once, before any
+ *        process is created.
+ *
+ * Every command that cannot be found is reported, so nothing is launched
+ * and no endpoint file is touched for a pipeline that cannot run. Forked
+ * children then only wire their descriptors and call execve().
+ *
+ * Commands are looked up in pinfo->path_index if set. Otherwise a PATH index
+ * is built for this call when the pipeline has at least PIPEX_PATH_INDEX
+ * stages.
+ *
+ * @param pinfo Pipeline information with the stages allocated.
+ * @param argv Array of command line arguments
+ * @return 0 on success, 127 if a command is empty or was not found, 2 if
+ *         it leaves a quote open, or 1 if memory could not be allocated.
+ */
+int			plan_stages(t_pinfo *pinfo, char *argv[]);
+
+/**
+ * @brief Splits a stage command into its argument vector.
+ *
+ * Arguments are separated by whitespace. Single quotes keep everything up
+ * to the closing quote literally. Double quotes keep whitespace, and a
+ * backslash inside them only escapes '"' and '\\'. Outside quotes a
+ * backslash escapes any character. Quotes may be glued to other text, as in
+ * a shell, and '' is an empty argument.
+ *
+ * The pointer array, the bytes of every argument and their quoted flags
+ * share a single block taken from the arena, which is released along with
+ * the whole run.
+ *
+ * @param arena The arena the vector is allocated from.
+ * @param cmd The command.
+ * @param quoted If not NULL, set to one flag per argument, 1 if the
+ *               argument held a quote or an escape. Such an argument is
+ *               literal text and is never taken for an operator.
+ * @return The NULL-terminated argument vector, or NULL with errno set to
+ *         EINVAL if a quote is left open, or to ENOMEM.
+ */
+char		**split_args(t_arena *arena, const char *cmd, char **quoted);
+
+/**
+ * @brief Stores the exit status and resource usage of a reaped stage.
+ *
+ * A stage killed by a signal gets 128 plus the signal number, like in a
+ * shell. The pidfd of the stage is closed, and so is the link it reads from,
+ * see close_link().
+ *
+ * @param pinfo Pipeline information.
+ * @param index Index of the stage, from 0.
+ * @param status Raw status returned by wait4().
+ * @param usage Resource usage returned by wait4().
+ */
+void		set_stage_status(t_pinfo *pinfo, size_t index, int status,
+		struct rusage *usage);
+
+/**
+ * @brief Writes a string as-is to a file descriptor.
+ *
+ * @param out Output buffer of the report.
+ * @param raw The string to write.
+ */
+void		json_put(t_outbuf *out, const char *raw);
+
+/**
+ * @brief Writes a `"key":"value"` JSON member, escaping the value.
+ *
+ * @param out Output buffer of the report.
+ * @param key Member name. It is written without escaping.
+ * @param value Member value. Quotes, backslashes and control characters are
+ *              escaped.
+ */
+void		json_key_str(t_outbuf *out, const char *key, const char *value);
+
+/**
+ * @brief Writes a `"key":value` JSON member with an integer value.
+ *
+ * @param out Output buffer of the report.
+ * @param key Member name. It is written without escaping.
+ * @param value Member value.
+ */
+void		json_key_num(t_outbuf *out, const char *key, long value);
+
+/**
+ * @brief Writes a `"rusage":{...}` JSON member with the resources used by a
+ *        stage.
+ *
+ * CPU times are given in microseconds and the maximum resident set size in
+ * kilobytes, as reported by the kernel.
+ *
+ * @param out Output buffer of the report.
+ * @param usage Resources used by the stage.
+ */
+void		json_key_rusage(t_outbuf *out, struct rusage *usage);
+
+/**
+ * @brief Writes an `"arena":{...}` JSON member with the high-water mark of
+ *        an arena.
+ *
+ * @param out Output buffer of the report.
+ * @param arena The arena, see t_arena.
+ */
+void		json_key_arena(t_outbuf *out, t_arena *arena);
+
+/**
+ * @brief Writes the JSON members describing the traffic of a relay: bytes,
+ *        reads, writes, blocked_ns, wait_ns and whether it spliced.
+ *
+ * @param out Output buffer of the report.
+ * @param relay The relay to report.
+ */
+void		json_relay_traffic(t_outbuf *out, t_relay *relay);
+
+/**
+ * @brief Writes the JSON run report to stderr.
+ *
+ * The report is formatted into a REPORT_BUF stack buffer and written with a
+ * single write(2) when it fits, so reports of concurrent runs sharing stderr
+ * do not interleave.
+ *
+ * The report contains the launch backend and, for every stage, its command,
+ * PID, exit status, launch latency, signals sent and resource usage. With
+ * relays it also contains the traffic of each of them, and with
+ * PIPEX_PIPE_SIZE or PIPEX_INSTRUMENT the final capacity of each link, along
+ * with its traffic if instrumented.
+ * With PIPEX_PIPEFAIL it also tells which stage failed first, see
+ * report_pipefail(). The high-water mark of the run arena is always given,
+ * see json_key_arena().
+ *
+ * @param pinfo Pipeline information after every stage has been waited for.
+ * @param argv Array of command line arguments
+ */
+void		report_stats(t_pinfo *pinfo, char *argv[]);
+
+/**
+ * @brief Resolves the full path of a command by searching in the given paths.
+ *
+ * A name containing a '/' is used as is if it is executable. Otherwise a '/'
+ * is prepended to it and the provided paths are searched in order for an
+ * executable file with that name.
+ *
+ * @param name The command name, the first word of the command. NULL for an
+ *             empty command.
+ * Candidates are built in a stack buffer, so only the path found is
+ * copied to the arena.
+ *
+ * @param pinfo Pipeline information holding the PATH directories, the
+ *              command cache, whose hits are validated and misses stored,
+ *              see cmd_cache_lookup(), and the arena.
+ * @param index The PATH index. Once built, it is used instead of the cache,
+ *              see path_index_find().
+ *
+ * @return The full path of the command, allocated from the arena, or NULL
+ *         if it is not found.
+ */
+char		*get_cmd_path(t_pinfo *pinfo, char *name, t_path_index *index);
+
+/**
+ * @brief Joins a directory and a command name into a path buffer.
+ *
+ * @param buf Destination buffer of PATH_MAX bytes.
+ * @param dir The directory.
+ * @param cmd The command name with a leading '/'.
+ * @return 0 on success, 1 with errno set to ENAMETOOLONG if the path does
+ *         not fit.
+ */
+int			join_path(char *buf, const char *dir, const char *cmd);
+
+/**
+ * @brief Opens and maps the command cache shared by every pipex instance.
+ *
+ * The cache is enabled by PIPEX_CMD_CACHE: a value starting with '/' is the
+ * path of the cache file, and any other value other than "0" selects
+ * CMD_CACHE_FILE, which lives in tmpfs and is suffixed with the effective
+ * uid, so each user gets their own. The file is created with mode 0600 and
+ * opened with O_NOFOLLOW, and it is only used if it is a regular file owned
+ * by the effective user that neither the group nor others can write to.
+ * Any failure leaves the cache disabled, and commands are then searched
+ * through PATH as usual.
+ *
+ * It is opened lazily by the parent the first time a command is resolved,
+ * see plan_stages().
+ *
+ * @param cache The handle to open.
+ * @return 0 if the cache is usable, 1 otherwise.
+ */
+int			cmd_cache_open(t_cmd_cache *cache);
+
+/**
+ * @brief Unmaps and closes the command cache.
+ *
+ * @param cache The handle to close.
+ */
+void		cmd_cache_close(t_cmd_cache *cache);
+
+/**
+ * @brief Finds the cache entry a command maps to, opening the cache first
+ *        if needed.
+ *
+ * @param cache The command cache.
+ * @param cmd Name of the command with a leading '/'.
+ * @param path_hash Filled with the hash of the current PATH string.
+ * @return The shared entry, or NULL if the cache is disabled, PATH is unset
+ *         or the name is too long.
  */
-typedef struct s_pipex_info
-{
-	int		i;
-	int		**pipes;
-	char	**paths;
-	char	*heredoc_tmp_file;
-}			t_pinfo;
-
-void		clean_pinfo(t_pinfo *pinfo);
+t_cmd_entry	*cmd_cache_slot(t_cmd_cache *cache, const char *cmd,
+		unsigned long *path_hash);
 
 /**
- * @brief Cleans up and closes an array of pipes.
+ * @brief Looks a command up in the command cache.
  *
- * This function iterates through an array of pipes,
-	closing both ends of each pipe
- * and freeing the associated memory. If any `close` operation fails, it sets a
- * status flag and reports a fatal error using `ft_perror`.
+ * A hit is only used if it was stored with the same PATH string, the
+ * modification time of every PATH directory up to the one holding it is
+ * unchanged, so no earlier directory has gained the command, and the
+ * command is still executable. Anything else is a miss, and the caller
+ * falls back to the normal search. Entries are read under their seqlock,
+ * without locking the file.
  *
- * @param pipes A pointer to an array of integer pointers, where each element
- *              represents a pipe (an array of two file descriptors).
- *
- * @note The function assumes that the `pipes` array is NULL-terminated.
- *       It also frees the memory allocated for the `pipes` array itself.
- *       If any error occurs while closing the pipes, the program will show
- *       an error message.
+ * @param cache The command cache.
+ * @param cmd Name of the command with a leading '/'.
+ * @param paths The PATH directories.
+ * @param cmd_path Buffer of PATH_MAX bytes filled with the absolute path of
+ *                 the command on a hit.
+ * @return 0 on a hit, 1 on a miss.
  */
-void		clean_pipes(int **pipes);
+int			cmd_cache_lookup(t_cmd_cache *cache, char *cmd, char **paths,
+		char *cmd_path);
 
 /**
- * @brief Creates a specified number of pipes and allocates memory for them.
- *
- * Allocates memory for an array of pipes and initializes each pipe using the
- * `pipe()` system call. If memory allocation or pipe creation fails, it cleans
- * up any previously allocated resources and returns an error.
+ * @brief Stores a command found by the PATH search in the command cache.
  *
- * @param pipes A pointer to an array of integer pointers where each element
- *        represents a pipe (an array of two integers for read/write ends).
- * @param n_pipes The number of pipes to create.
+ * Commands found in a relative PATH directory, and names or paths too long
+ * for an entry, are not stored. Writers take an exclusive flock(2) on the
+ * cache file and bump the seqlock of the entry around the update.
  *
- * @return 0 on success, 1 on failure. On failure, an error message is printed
- *         using `perror()` and previously allocated resources are freed.
+ * @param cache The command cache.
+ * @param paths The PATH directories.
+ * @param dir Index of the directory the command was found in.
+ * @param cmd_path Absolute path of the command, paths[dir] followed by the
+ *                 command name.
+ */
+void		cmd_cache_store(t_cmd_cache *cache, char **paths, size_t dir,
+		char *cmd_path);
+
+/**
+ * @brief Hashes a string with 64-bit FNV-1a.
  *
- * @note The caller must free the allocated memory for the pipes using the
- *       `clean_pipes()` function after use.
+ * @param str The string to hash.
+ * @param hash Initial value, CMD_CACHE_FNV or a previous hash to chain.
+ * @return The hash.
  */
-int			create_pipes(int **pipes, size_t n_pipes);
+unsigned long	fnv_hash(const char *str, unsigned long hash);
 
 /**
- * @brief Executes a command based on its position in a pipeline.
+ * @brief Builds the PATH index, reading every directory once with
+ *        getdents64(2).
  *
- * Determines whether the command is the first, middle, or last in a sequence
- * of piped commands and calls the appropriate execution function. Handles
- * cleanup of allocated resources such as paths and pipes.
+ * Each name is mapped to the first directory that has it, so resolving a
+ * command costs a hash table lookup and a single access(2) instead of one
+ * access(2) per directory. Building it reads every entry of every
+ * directory, so plan_stages() only does it for pipelines of at least
+ * PIPEX_PATH_INDEX stages.
  *
- * @param pinfo Pointer to a t_pinfo structure where process information will
- *              be stored or updated.
- * @param argv Array of command-line arguments.
- * @note Assumes that pipes and paths are already set up. Frees paths and
- *       cleans up pipes after execution.
+ * @param index The index to build.
+ * @param paths The PATH directories.
+ * @return 0 on success. 1 if a directory could not be read or memory could
+ *         not be allocated, in which case the index is left empty and the
+ *         commands are searched as usual.
  */
-void		execute_cmd(t_pinfo *pinfo, char *argv[]);
+int			path_index_build(t_path_index *index, char **paths);
 
 /**
- * @brief Resolves the full path of a command by searching in the given paths.
+ * @brief Adds a name to the PATH index, unless an earlier directory already
+ *        has it.
  *
- * This function takes a command string, which may include arguments, and an
- * array of directory paths to search for the command. It splits the command
- * into its arguments, extracts the command name, and appends a '/' to it. The
- * function then iterates through the provided paths to locate the command. If
- * the command is found, its full path is returned. If an error occurs (e.g.,
- * memory allocation failure or empty command), appropriate error handling is
- * performed.
+ * @param index The index.
+ * @param name The name.
+ * @param dir Index in PATH of the directory the name was found in.
+ * @return 0 on success, 1 if memory could not be allocated.
+ */
+int			path_index_add(t_path_index *index, const char *name, size_t dir);
+
+/**
+ * @brief Finds a name in the PATH index.
  *
- * @param command A string containing the command to resolve. It may include
- *                arguments.
- * @param paths An array of strings representing the directories to search for
- *              the command.
+ * @param index The index.
+ * @param name The name, without a leading '/'.
+ * @return The slot of the name, or NULL if no PATH directory has it.
+ */
+t_path_slot	*path_index_find(t_path_index *index, const char *name);
+
+/**
+ * @brief Destroys the arena of the PATH index and leaves it empty.
  *
- * @return A string containing the full path of the command if found, or NULL
- *         if an error occurs. The returned string must be freed by the caller.
+ * @param index The index.
  */
-char		*get_cmd_path(char command[], char **paths);
+void		path_index_clean(t_path_index *index);
 
 /**
  * @brief Executes a loop to fork processes and handle commands.
  *
  * This function performs the following steps:
  *
- * - Splits the PATH environment variable into an array of paths.
- *
  * - Checks if the first argument is "here_doc" to adjust the starting index.
  *
+ * - Resolves every command with plan_stages(), returning 127 before the
+ *   heredoc is read or anything is launched if one of them cannot be found.
+ *
  * - Iterates through commands, forking a process for each and handling it.
  *
  * - Cleans up resources such as pipes and the paths array.
  *
  * - Waits for all child processes to finish and returns their status.
  *
+ * Each launch is timed, and the report is written once every child has
+ * exited if PIPEX_STATS is set.
+ *
+ * @param pinfo Pipeline information from set_pinfo(). It is cleaned before
+ *              returning, which destroys its arena.
  * @param argc The argument count passed to the program.
  * @param argv The argument vector containing command-line arguments.
- * @param pipes A double pointer to an array of pipes used for inter-process
- *              communication.
  *
  * @return The status of the child processes after they have all completed.
  *
- * @note If an error occurs while retrieving the PATH or during resource
- *       allocation, the function cleans up and exits with a failure status.
+ * @note If an error occurs during resource allocation, the function cleans
+ *       up and exits with a failure status.
+ */
+int			fork_loop(t_pinfo *pinfo, int argc, char *argv[]);
+
+/**
+ * @brief Allocates the bookkeeping of every stage, plans them, which marks
+ *        them as not launched yet, and then prepares the heredoc if needed.
+ *
+ * Every command is resolved before the heredoc is read, so the user is not
+ * prompted for a pipeline that cannot run. Stages that are already planned
+ * are kept, so a shard worker reuses the plan of shard_loop().
+ *
+ * @param pinfo Pointer to a t_pinfo structure.
+ * @param argc The argument count passed to the program.
+ * @param argv The argument vector containing command-line arguments.
+ * @return 0 on success, or the status to exit with, see plan_stages().
+ */
+int			set_stages(t_pinfo *pinfo, int argc, char *argv[]);
+
+/**
+ * @brief Runs every job of a batch manifest, at most PIPEX_JOBS at a time,
+ *        and reports their status and timing.
+ *
+ * PATH is split and the options are read once, by set_pinfo(). The PATH
+ * index is built once as well, unless PIPEX_PATH_INDEX is "0", and the
+ * command cache is opened once. Each job then runs in a worker forked from
+ * that state, which resolves its commands without touching PATH again and
+ * runs the pipeline as fork_loop() does. PIPEX_JOBS defaults to the number
+ * of online CPUs.
+ *
+ * A job with fewer than two commands or a here_doc input, which would
+ * compete for stdin, is not run and gets status 2.
+ *
+ * Once every job has finished, a JSON report with the status, wall time and
+ * resource usage of every job is written to stderr, see report_batch().
+ *
+ * @param pinfo Pipeline information from set_pinfo(). It is cleaned before
+ *              returning.
+ * @param manifest Path of the manifest, or "-" for stdin, see
+ *                 load_manifest().
+ * @return 0 if every job succeeded, the status of the first job of the
+ *         manifest that failed otherwise, or 1 if the manifest could not be
+ *         read.
+ */
+int			batch_loop(t_pinfo *pinfo, char *manifest);
+
+/**
+ * @brief Reads a batch manifest and lays out the argv of every job.
+ *
+ * The manifest is a sequence of NUL-terminated fields. A job is a run of
+ * fields, laid out like the arguments of pipex: infile, one field per
+ * command, and outfile. An empty field, that is two NULs in a row, ends the
+ * job. Fields are used as they are, so nothing needs quoting beyond what the
+ * command strings themselves use. The manifest stays in the arena and the
+ * argv of each job points into it.
+ *
+ * @param batch The batch, with pinfo set. Its jobs are set.
+ * @param manifest Path of the manifest, or "-" for stdin.
+ * @return 0 on success, 1 with an error message printed.
+ */
+int			load_manifest(t_batch *batch, char *manifest);
+
+/**
+ * @brief Reads a whole descriptor into the arena, NUL-terminated.
+ *
+ * The buffer starts at BATCH_CHUNK bytes and doubles as needed. Outgrown
+ * copies stay in the arena.
+ *
+ * @param arena The arena of the run.
+ * @param fd The descriptor to read.
+ * @param len Set to the number of bytes read.
+ * @return The contents, or NULL on failure.
+ */
+char		*read_all(t_arena *arena, int fd, size_t *len);
+
+/**
+ * @brief Writes the JSON batch report to stderr.
+ *
+ * The report holds the number of jobs and workers, the number of failed
+ * jobs and the total wall time, then for every job its status, wall time
+ * and the resources used by its worker and stages, see json_key_rusage().
+ *
+ * @param batch The batch, once every job has finished.
+ */
+void		report_batch(t_batch *batch);
+
+/**
+ * @brief Returns the exit status of a batch.
+ *
+ * @param batch The batch, once every job has finished.
+ * @return 0 if every job succeeded, or the status of the first job of the
+ *         manifest that failed.
+ */
+int			batch_status(t_batch *batch);
+
+/**
+ * @brief Runs the pipeline over PIPEX_SHARDS byte ranges of the infile in
+ *        parallel and writes their output to the outfile in order.
+ *
+ * The infile is mapped and cut at the first newline after every multiple of
+ * its size divided by the number of shards, so no line is split. Each range
+ * is piped by a worker running fork_loop() with PIPEX_SPLICE relays, the
+ * input relay stopping at the end of the range. The first range writes to
+ * the outfile directly and every other one to an anonymous file, appended
+ * to the outfile in order once every worker has finished.
+ *
+ * This only gives the output of the single pipeline for commands that work
+ * line by line, such as grep, tr, cut or sed without addresses.
+ *
+ * Every command is planned once, by set_stages(), before the outfile is
+ * opened, so a missing command leaves it untouched. The workers inherit the
+ * plan.
+ *
+ * A here_doc, an infile that is not a non-empty regular file, or one with a
+ * single range, falls back to fork_loop(). With PIPEX_STATS, a JSON report
+ * with the wall time and speedup of the run and the wall time of every range
+ * is written to stderr, see report_shards().
+ *
+ * @param pinfo Pipeline information from set_pinfo(). It is cleaned before
+ *              returning.
+ * @param argc Number of command line arguments.
+ * @param argv Array of command line arguments.
+ * @return The exit status of the first range that failed, or 0.
+ */
+int			shard_loop(t_pinfo *pinfo, int argc, char *argv[]);
+
+/**
+ * @brief Cuts the infile into newline aligned ranges.
+ *
+ * @param run The run to fill, zeroed.
+ * @param file Path of the infile.
+ * @param k Number of ranges wanted, at most SHARD_MAX are used.
+ * @return 0 if the infile was cut into at least two ranges, 1 otherwise.
+ */
+int			split_infile(t_shards *run, char *file, long k);
+
+/**
+ * @brief Appends the output of every range but the first to the outfile, in
+ *        order, then closes the outfile and the anonymous files.
+ *
+ * @param run The run, once every worker has finished.
+ * @param out The outfile, positioned after the output of the first range.
+ */
+void		concat_shards(t_shards *run, int out);
+
+/**
+ * @brief Writes the JSON shard report to stderr.
+ *
+ * The report holds the wall time of the whole run and its speedup, the sum
+ * of the wall times of the workers over the wall time of the run, with two
+ * decimals. It is about the speedup against piping the ranges one after the
+ * other. The speedup against the single pipeline itself is measured by the
+ * shards suite of make bench. Then come the offset, length, status, wall
+ * time and resource usage of every range.
+ *
+ * @param run The run, once the output has been concatenated.
+ */
+void		report_shards(t_shards *run);
+
+/**
+ * @brief Returns the exit status of a shard mode run.
+ *
+ * @param run The run, once every worker has finished.
+ * @return The status of the first range that failed, or 0.
+ */
+int			shard_status(t_shards *run);
+
+/**
+ * @brief Counts the branches of a fan-out command line.
+ *
+ * @param argc Number of command line arguments.
+ * @param argv Array of command line arguments.
+ * @return Number of FANOUT_SEP arguments after the infile, 0 for a plain
+ *         pipeline.
+ */
+size_t		fanout_branches(int argc, char *argv[]);
+
+/**
+ * @brief Runs a trunk pipeline once and duplicates its output into several
+ *        branch pipelines, each one with its own outfile.
+ *
+ * The command line is:
+ *
+ *   pipex infile cmd1 ... cmdn -- bcmd1 ... bcmdm outfile1 -- ... outfilek
+ *
+ * Every part has at least one command. The trunk and every branch run in a
+ * worker of their own with fork_loop(), connected to the parent by pipes
+ * given to them as "/dev/fd/N" endpoints. The parent duplicates the trunk
+ * pipe into every branch with tee(2), then splice(2) for the last one, so
+ * the data never goes through user space, see pump_fanout(). The slowest
+ * branch sets the pace of the trunk: the time each branch held it back is
+ * reported with PIPEX_STATS, see report_fanout().
+ *
+ * A branch that exits early is dropped and the others keep being fed. The
+ * trunk gets SIGPIPE once every branch is gone. here_doc is not supported.
+ *
+ * @param pinfo Pipeline information from set_pinfo(). It is cleaned before
+ *              returning.
+ * @param argc Number of command line arguments.
+ * @param argv Array of command line arguments.
+ * @return The exit status of the first branch that failed, or of the trunk
+ *         first with PIPEX_PIPEFAIL, 0 if none did, or 1 if the command line
+ *         is invalid.
+ */
+int			fanout_loop(t_pinfo *pinfo, int argc, char *argv[]);
+
+/**
+ * @brief Lays out the trunk and branch jobs of a fan-out and creates the
+ *        pipes connecting them.
+ *
+ * @param fo The fan-out, zeroed but for pinfo.
+ * @param argc Number of command line arguments.
+ * @param argv Array of command line arguments.
+ * @return 0 on success, 1 with an error message printed otherwise. The
+ *         descriptors created so far are left for close_fanout().
+ */
+int			layout_fanout(t_fanout *fo, int argc, char *argv[]);
+
+/**
+ * @brief Closes the descriptors of a fan-out.
+ *
+ * @param fo The fan-out.
+ * @param keep A descriptor to leave open, or -1.
+ */
+void		close_fanout(t_fanout *fo, int keep);
+
+/**
+ * @brief Stops feeding a branch and closes its pipes, which sends it end of
+ *        file. The trunk pipe is closed along with the last branch.
+ *
+ * @param fo The fan-out.
+ * @param branch The branch to stop.
+ */
+void		end_branch(t_fanout *fo, t_branch *branch);
+
+/**
+ * @brief Duplicates the trunk output into every branch until the trunk
+ *        finishes or every branch is gone.
+ *
+ * Each round tees what the trunk pipe holds into the lag pipe of every
+ * branch, splicing it for the last one so the trunk pipe is consumed, and
+ * then splices every lag into its branch. A new round only starts once
+ * every lag is empty.
+ *
+ * @param fo The fan-out, with every worker started.
+ *
+ * @note SIGPIPE must be ignored by the caller.
+ */
+void		pump_fanout(t_fanout *fo);
+
+/**
+ * @brief Writes the JSON fan-out report to stderr.
+ *
+ * The report holds the wall time and the bytes of the run, the status, wall
+ * time and resource usage of the trunk and of every branch, and the
+ * backpressure of every branch: how many rounds it stalled and for how long
+ * it held the trunk back.
+ *
+ * @param fo The fan-out, once every worker has finished.
+ */
+void		report_fanout(t_fanout *fo);
+
+/**
+ * @brief Returns the exit status of a fan-out run.
+ *
+ * @param fo The fan-out, once every worker has finished.
+ * @return See fanout_loop().
+ */
+int			fanout_status(t_fanout *fo);
+
+/**
+ * @brief Runs the stages of a DAG description as one supervised process
+ *        tree.
+ *
+ * Every line of the description is either empty, a comment starting with
+ * "#", or a stage:
+ *
+ *   name: command [args] [< file|{name}] [> file|>> file]
+ *
+ * A "{name}" argument is replaced with the "/dev/fd/N" path of a pipe
+ * carrying the output of that stage, so tools such as paste, comm or join
+ * can read several of them. "< {name}" reads it as the standard input
+ * instead. A stage can only refer to stages defined before it, which keeps
+ * the graph acyclic, and its output can only be read once. Without ">" and
+ * without a reader, it goes to the standard output of pipex. Stages without
+ * inputs are independent roots.
+ *
+ * Only unquoted arguments are taken for references or redirections, so
+ * "'<'" or "'{print $1}'" reach the command as they are.
+ *
+ * The commands are planned like those of a pipeline, see plan_stages(),
+ * then every stage is forked and wait_childs() supervises the whole tree,
+ * with PIPEX_TIMEOUT, PIPEX_STAGE_TIMEOUT and PIPEX_PIPEFAIL applying as to
+ * a pipeline in description order. With PIPEX_STATS the usual report is
+ * written to stderr. PIPEX_LAUNCH, PIPEX_SPLICE, PIPEX_INSTRUMENT and
+ * PIPEX_PIPE_SIZE do not apply.
+ *
+ * @param pinfo Pipeline information from set_pinfo(). It is cleaned before
+ *              returning.
+ * @param file Path of the description, or "-" for stdin.
+ * @return The status of the last stage, or of the first one that failed
+ *         with PIPEX_PIPEFAIL, 2 if the description is invalid, or the
+ *         status of plan_stages() if a command cannot be planned.
+ */
+int			dag_loop(t_pinfo *pinfo, char *file);
+
+/**
+ * @brief Reads a DAG description and sets the name and command of every
+ *        stage.
+ *
+ * @param dag The DAG, zeroed but for pinfo.
+ * @param file Path of the description, or "-" for stdin.
+ * @return 0 on success, 2 if the description is invalid, or 1 if it cannot
+ *         be read, with an error message printed.
+ */
+int			load_dag(t_dag *dag, char *file);
+
+/**
+ * @brief Finds a stage of a DAG by name.
+ *
+ * @param dag The DAG.
+ * @param name The name, not necessarily NUL-terminated.
+ * @param len Length of the name.
+ * @param limit Only the stages before this index are searched.
+ * @return The index of the stage, or -1.
+ */
+long		find_node(t_dag *dag, const char *name, size_t len, size_t limit);
+
+/**
+ * @brief Applies the redirections and stage references of every planned
+ *        stage, removing them from its arguments and creating the pipes
+ *        between stages.
+ *
+ * @param dag The DAG, with its stages planned.
+ * @return 0 on success, 2 if a redirection or a reference is invalid, or 1
+ *         if a pipe cannot be created, with an error message printed. The
+ *         pipes created so far are left for close_dag().
+ */
+int			wire_dag(t_dag *dag);
+
+/**
+ * @brief Prints why a line of a DAG description is invalid.
+ *
+ * @param line Number of the line, from 1.
+ * @param reason What is wrong with it.
+ * @param token The offending token, or NULL.
+ * @return 2, the status of an invalid description.
+ */
+int			dag_error(int line, const char *reason, const char *token);
+
+/**
+ * @brief Recognizes a command pipex can run as a builtin stage.
+ *
+ * The builtins produce the same bytes as coreutils for the forms they
+ * accept, and any other form runs the real command:
+ *
+ *   cat [-]
+ *   head [-n N | -nN | -N]       tail [-n N | -nN | -N]
+ *   wc -l                        wc -c
+ *   tr SET1 SET2                 tr -d SET
+ *
+ * tr sets are made of plain characters and ascending ranges such as "a-z";
+ * sets with "[" or a backslash are left to tr(1).
+ *
+ * @param pinfo Pipeline information holding the arena.
+ * @param args Arguments of the stage, see split_args().
+ * @return The builtin, or NULL if the command is not one.
+ */
+t_builtin	*plan_builtin(t_pinfo *pinfo, char **args);
+
+/**
+ * @brief Parses the arguments of tr into a builtin.
+ *
+ * @param b The builtin.
+ * @param args Arguments after the command name.
+ * @return 0 on success, 1 if tr(1) has to run them.
+ */
+int			parse_tr(t_builtin *b, char **args);
+
+/**
+ * @brief Filter of cat: copies the span.
+ */
+int			cat_filter(t_builtin *b, char *data, size_t len);
+
+/**
+ * @brief Filter of head: copies the span up to the end of the last line
+ *        left and stops there.
+ */
+int			head_filter(t_builtin *b, char *data, size_t len);
+
+/**
+ * @brief Filter of wc -l: counts newlines.
+ */
+int			wc_lines(t_builtin *b, char *data, size_t len);
+
+/**
+ * @brief Filter of wc -c: counts bytes.
+ */
+int			wc_bytes(t_builtin *b, char *data, size_t len);
+
+/**
+ * @brief Finish of wc: writes the count and a newline.
+ */
+int			wc_finish(t_builtin *b);
+
+/**
+ * @brief Filter of tail: appends the span to the kept lines, dropping the
+ *        ones that can no longer be among the last ones first.
+ */
+int			tail_filter(t_builtin *b, char *data, size_t len);
+
+/**
+ * @brief Finish of tail: writes the last lines.
+ */
+int			tail_finish(t_builtin *b);
+
+/**
+ * @brief Reads the next span of input of a builtin stage.
+ *
+ * A span read from a ring stays in it until builtin_consume().
+ *
+ * @param b The builtin.
+ * @param data Set to the span.
+ * @return Length of the span, 0 at end of input, or -1 with b->wstatus set
+ *         if reading failed or the stage was cancelled.
+ */
+ssize_t		builtin_input(t_builtin *b, char **data);
+
+/**
+ * @brief Releases a span returned by builtin_input().
+ *
+ * @param b The builtin.
+ * @param len Length of the span.
+ */
+void		builtin_consume(t_builtin *b, size_t len);
+
+/**
+ * @brief Writes the whole buffer to the output of a builtin stage.
+ *
+ * A ring whose consumer is gone or a pipe without reader ends the stage as
+ * SIGPIPE would.
+ *
+ * @param b The builtin.
+ * @param data The bytes to write.
+ * @param len Number of bytes.
+ * @return 0 on success, 1 with b->wstatus set otherwise.
  */
-int			fork_loop(int argc, char *argv[], int **pipes);
+int			builtin_output(t_builtin *b, const char *data, size_t len);
 
 /**
- * @brief Reads input from stdin until a specified EOF string is encountered.
+ * @brief Allocates an empty ring.
  *
- * Continuously prompts the user with "heredoc >" and reads lines from stdin.
- * Lines are appended to a buffer until a line matching the EOF string is
- * encountered. The EOF comparison uses `ft_strncmp`. Returns the buffer
- * excluding the EOF line.
+ * @param arena The arena of the run.
+ * @param size Capacity, a power of two.
+ * @return The ring, or NULL with an error message printed.
+ */
+t_ring		*ring_new(t_arena *arena, size_t size);
+
+/**
+ * @brief Sleeps until the ring changes, unless it already changed since seq
+ *        was read or the stage is cancelled.
+ *
+ * @param ring The ring.
+ * @param seq Value of ring->seq read before finding the ring full or empty.
+ * @param cancel Cancel flag of the waiting stage.
+ * @return 0 once woken, or -1 with errno set to EINTR if cancelled.
+ */
+int			ring_wait(t_ring *ring, int seq, _Atomic int *cancel);
+
+/**
+ * @brief Publishes a change of the ring and wakes the other side if it
+ *        sleeps.
+ *
+ * @param ring The ring.
+ */
+void		ring_wake(t_ring *ring);
+
+/**
+ * @brief Marks one side of a ring as done.
+ *
+ * @param ring The ring.
+ * @param producer Non-zero for the producer, zero for the consumer.
+ */
+void		ring_close(t_ring *ring, char producer);
+
+/**
+ * @brief Copies as much of a buffer into the ring as fits at once, waiting
+ *        for room if it is full.
+ *
+ * @param ring The ring.
+ * @param data The bytes to write.
+ * @param len Number of bytes, non-zero.
+ * @param cancel Cancel flag of the producer.
+ * @return Number of bytes written, or -1 with errno set to EPIPE if the
+ *         consumer is gone or to EINTR if cancelled.
+ */
+ssize_t		ring_write(t_ring *ring, const char *data, size_t len,
+				_Atomic int *cancel);
+
+/**
+ * @brief Waits for data in the ring and returns the longest contiguous span
+ *        of it, in place.
+ *
+ * @param ring The ring.
+ * @param data Set to the span.
+ * @param cancel Cancel flag of the consumer.
+ * @return Length of the span, 0 once the ring is empty and the producer is
+ *         done, or -1 with errno set to EINTR if cancelled.
+ */
+ssize_t		ring_peek(t_ring *ring, char **data, _Atomic int *cancel);
+
+/**
+ * @brief Releases a span returned by ring_peek().
+ *
+ * @param ring The ring.
+ * @param len Length of the span.
+ */
+void		ring_consume(t_ring *ring, size_t len);
+
+/**
+ * @brief Wires a builtin stage in place of forking it.
+ *
+ * The stage takes its pipe ends from pinfo->pipes, opens its endpoint file
+ * or duplicates its relay end, or reads a ring it shares with the previous
+ * stage if that one is a builtin too, see open_stage_pipe(). The ring is
+ * created here, so a producer whose consumer is never launched has no
+ * output and fails instead of filling it forever. The thread is started by
+ * start_builtins().
+ *
+ * @param pinfo Pipeline information. pinfo->i is the argv index of the
+ *              stage.
+ * @param argv Array of command line arguments.
+ * @return The PID of pipex.
+ */
+pid_t		launch_builtin(t_pinfo *pinfo, char *argv[]);
+
+/**
+ * @brief Ignores SIGPIPE, so a builtin writing to a pipe without reader
+ *        gets EPIPE, and installs the handler of BUILTIN_SIG, which only
+ *        interrupts the blocking call of a cancelled builtin.
  *
- * @param eof The string marking the end of input (EOF).
- * @param eof_size The length of the EOF string.
- * @return A pointer to the buffer with input lines, or NULL on error.
+ * It is called once every stage is launched, so no command inherits it.
+ */
+void		set_builtin_signals(void);
+
+/**
+ * @brief Starts the thread of every launched builtin stage.
+ *
+ * A stage whose thread cannot start ends with status 1. The rings of a
+ * builtin stage that was not launched are closed, so its neighbours do not
+ * wait for it.
+ *
+ * @param pinfo Pipeline information with every stage launched.
+ */
+void		start_builtins(t_pinfo *pinfo);
+
+/**
+ * @brief Joins the thread of a builtin stage if it is done and records its
+ *        status, see set_stage_status().
  *
- * @note Memory:
+ * @param pinfo Pipeline information.
+ * @param index Index of the stage, from 0.
+ * @return 1 if the stage is still running, 0 otherwise.
+ */
+int			reap_builtin(t_pinfo *pinfo, size_t index);
+
+/**
+ * @brief Asks a builtin stage to end as if it got a signal.
+ *
+ * The thread is woken from a ring with ring_wake() and from a blocking read
+ * or write with BUILTIN_SIG. The signal is lost if it arrives just before
+ * the thread blocks, so check_deadlines() calls this again every
+ * BUILTIN_WAKE_MS until the thread is done.
  *
- * - Dynamically allocates memory for the buffer and strings.
+ * @param b The builtin.
+ * @param sig SIGTERM or SIGKILL, the status the stage ends with.
+ */
+void		cancel_builtin(t_builtin *b, int sig);
+
+/**
+ * @brief Closes the pipes between the stages of a DAG.
  *
- * - Frees memory on errors or successful completion.
+ * @param dag The DAG.
+ */
+void		close_dag(t_dag *dag);
+
+/**
+ * @brief Reads one block of the heredoc and forwards its complete lines.
  *
- * Errors:
+ * Lines are found with ft_memchr() and every line before the delimiter is
+ * written to out in a single write(2) per block, so the input is never
+ * copied more than once and at most HEREDOC_CHUNK bytes are held. A line is
+ * only the delimiter if it matches it exactly. The end of the input also
+ * ends the heredoc, with a last line without newline forwarded unless it is
+ * the delimiter.
  *
- * - On read or join errors, frees memory, prints an error with `perror`,
- *   and returns NULL.
+ * @param hd The reader.
+ * @param in Descriptor the heredoc is read from.
+ * @param out Descriptor the lines are forwarded to.
+ * @return Bytes forwarded, 0 once the heredoc is done and nothing was
+ *         forwarded, or -1. errno is EAGAIN if nothing could be forwarded
+ *         yet.
  */
-char		*heredoc(char *eof, size_t eof_size);
+ssize_t		heredoc_step(t_heredoc *hd, int in, int out);
 
 /**
- * @brief Removes the temporary file created for heredoc
+ * @brief Prepares the heredoc of the pipeline.
  *
- * This function deletes the specified file using unlink() system call.
- * If the file deletion fails, an error message is printed to stderr.
+ * By default it is read into a memfd_create(2) file, or into an O_TMPFILE
+ * file in HEREDOC_TMPDIR if memfd is not available, whose descriptor is
+ * kept in heredoc_fd. The file has no name, so nothing is left behind if
+ * pipex is killed. With PIPEX_HEREDOC_STREAM nothing is read here: the
+ * reader is kept in pinfo->heredoc and pumped by relays[0] once the stages
+ * are launched, see set_relays().
  *
- * @param filename The path to the temporary file to be removed
- * @return None
+ * The "heredoc >" prompt is only printed when stdin is a terminal.
+ *
+ * @param pinfo Pipeline information with the stages already set.
+ * @param eof The end-of-file delimiter string for the heredoc.
+ * @return 0 on success, 1 with an error message printed.
  */
-void		remove_heredoc_tmp_file(char *filename);
+int			set_heredoc(t_pinfo *pinfo, char *eof);
 
 /**
-* @brief Creates a temporary file containing heredoc input.
-*
-* Reads input from the user until the specified EOF delimiter is encountered,
-* writes the input to a newly generated temporary file,
-*	and returns the name
-* of the file. Handles memory allocation, file creation,
-*	and error reporting.
-*
-* @param eof The end-of-file delimiter string for the heredoc.
-* @return On success, returns the name of the temporary file (char *).
-*         On failure,
-*	returns NULL or 1 depending on the error encountered.
-*/
-char		*set_heredoc_tmp_file(char *eof);
+ * @brief Creates an anonymous file, with memfd_create(2) or an O_TMPFILE file
+ *        in HEREDOC_TMPDIR if that is not supported.
+ *
+ * @param name Name of the file, only shown in /proc.
+ * @return An O_CLOEXEC read-write descriptor, or -1.
+ */
+int			anon_file(const char *name);
 
 /**
  * @brief Creates and initializes a pinfo structure
  *
  * This function obtains the PATH environment variable, splits it by colons,
- * and stores it in a newly allocated t_pinfo structure along with the pipes.
- * The heredoc_tmp_file field is initialized to NULL.
+ * and stores it in a t_pinfo structure taken from the arena along with the
+ * pipes and the runtime options. An unset PATH is treated as empty. The
+ * heredoc_fd field is initialized to -1.
  *
- * @param pipes A pointer to an array of pipes to be stored in the structure
+ * @param arena The arena of the run.
  * @return A pointer to the initialized t_pinfo structure, or NULL if memory
- *         allocation fails. If PATH cannot be split, the function will exit
- *         with failure after cleaning the pipes.
+ *         allocation fails.
  */
-t_pinfo		*set_pinfo(int **pipes);
+t_pinfo		*set_pinfo(t_arena *arena);
 
 /**
  * @brief Sets the specified file as the standard input (stdin) for the process.
@@ -227,6 +2605,32 @@ t_pinfo		*set_pinfo(int **pipes);
  */
 int			set_infile(char file[]);
 
+/**
+ * @brief Opens the input file of the pipeline.
+ *
+ * The descriptor is opened with O_CLOEXEC so it never leaks into a command
+ * unless it is explicitly duplicated.
+ *
+ * @param file Path to the input file.
+ * @return The new file descriptor, or -1 with an error message printed to
+ *         stderr.
+ */
+int			open_infile(char file[]);
+
+/**
+ * @brief Opens the output file of the pipeline.
+ *
+ * The descriptor is opened with O_CLOEXEC so it never leaks into a command
+ * unless it is explicitly duplicated. It is created with permissions 0644 if
+ * it does not exist.
+ *
+ * @param file Path to the output file.
+ * @param append Non-zero to append to the file, zero to truncate it.
+ * @return The new file descriptor, or -1 with an error message printed to
+ *         stderr.
+ */
+int			open_outfile(char file[], char append);
+
 /**
  * @brief Sets the specified file as the standard output (STDOUT).
  *
@@ -251,18 +2655,24 @@ int			set_outfile(char file[], char append);
 /**
  * @brief Waits for all child processes to terminate and cleans up resources
  *
- * This function waits for all child processes to terminate, captures the exit
- * status of the specified last child process, and performs cleanup operations:
- * - Closes and frees all pipes
- * - Removes any temporary heredoc file
- * - Cleans up process information
+ * Every stage is watched through its pidfd in an epoll instance, so the
+ * parent sleeps until a stage exits, a deadline expires or an auto-tuned
+ * link must be sampled, see check_deadlines() and tune_links(). Each stage
+ * is reaped with wait4(), storing its exit status and struct rusage. A stage
+ * killed by a signal gets 128 plus the signal number, and PIPEX_PIPEFAIL is
+ * applied as stages finish, see check_pipefail(). If pidfds or epoll are
+ * not available, for instance because a pipeline longer than RLIMIT_NOFILE
+ * cannot have a pidfd per stage, the stages are polled every
+ * SUPERVISE_POLL_MS instead.
+ *
+ * The pipes must have been closed by the caller.
  *
- * @param last_pid PID of the specific child process whose exit status to return
  * @param pinfo Pointer to the process information structure containing pipes
- *        and resources
+ *        and resources. It is not freed, so the stages can still be reported.
  *
- * @return The exit status of the specified last child process
+ * @return The exit status of the last stage, or its preset status if it could
+ *         not be launched.
  */
-int			wait_childs(pid_t last_pid, t_pinfo *pinfo);
+int			wait_childs(t_pinfo *pinfo);
 
 #endif
@@ -0,0 +1,154 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   args_bonus.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 08:34:15 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 10:53:16 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+/**
+ * @brief Tells whether a backslash escapes the next character.
+ *
+ * Outside quotes a backslash escapes any character. Inside double quotes it
+ * only escapes '"' and '\\'. Inside single quotes it is literal.
+ *
+ * @param s The backslash.
+ * @param quote The quote currently open, or 0.
+ * @return 1 if the backslash is dropped and the next character kept.
+ */
+static int	is_escape(const char *s, char quote)
+{
+	if (*s != '\\' || !s[1] || quote == '\'')
+		return (0);
+	return (!quote || s[1] == '"' || s[1] == '\\');
+}
+
+/**
+ * @brief Opens or closes a quote.
+ *
+ * @param c The current character.
+ * @param quote The quote currently open, or 0. It is updated.
+ * @return 1 if the character is a quote that was consumed, 0 otherwise.
+ */
+static int	toggle_quote(char c, char *quote)
+{
+	if (!*quote && (c == '\'' || c == '"'))
+		*quote = c;
+	else if (*quote && c == *quote)
+		*quote = 0;
+	else
+		return (0);
+	return (1);
+}
+
+/**
+ * @brief Reads one argument of a command, applying the quoting rules.
+ *
+ * @param cmd Points to the first character of the argument. It is moved
+ *            past the argument.
+ * @param out Where the unquoted argument is written, without a terminating
+ *            NUL, or NULL to only measure it.
+ * @param quoted Set to 1 if the argument holds a quote or an escape, left
+ *               untouched otherwise.
+ * @return Length of the unquoted argument, or -1 if a quote is left open.
+ */
+static long	read_arg(const char **cmd, char *out, char *quoted)
+{
+	const char	*s;
+	char		quote;
+	long		len;
+
+	s = *cmd;
+	quote = 0;
+	len = 0;
+	while (*s && (quote || !ft_isspace(*s)))
+	{
+		if (toggle_quote(*s, &quote))
+			*quoted = 1;
+		else
+		{
+			*quoted |= is_escape(s, quote);
+			s += is_escape(s, quote);
+			if (out)
+				out[len] = *s;
+			++len;
+		}
+		++s;
+	}
+	*cmd = s;
+	if (quote)
+		return (-1);
+	return (len);
+}
+
+/**
+ * @brief Walks the arguments of a command, storing them if asked to.
+ *
+ * @param cmd The command.
+ * @param args Filled with a pointer to each argument, or NULL to only count
+ *             them.
+ * @param bytes Where the NUL-terminated arguments are written, one after
+ *              the other. Unused if args is NULL.
+ * @param quoted Filled with the quoted flag of each argument, see
+ *               read_arg(), or NULL. Unused if args is NULL.
+ * @return The number of arguments, or -1 if a quote is left open.
+ */
+static long	parse_args(const char *cmd, char **args, char *bytes,
+		char *quoted)
+{
+	long	n;
+	long	len;
+	char	flag;
+
+	n = 0;
+	while (1)
+	{
+		while (ft_isspace(*cmd))
+			++cmd;
+		if (!*cmd)
+			return (n);
+		flag = 0;
+		len = read_arg(&cmd, bytes, &flag);
+		if (len == -1)
+			return (-1);
+		if (args)
+		{
+			args[n] = bytes;
+			bytes[len] = '\0';
+			bytes += len + 1;
+		}
+		if (args && quoted)
+			quoted[n] = flag;
+		++n;
+	}
+}
+
+char	**split_args(t_arena *arena, const char *cmd, char **quoted)
+{
+	char	**args;
+	char	*flags;
+	long	n;
+
+	n = parse_args(cmd, NULL, NULL, NULL);
+	if (n == -1)
+	{
+		errno = EINVAL;
+		return (NULL);
+	}
+	args = ft_arena_alloc(arena, (n + 1) * sizeof(char *) + ft_strlen(cmd)
+			+ 1 + n);
+	if (!args)
+		return (NULL);
+	flags = (char *)(args + n + 1) + ft_strlen(cmd) + 1;
+	parse_args(cmd, args, (char *)(args + n + 1), flags);
+	args[n] = NULL;
+	if (quoted)
+		*quoted = flags;
+	return (args);
+}
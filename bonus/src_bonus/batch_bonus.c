@@ -0,0 +1,143 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   batch_bonus.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 09:25:53 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 09:25:53 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+/**
+ * @brief Reads the maximum number of concurrent workers.
+ *
+ * @return PIPEX_JOBS if it is a positive number, otherwise the number of
+ *         online CPUs, and at least 1.
+ */
+static long	batch_workers(void)
+{
+	char	*value;
+	long	workers;
+
+	workers = 0;
+	value = ft_getenv("PIPEX_JOBS");
+	if (value && *value)
+		workers = ft_atoi(value);
+	if (workers <= 0)
+		workers = sysconf(_SC_NPROCESSORS_ONLN);
+	if (workers <= 0)
+		workers = 1;
+	return (workers);
+}
+
+/**
+ * @brief Builds the PATH index and opens the command cache once, so every
+ *        worker inherits them instead of setting them up again.
+ *
+ * @param pinfo The template pinfo of the batch.
+ */
+static void	share_resolver(t_pinfo *pinfo)
+{
+	pinfo->path_index = ft_arena_calloc(pinfo->arena, 1,
+			sizeof(t_path_index));
+	if (pinfo->path_index && pinfo->opts.path_index > 0)
+		path_index_build(pinfo->path_index, pinfo->paths);
+	cmd_cache_open(&pinfo->cmd_cache);
+}
+
+/**
+ * @brief Forks a worker that runs a job with fork_loop().
+ *
+ * @param batch The batch.
+ * @param job The job to start. It is given status 2 without running if it
+ *            has fewer than two commands or reads a here_doc.
+ */
+static void	start_job(t_batch *batch, t_job *job)
+{
+	job->start_ns = now_ns();
+	job->pid = 0;
+	if (job->argc < 5 || ft_strncmp(job->argv[1], "here_doc", 9) == 0)
+	{
+		job->status = 2;
+		ft_perror("Invalid batch job", EINVAL, 0);
+		return ;
+	}
+	job->pid = fork();
+	if (job->pid == 0)
+		exit(fork_loop(batch->pinfo, job->argc, job->argv));
+	if (job->pid == -1)
+	{
+		job->pid = 0;
+		job->status = 1;
+		perror("Error forking batch job");
+		return ;
+	}
+	++batch->running;
+}
+
+/**
+ * @brief Waits for any worker and records the status, wall time and
+ *        resource usage of its job.
+ *
+ * @param batch The batch, with at least one worker running.
+ */
+static void	reap_job(t_batch *batch)
+{
+	struct rusage	usage;
+	t_job			*job;
+	pid_t			pid;
+	int				status;
+	size_t			i;
+
+	pid = wait4(-1, &status, 0, &usage);
+	if (pid == -1 && errno != EINTR)
+		batch->running = 0;
+	i = batch->oldest;
+	while (pid > 0 && i < batch->next && batch->jobs[i].pid != pid)
+		++i;
+	if (pid <= 0 || i == batch->next)
+		return ;
+	job = &batch->jobs[i];
+	job->wall_ns = now_ns() - job->start_ns;
+	job->usage = usage;
+	job->status = WEXITSTATUS(status);
+	if (WIFSIGNALED(status))
+		job->status = 128 + WTERMSIG(status);
+	job->pid = 0;
+	--batch->running;
+	while (batch->oldest < batch->next && batch->jobs[batch->oldest].pid == 0)
+		++batch->oldest;
+}
+
+int	batch_loop(t_pinfo *pinfo, char *manifest)
+{
+	t_batch	batch;
+	int		status;
+
+	ft_bzero(&batch, sizeof(t_batch));
+	batch.wall_ns = now_ns();
+	batch.pinfo = pinfo;
+	batch.workers = batch_workers();
+	if (load_manifest(&batch, manifest))
+		return (clean_pinfo(pinfo), 1);
+	share_resolver(pinfo);
+	while (batch.next < batch.n_jobs || batch.running > 0)
+	{
+		if (batch.running < (size_t)batch.workers
+			&& batch.next < batch.n_jobs)
+			start_job(&batch, &batch.jobs[batch.next++]);
+		else
+			reap_job(&batch);
+	}
+	batch.wall_ns = now_ns() - batch.wall_ns;
+	report_batch(&batch);
+	status = batch_status(&batch);
+	if (pinfo->path_index)
+		path_index_clean(pinfo->path_index);
+	clean_pinfo(pinfo);
+	return (status);
+}
@@ -0,0 +1,147 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   batch_manifest_bonus.c                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 09:25:53 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 09:53:50 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+char	*read_all(t_arena *arena, int fd, size_t *len)
+{
+	char	*buf;
+	char	*grown;
+	size_t	cap;
+	ssize_t	n;
+
+	cap = BATCH_CHUNK / 2;
+	buf = NULL;
+	*len = 0;
+	n = 0;
+	while (!buf || n > 0)
+	{
+		*len += n;
+		if (!buf || *len == cap)
+		{
+			grown = ft_arena_alloc(arena, cap * 2 + 1);
+			if (!grown)
+				return (NULL);
+			buf = ft_memcpy(grown, buf, *len);
+			cap *= 2;
+		}
+		n = read(fd, buf + *len, cap - *len);
+	}
+	if (n < 0)
+		return (NULL);
+	return (buf[*len] = '\0', buf);
+}
+
+/**
+ * @brief Finds the next job of the manifest, skipping empty fields before
+ *        it.
+ *
+ * @param data The manifest. It must be NUL-terminated past len.
+ * @param len Length of the manifest.
+ * @param at Offset to start from. Advanced past the job.
+ * @param argv Filled with the fields of the job, or NULL to only count them.
+ * @return Number of fields of the job, 0 at the end of the manifest.
+ */
+static size_t	next_job(char *data, size_t len, size_t *at, char **argv)
+{
+	size_t	n;
+
+	while (*at < len && !data[*at])
+		++*at;
+	n = 0;
+	while (*at < len && data[*at])
+	{
+		if (argv)
+			argv[n] = data + *at;
+		++n;
+		*at += ft_strlen(data + *at) + 1;
+	}
+	return (n);
+}
+
+/**
+ * @brief Counts the jobs of the manifest.
+ *
+ * @param data The manifest.
+ * @param len Length of the manifest.
+ * @return Number of jobs.
+ */
+static size_t	count_jobs(char *data, size_t len)
+{
+	size_t	at;
+	size_t	n_jobs;
+
+	at = 0;
+	n_jobs = 0;
+	while (next_job(data, len, &at, NULL) > 0)
+		++n_jobs;
+	return (n_jobs);
+}
+
+/**
+ * @brief Lays out the argv of every job, with the manifest name as argv[0].
+ *
+ * @param batch The batch, with its jobs allocated.
+ * @param data The manifest.
+ * @param len Length of the manifest.
+ * @param name Name of the manifest.
+ * @return 0 on success, 1 if memory could not be allocated.
+ */
+static int	fill_jobs(t_batch *batch, char *data, size_t len, char *name)
+{
+	t_job	*job;
+	size_t	at;
+	size_t	start;
+	size_t	i;
+
+	at = 0;
+	i = 0;
+	while (i < batch->n_jobs)
+	{
+		job = &batch->jobs[i++];
+		start = at;
+		job->argc = next_job(data, len, &at, NULL) + 1;
+		job->argv = ft_arena_calloc(batch->pinfo->arena, job->argc + 1,
+				sizeof(char *));
+		if (!job->argv)
+			return (1);
+		job->argv[0] = name;
+		next_job(data, len, &start, job->argv + 1);
+	}
+	return (0);
+}
+
+int	load_manifest(t_batch *batch, char *manifest)
+{
+	char	*data;
+	size_t	len;
+	int		fd;
+
+	fd = STDIN_FILENO;
+	if (ft_strncmp(manifest, "-", 2) != 0)
+		fd = open(manifest, O_RDONLY | O_CLOEXEC);
+	if (fd == -1)
+		return (perror("Error opening batch manifest"), 1);
+	data = read_all(batch->pinfo->arena, fd, &len);
+	if (fd != STDIN_FILENO)
+		close(fd);
+	if (!data)
+		return (perror("Error reading batch manifest"), 1);
+	batch->n_jobs = count_jobs(data, len);
+	if (batch->n_jobs == 0)
+		return (0);
+	batch->jobs = ft_arena_calloc(batch->pinfo->arena, batch->n_jobs,
+			sizeof(t_job));
+	if (!batch->jobs || fill_jobs(batch, data, len, manifest))
+		return (perror("Error allocating batch jobs"), 1);
+	return (0);
+}
@@ -0,0 +1,95 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   batch_report_bonus.c                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 09:25:53 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 09:25:53 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+/**
+ * @brief Writes the JSON object describing one job.
+ *
+ * @param out Output buffer of the report.
+ * @param job The job to report.
+ * @param index Position of the job in the manifest, from 0.
+ */
+static void	report_job(t_outbuf *out, t_job *job, long index)
+{
+	if (index > 0)
+		json_put(out, ",");
+	json_put(out, "{");
+	json_key_num(out, "job", index);
+	json_put(out, ",");
+	json_key_num(out, "stages", job->argc - 3);
+	json_put(out, ",");
+	json_key_num(out, "status", job->status);
+	json_put(out, ",");
+	json_key_num(out, "wall_ns", job->wall_ns);
+	json_put(out, ",");
+	json_key_rusage(out, &job->usage);
+	json_put(out, "}");
+}
+
+/**
+ * @brief Counts the jobs that did not succeed.
+ *
+ * @param batch The batch.
+ * @return Number of jobs with a non-zero status.
+ */
+static long	failed_jobs(t_batch *batch)
+{
+	size_t	i;
+	long	failed;
+
+	failed = 0;
+	i = 0;
+	while (i < batch->n_jobs)
+		failed += batch->jobs[i++].status != 0;
+	return (failed);
+}
+
+void	report_batch(t_batch *batch)
+{
+	char		buf[REPORT_BUF];
+	t_outbuf	out;
+	size_t		i;
+
+	ft_outbuf_init(&out, STDERR_FILENO, buf, sizeof(buf));
+	json_put(&out, "{\"batch\":{");
+	json_key_num(&out, "jobs", batch->n_jobs);
+	json_put(&out, ",");
+	json_key_num(&out, "workers", batch->workers);
+	json_put(&out, ",");
+	json_key_num(&out, "failed", failed_jobs(batch));
+	json_put(&out, ",");
+	json_key_num(&out, "wall_ns", batch->wall_ns);
+	json_put(&out, "},\"jobs\":[");
+	i = 0;
+	while (i < batch->n_jobs)
+	{
+		report_job(&out, &batch->jobs[i], i);
+		++i;
+	}
+	json_put(&out, "]}\n");
+	ft_outbuf_flush(&out);
+}
+
+int	batch_status(t_batch *batch)
+{
+	size_t	i;
+
+	i = 0;
+	while (i < batch->n_jobs)
+	{
+		if (batch->jobs[i].status != 0)
+			return (batch->jobs[i].status);
+		++i;
+	}
+	return (0);
+}
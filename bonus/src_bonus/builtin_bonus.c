@@ -0,0 +1,115 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   builtin_bonus.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 10:01:35 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 10:01:35 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+/**
+ * @brief Parses the line count of head or tail.
+ *
+ * @param b The builtin. b->count is set to the count, BUILTIN_LINES if none
+ *          is given.
+ * @param args Arguments after the command name.
+ * @return 0 on success, 1 if the real command has to run them.
+ */
+static int	parse_lines(t_builtin *b, char **args)
+{
+	char	*num;
+	size_t	next;
+
+	b->count = BUILTIN_LINES;
+	if (!args[0])
+		return (0);
+	num = NULL;
+	next = 1;
+	if (ft_strncmp(args[0], "-n", 3) == 0 && args[1])
+	{
+		num = args[1];
+		next = 2;
+	}
+	else if (args[0][0] == '-')
+		num = args[0] + 1 + (args[0][1] == 'n');
+	if (!num || !*num || args[next])
+		return (1);
+	b->count = 0;
+	while (ft_isdigit(*num) && b->count < LONG_MAX / 10)
+		b->count = b->count * 10 + *num++ - '0';
+	return (*num != '\0');
+}
+
+/**
+ * @brief Parses the arguments of wc.
+ *
+ * @param b The builtin.
+ * @param args Arguments after the command name.
+ * @return 0 on success, 1 if wc(1) has to run them.
+ */
+static int	parse_wc(t_builtin *b, char **args)
+{
+	if (!args[0] || args[1])
+		return (1);
+	b->finish = wc_finish;
+	if (ft_strncmp(args[0], "-l", 3) == 0)
+		b->filter = wc_lines;
+	else if (ft_strncmp(args[0], "-c", 3) == 0)
+		b->filter = wc_bytes;
+	return (b->filter == NULL);
+}
+
+/**
+ * @brief Picks the builtin of a command and parses its arguments.
+ *
+ * @param b The builtin.
+ * @param args Arguments of the stage.
+ * @return 0 on success, 1 if the real command has to run.
+ */
+static int	set_builtin(t_builtin *b, char **args)
+{
+	if (ft_strncmp(args[0], "cat", 4) == 0)
+	{
+		b->filter = cat_filter;
+		return (args[1] && (ft_strncmp(args[1], "-", 2) != 0 || args[2]));
+	}
+	if (ft_strncmp(args[0], "head", 5) == 0)
+	{
+		b->filter = head_filter;
+		return (parse_lines(b, args + 1));
+	}
+	if (ft_strncmp(args[0], "tail", 5) == 0)
+	{
+		b->filter = tail_filter;
+		b->finish = tail_finish;
+		return (parse_lines(b, args + 1));
+	}
+	if (ft_strncmp(args[0], "wc", 3) == 0)
+		return (parse_wc(b, args + 1));
+	if (ft_strncmp(args[0], "tr", 3) == 0)
+		return (parse_tr(b, args + 1));
+	return (1);
+}
+
+t_builtin	*plan_builtin(t_pinfo *pinfo, char **args)
+{
+	t_builtin	*b;
+
+	if (!args[0])
+		return (NULL);
+	b = ft_arena_calloc(pinfo->arena, 1, sizeof(t_builtin));
+	if (!b)
+		return (NULL);
+	b->name = args[0];
+	b->in = -1;
+	b->out = -1;
+	b->done_fd = -1;
+	if (set_builtin(b, args))
+		return (NULL);
+	return (b);
+}
@@ -0,0 +1,70 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   builtin_filter_bonus.c                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 10:01:35 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 10:01:35 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+int	cat_filter(t_builtin *b, char *data, size_t len)
+{
+	return (builtin_output(b, data, len));
+}
+
+int	head_filter(t_builtin *b, char *data, size_t len)
+{
+	char	*eol;
+	size_t	n;
+
+	n = 0;
+	while (b->count > 0 && n < len)
+	{
+		eol = ft_memchr(data + n, '\n', len - n);
+		n = len;
+		if (eol)
+		{
+			n = eol + 1 - data;
+			--b->count;
+		}
+	}
+	if (builtin_output(b, data, n))
+		return (1);
+	return (b->count == 0);
+}
+
+int	wc_lines(t_builtin *b, char *data, size_t len)
+{
+	b->count += ft_memcount(data, '\n', len);
+	return (0);
+}
+
+int	wc_bytes(t_builtin *b, char *data, size_t len)
+{
+	(void)data;
+	b->count += len;
+	return (0);
+}
+
+int	wc_finish(t_builtin *b)
+{
+	char			digits[24];
+	unsigned long	count;
+	size_t			i;
+
+	i = sizeof(digits) - 1;
+	digits[i] = '\n';
+	count = b->count;
+	digits[--i] = '0' + count % 10;
+	while (count >= 10)
+	{
+		count /= 10;
+		digits[--i] = '0' + count % 10;
+	}
+	return (builtin_output(b, digits + i, sizeof(digits) - i));
+}
@@ -0,0 +1,83 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   builtin_io_bonus.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 10:01:35 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 10:01:35 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+/**
+ * @brief Turns a failed read or write of a builtin stage into its status.
+ *
+ * A cancelled stage ends with the signal it was sent and a pipe without
+ * reader with SIGPIPE. An interrupted call is left to retry.
+ *
+ * @param b The builtin.
+ */
+static void	builtin_failed(t_builtin *b)
+{
+	if (atomic_load(&b->cancel))
+		b->wstatus = atomic_load(&b->cancel);
+	else if (errno == EPIPE)
+		b->wstatus = SIGPIPE;
+	else if (errno != EINTR)
+	{
+		perror(b->name);
+		b->wstatus = 1 << 8;
+	}
+}
+
+ssize_t	builtin_input(t_builtin *b, char **data)
+{
+	ssize_t	n;
+
+	n = -1;
+	if (atomic_load(&b->cancel))
+		b->wstatus = atomic_load(&b->cancel);
+	while (n == -1 && !b->wstatus)
+	{
+		if (b->rin)
+			n = ring_peek(b->rin, data, &b->cancel);
+		else
+		{
+			n = read(b->in, b->buf, BUILTIN_BUF);
+			*data = b->buf;
+		}
+		if (n == -1)
+			builtin_failed(b);
+	}
+	return (n);
+}
+
+void	builtin_consume(t_builtin *b, size_t len)
+{
+	if (b->rin)
+		ring_consume(b->rin, len);
+}
+
+int	builtin_output(t_builtin *b, const char *data, size_t len)
+{
+	ssize_t	n;
+
+	while (!b->wstatus && len > 0)
+	{
+		if (b->rout)
+			n = ring_write(b->rout, data, len, &b->cancel);
+		else
+			n = write(b->out, data, len);
+		if (n > 0)
+		{
+			data += n;
+			len -= n;
+		}
+		else
+			builtin_failed(b);
+	}
+	return (b->wstatus != 0);
+}
@@ -0,0 +1,98 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   builtin_launch_bonus.c                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 10:01:35 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 10:01:35 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+/**
+ * @brief Handler of BUILTIN_SIG. It does nothing: being installed without
+ *        SA_RESTART is enough to interrupt a blocking read or write.
+ *
+ * @param sig The signal.
+ */
+static void	wake_builtin(int sig)
+{
+	(void)sig;
+}
+
+void	set_builtin_signals(void)
+{
+	struct sigaction	action;
+
+	ft_bzero(&action, sizeof(action));
+	action.sa_handler = wake_builtin;
+	sigemptyset(&action.sa_mask);
+	sigaction(BUILTIN_SIG, &action, NULL);
+	signal(SIGPIPE, SIG_IGN);
+}
+
+/**
+ * @brief Takes the descriptor one side of a builtin stage uses.
+ *
+ * Pipe ends are taken from pinfo->pipes, so roll_pipes() leaves them open.
+ * Endpoint files are opened, and relay ends duplicated so pinfo keeps its
+ * own, see stage_endpoint().
+ *
+ * @param pinfo Pipeline information. pinfo->i is the argv index of the
+ *              stage.
+ * @param argv Array of command line arguments.
+ * @param output 0 for the input, 1 for the output.
+ * @return The descriptor, owned by the stage, or -1 with an error message
+ *         printed.
+ */
+static int	take_fd(t_pinfo *pinfo, char *argv[], char output)
+{
+	size_t	index;
+	int		fd;
+
+	index = pinfo->i - pinfo->first;
+	if ((!output && index == 0) || (output && index + 1 == pinfo->n_stages))
+	{
+		fd = stage_endpoint(pinfo, argv, output);
+		if (fd != -1 && fd == pinfo->relay_ends[(int)output])
+		{
+			fd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+			if (fd == -1)
+				perror("Error duplicating relay");
+		}
+		return (fd);
+	}
+	fd = pinfo->pipes[(int)output];
+	pinfo->pipes[(int)output] = -1;
+	return (fd);
+}
+
+pid_t	launch_builtin(t_pinfo *pinfo, char *argv[])
+{
+	t_builtin	*b;
+	t_builtin	*prev;
+	size_t		index;
+
+	index = pinfo->i - pinfo->first;
+	b = pinfo->stages[index].builtin;
+	prev = NULL;
+	if (index > 0)
+		prev = pinfo->stages[index - 1].builtin;
+	if (prev)
+	{
+		b->rin = ring_new(pinfo->arena, BUILTIN_RING);
+		prev->rout = b->rin;
+	}
+	else
+		b->in = take_fd(pinfo, argv, 0);
+	if (!prev && b->in != -1)
+		b->buf = ft_arena_alloc(pinfo->arena, BUILTIN_BUF);
+	if (!prev && b->in != -1 && !b->buf)
+		perror("Error allocating builtin buffer");
+	if (index + 1 == pinfo->n_stages || !pinfo->stages[index + 1].builtin)
+		b->out = take_fd(pinfo, argv, 1);
+	return (getpid());
+}
@@ -0,0 +1,128 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   builtin_run_bonus.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 10:01:35 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 10:01:35 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+/**
+ * @brief Releases everything a builtin stage holds and tells the supervisor
+ *        it is done.
+ *
+ * Closing the descriptors and rings is what lets the neighbouring stages
+ * see end of file or EPIPE.
+ *
+ * @param b The builtin, with b->wstatus set.
+ */
+static void	end_builtin(t_builtin *b)
+{
+	uint64_t	one;
+
+	if (b->in != -1)
+		close(b->in);
+	if (b->out != -1)
+		close(b->out);
+	if (b->rin)
+		ring_close(b->rin, 0);
+	if (b->rout)
+		ring_close(b->rout, 1);
+	free(b->keep);
+	b->keep = NULL;
+	one = 1;
+	if (b->done_fd != -1 && write(b->done_fd, &one, sizeof(one)) == -1)
+		perror("Error signalling builtin");
+	atomic_store(&b->done, 1);
+}
+
+/**
+ * @brief Thread of a builtin stage: feeds its input to the filter until the
+ *        end of the input or until the filter stops, then finishes.
+ *
+ * @param arg The builtin.
+ * @return NULL.
+ */
+static void	*run_builtin(void *arg)
+{
+	t_builtin	*b;
+	char		*data;
+	ssize_t		n;
+
+	b = arg;
+	if ((!b->rin && (b->in == -1 || !b->buf)) || (!b->rout && b->out == -1))
+		b->wstatus = 1 << 8;
+	n = 1;
+	while (!b->wstatus && n > 0)
+	{
+		n = builtin_input(b, &data);
+		if (n > 0 && b->filter(b, data, n))
+			n = 0;
+		else if (n > 0)
+			builtin_consume(b, n);
+	}
+	if (!b->wstatus && b->finish)
+		b->finish(b);
+	getrusage(RUSAGE_THREAD, &b->usage);
+	end_builtin(b);
+	return (NULL);
+}
+
+void	start_builtins(t_pinfo *pinfo)
+{
+	t_stage	*stage;
+	size_t	i;
+	int		err;
+
+	set_builtin_signals();
+	i = 0;
+	while (i < pinfo->n_stages)
+	{
+		stage = &pinfo->stages[i++];
+		err = 0;
+		if (stage->builtin && stage->pid != -1)
+		{
+			stage->pidfd = eventfd(0, EFD_CLOEXEC);
+			stage->builtin->done_fd = stage->pidfd;
+			err = pthread_create(&stage->builtin->thread, NULL, run_builtin,
+					stage->builtin);
+			stage->builtin->started = err == 0;
+		}
+		if (err)
+			ft_perror("Error starting builtin", err, 0);
+		if (stage->builtin && (stage->pid == -1 || err))
+			stage->builtin->wstatus = 1 << 8;
+		if (stage->builtin && (stage->pid == -1 || err))
+			end_builtin(stage->builtin);
+	}
+}
+
+int	reap_builtin(t_pinfo *pinfo, size_t index)
+{
+	t_builtin	*b;
+
+	b = pinfo->stages[index].builtin;
+	if (!atomic_load(&b->done))
+		return (1);
+	if (b->started)
+		pthread_join(b->thread, NULL);
+	b->started = 0;
+	set_stage_status(pinfo, index, b->wstatus, &b->usage);
+	return (0);
+}
+
+void	cancel_builtin(t_builtin *b, int sig)
+{
+	atomic_store(&b->cancel, sig);
+	if (b->rin)
+		ring_wake(b->rin);
+	if (b->rout)
+		ring_wake(b->rout);
+	if (b->started)
+		pthread_kill(b->thread, BUILTIN_SIG);
+}
@@ -0,0 +1,90 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   builtin_tail_bonus.c                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 10:01:36 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 10:01:36 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+/**
+ * @brief Drops the kept bytes before the last b->count lines.
+ *
+ * A trailing newline ends the last line, while a trailing partial line
+ * counts as one, as in tail(1).
+ *
+ * @param b The builtin, with b->count above 0.
+ */
+static void	tail_trim(t_builtin *b)
+{
+	size_t	i;
+	long	lines;
+
+	i = b->kept;
+	if (i > 0 && b->keep[i - 1] == '\n')
+		--i;
+	lines = 0;
+	while (i > 0 && lines < b->count)
+		lines += b->keep[--i] == '\n';
+	if (lines == b->count)
+		++i;
+	ft_memmove(b->keep, b->keep + i, b->kept - i);
+	b->kept -= i;
+}
+
+/**
+ * @brief Makes room for len more bytes in the kept lines.
+ *
+ * The lines are trimmed first. If they still fill more than half of the
+ * buffer it is doubled, so every byte is moved a bounded number of times.
+ *
+ * @param b The builtin.
+ * @param len Number of bytes about to be appended.
+ * @return 0 on success, 1 with b->wstatus set if memory runs out.
+ */
+static int	tail_room(t_builtin *b, size_t len)
+{
+	char	*grown;
+	size_t	cap;
+
+	if (b->kept + len <= b->cap)
+		return (0);
+	tail_trim(b);
+	if (b->kept + len <= b->cap / 2)
+		return (0);
+	cap = b->cap * 2;
+	if (cap < (b->kept + len) * 2)
+		cap = (b->kept + len) * 2;
+	grown = malloc(cap);
+	if (!grown)
+		return (perror(b->name), b->wstatus = 1 << 8, 1);
+	ft_memcpy(grown, b->keep, b->kept);
+	free(b->keep);
+	b->keep = grown;
+	b->cap = cap;
+	return (0);
+}
+
+int	tail_filter(t_builtin *b, char *data, size_t len)
+{
+	if (b->count == 0)
+		return (0);
+	if (tail_room(b, len))
+		return (1);
+	ft_memcpy(b->keep + b->kept, data, len);
+	b->kept += len;
+	return (0);
+}
+
+int	tail_finish(t_builtin *b)
+{
+	if (b->count == 0)
+		return (0);
+	tail_trim(b);
+	return (builtin_output(b, b->keep, b->kept));
+}
@@ -0,0 +1,146 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   builtin_tr_bonus.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 10:01:36 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 10:01:36 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+/**
+ * @brief Expands a tr set made of plain characters and ascending ranges.
+ *
+ * @param spec The set as given on the command line.
+ * @param set Filled with the expanded set, BUILTIN_SET bytes at most.
+ * @param len Set to the length of the expanded set.
+ * @return 0 on success, 1 if the set is empty, too long, descending or uses
+ *         a construct left to tr(1).
+ */
+static int	expand_set(const char *spec, unsigned char *set, size_t *len)
+{
+	const unsigned char	*s;
+	unsigned int		c;
+
+	s = (const unsigned char *)spec;
+	*len = 0;
+	while (*s && *len < BUILTIN_SET)
+	{
+		if (*s == '[' || *s == '\\' || (s[1] == '-' && s[2]
+				&& (s[2] == '[' || s[2] == '\\' || s[2] < *s)))
+			return (1);
+		c = *s;
+		if (s[1] == '-' && s[2])
+		{
+			while (c <= s[2] && *len < BUILTIN_SET)
+				set[(*len)++] = c++;
+			s += 2;
+		}
+		else
+			set[(*len)++] = c;
+		++s;
+	}
+	return (*s || *len == 0 || *len == BUILTIN_SET);
+}
+
+/**
+ * @brief Filter of tr SET1 SET2: translates the span in place.
+ */
+static int	tr_filter(t_builtin *b, char *data, size_t len)
+{
+	unsigned char	*map;
+	unsigned char	*p;
+	unsigned char	*end;
+
+	map = b->map;
+	p = (unsigned char *)data;
+	end = p + len;
+	while (p < end)
+	{
+		*p = map[*p];
+		++p;
+	}
+	return (builtin_output(b, data, len));
+}
+
+/**
+ * @brief Filter of tr -d SET: drops the bytes of the set from the span in
+ *        place.
+ */
+static int	tr_delete(t_builtin *b, char *data, size_t len)
+{
+	unsigned char	*map;
+	unsigned char	*p;
+	unsigned char	*end;
+	char			*kept;
+
+	map = b->map;
+	p = (unsigned char *)data;
+	end = p + len;
+	kept = data;
+	while (p < end)
+	{
+		if (!map[*p])
+			*kept++ = *p;
+		++p;
+	}
+	return (builtin_output(b, data, kept - data));
+}
+
+/**
+ * @brief Fills the table of a tr builtin from its expanded sets.
+ *
+ * As in tr(1), a byte listed twice in SET1 takes its last mapping, and SET2
+ * is padded with its last byte.
+ *
+ * @param b The builtin.
+ * @param set SET1 and, unless del, SET2.
+ * @param len Lengths of the sets.
+ * @param del Non-zero for tr -d.
+ */
+static void	set_map(t_builtin *b, unsigned char set[2][BUILTIN_SET],
+		size_t *len, char del)
+{
+	size_t	i;
+
+	i = 0;
+	while (i < 256)
+	{
+		b->map[i] = i * !del;
+		++i;
+	}
+	i = 0;
+	while (i < len[0] && del)
+		b->map[set[0][i++]] = 1;
+	while (i < len[0] && !del)
+	{
+		b->map[set[0][i]] = set[1][len[1] - 1];
+		if (i < len[1])
+			b->map[set[0][i]] = set[1][i];
+		++i;
+	}
+}
+
+int	parse_tr(t_builtin *b, char **args)
+{
+	unsigned char	set[2][BUILTIN_SET];
+	size_t			len[2];
+	char			del;
+
+	del = args[0] && ft_strncmp(args[0], "-d", 3) == 0;
+	args += del;
+	if (!args[0] || args[0][0] == '-' || (!del && (!args[1]
+				|| args[1][0] == '-')) || args[2 - del]
+		|| expand_set(args[0], set[0], &len[0])
+		|| (!del && expand_set(args[1], set[1], &len[1])))
+		return (1);
+	b->filter = tr_filter;
+	if (del)
+		b->filter = tr_delete;
+	set_map(b, set, len, del);
+	return (0);
+}
@@ -6,149 +6,110 @@
 /*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/04/07 12:50:33 by pablo             #+#    #+#             */
-/*   Updated: 2025/05/26 21:03:58 by pabmart2         ###   ########.fr       */
+/*   Updated: 2026/10/17 10:24:15 by pabmart2         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "pipex_bonus.h"
 
-/**
- * @brief Handles errors related to resolving the command path.
- *
- * This function is responsible for freeing allocated memory for the
- * command arguments and paths, and then printing an error message
- * before returning NULL.
- *
- * @param msg The error message to be displayed.
- * @param e The error code or character to be included in the error message.
- * @param splitted_args A null-terminated array of strings representing the
- *        split arguments of the command. This array and its contents are
- *        freed.
- * @param paths A null-terminated array of strings representing possible
- *        paths for the command. This array and its contents are freed.
- * @return Always returns NULL to indicate an error.
- */
-static void	*cmd_path_error(char *msg, char e, char **splitted_args,
-		char **paths)
+int	join_path(char *buf, const char *dir, const char *cmd)
 {
-	ft_matrix_free((void **)splitted_args, 0);
-	ft_matrix_free((void **)paths, 0);
-	ft_perror(msg, e, 0);
-	return (NULL);
+	if (ft_strlcpy(buf, dir, PATH_MAX) < PATH_MAX
+		&& ft_strlcat(buf, cmd, PATH_MAX) < PATH_MAX)
+		return (0);
+	errno = ENAMETOOLONG;
+	return (1);
 }
 
 /**
- * @brief Cleans up resources and handles errors during command resolution.
- *
- * Frees allocated memory and returns NULL in case of an error during the
- * command resolution process. Ensures all dynamically allocated resources
- * are properly released to prevent memory leaks.
+ * @brief Picks the PATH directory the search for a command starts from.
  *
- * @param cmd The command to be cleaned up. This is cast to a void pointer
- *        and freed.
- * @param splitted_args A null-terminated array of strings representing the
- *        split arguments of the command. This array and its contents are
- *        freed.
- * @param paths A null-terminated array of strings representing possible
- *        paths for the command. This array and its contents are freed.
- * @return Always returns NULL to indicate an error.
+ * @param pinfo Pipeline information holding the PATH array and the command
+ *              cache.
+ * @param cmd The command name with a leading '/'.
+ * @param index The PATH index. Once built, it tells the first directory
+ *              with the name, see path_index_find().
+ * @param cmd_path Filled with the path of the command on a cache hit, see
+ *                 cmd_cache_lookup().
+ * @return The index of the directory, or -1 on a cache hit.
  */
-static void	*cmd_error_cleanup(char *cmd, char **splitted_args)
+static long	first_dir(t_pinfo *pinfo, char *cmd, t_path_index *index,
+		char *cmd_path)
 {
-	ft_free((void **)&cmd);
-	ft_matrix_free((void **)splitted_args, 0);
-	return (NULL);
+	t_path_slot	*slot;
+
+	if (index->state != 1)
+	{
+		if (cmd_cache_lookup(&pinfo->cmd_cache, cmd, pinfo->paths,
+				cmd_path) == 0)
+			return (-1);
+		return (0);
+	}
+	slot = path_index_find(index, cmd + 1);
+	if (!slot)
+		return (index->n_dirs);
+	return (slot->dir);
 }
 
 /**
  * @brief Searches for the executable path of a given command in the provided
  * paths.
  *
- * This function iterates through an array of paths, appending the command name
- * to each path and checking if the resulting path is executable. If an
- * executable path is found, it frees the allocated memory for the command and
- * its arguments, and returns the valid executable path. If no valid path is
- * found, it performs cleanup and returns an error.
+ * The command is looked up in the PATH index if it was built, or in the
+ * command cache otherwise, see first_dir(). From the directory the index
+ * points to, or from the first one on a cache miss, this function iterates
+ * through the PATH directories, appending the command name to each one in a
+ * stack buffer and checking if the resulting path is executable, and stores
+ * the hit in the cache. Only the path found is copied to the arena.
  *
- * @param paths An array of strings representing the directories to search for
- *              the command.
- * @param cmd A string containing the command name to search for.
- * @param splitted_args An array of strings representing the arguments of the
- *                      command, which will be freed if a valid path is found.
+ * @param pinfo Pipeline information holding the PATH array, the command
+ *              cache and the arena.
+ * @param cmd The command name with a leading '/'.
+ * @param index The PATH index, used instead of the cache once built.
  *
  * @return A string containing the full path to the executable if found, or
- *         NULL if not. In case of failure, it performs cleanup and handles
- *         errors appropriately.
+ *         NULL if not.
  */
-static char	*search_path(char **paths, char *cmd, char **splitted_args)
+static char	*search_path(t_pinfo *pinfo, char *cmd, t_path_index *index)
 {
-	char	*cmd_path;
-	size_t	i;
+	char	cmd_path[PATH_MAX];
+	long	i;
 
-	i = 0;
-	while (paths[i])
+	i = first_dir(pinfo, cmd, index, cmd_path);
+	if (i == -1)
+		return (ft_arena_strdup(pinfo->arena, cmd_path));
+	errno = ENOENT;
+	while (pinfo->paths[i])
 	{
-		cmd_path = ft_strjoin(paths[i], cmd);
-		if (access(cmd_path, X_OK) == 0)
+		if (join_path(cmd_path, pinfo->paths[i], cmd) == 0
+			&& access(cmd_path, X_OK) == 0)
 		{
-			ft_matrix_free((void **)splitted_args, 0);
-			ft_free((void **)&cmd);
+			cmd_cache_store(&pinfo->cmd_cache, pinfo->paths, i, cmd_path);
 			errno = 0;
-			return (cmd_path);
+			return (ft_arena_strdup(pinfo->arena, cmd_path));
 		}
-		if (cmd_path)
-			ft_free((void **)&cmd_path);
 		++i;
 	}
-	return (cmd_error_cleanup(cmd, splitted_args));
+	return (NULL);
 }
 
-/**
- * @brief Frees all elements of the splitted_args array except the first one,
- *        and returns the first element (the command).
- *
- * This function iterates through the splitted_args array starting from index 1,
- * frees each element using ft_free, and finally frees the splitted_args array
- * itself. The first element (splitted_args[0]) is returned as the absolute
- * command path.
- *
- * @param splitted_args Array of strings, where the first element is the
- *        command, and the rest are arguments or paths to be freed.
- * @return char* Pointer to the first element of splitted_args (the command).
- */
-static char	*get_abosulte_cmd(char **splitted_args)
+char	*get_cmd_path(t_pinfo *pinfo, char *name, t_path_index *index)
 {
-	size_t	i;
-	char	*cmd;
+	char	cmd[NAME_MAX + 2];
 
-	i = 1;
-	cmd = splitted_args[0];
-	while (splitted_args[i])
+	if (!name)
+		return (ft_perror("Error Empty command", ENODATA, 0), NULL);
+	if (ft_strchr(name, '/') != NULL)
 	{
-		ft_free((void **)&splitted_args[i]);
-		++i;
+		if (access(name, X_OK) == -1)
+			return (NULL);
+		return (ft_arena_strdup(pinfo->arena, name));
 	}
-	ft_free((void **)&splitted_args);
-	return (cmd);
-}
-
-char	*get_cmd_path(char command[], char **paths)
-{
-	char	*cmd;
-	char	**splitted_args;
-
-	splitted_args = ft_split(command, ' ');
-	if (!splitted_args)
-		ft_perror("Error splitting arguments from command", ENOMEM, 0);
-	if (!splitted_args[0])
-		return (cmd_path_error("Error Empty command", ENODATA, splitted_args,
-				paths));
-	if (ft_strchr(splitted_args[0], '/') != NULL)
-		return (get_abosulte_cmd(splitted_args));
-	errno = 0;
-	cmd = ft_strjoin("/", splitted_args[0]);
-	if (!cmd)
-		return (cmd_path_error("Error adding '/' to command", 0, splitted_args,
-				paths));
-	return (search_path(paths, cmd, splitted_args));
+	cmd[0] = '/';
+	if (ft_strlcpy(cmd + 1, name, NAME_MAX + 1) > NAME_MAX)
+	{
+		errno = ENAMETOOLONG;
+		return (NULL);
+	}
+	return (search_path(pinfo, cmd, index));
 }
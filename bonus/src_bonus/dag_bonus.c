@@ -0,0 +1,135 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   dag_bonus.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 09:52:02 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 10:11:33 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+int	dag_error(int line, const char *reason, const char *token)
+{
+	if (token)
+		ft_dprintf(STDERR_FILENO, "Invalid DAG line %d: %s: %s\n", line,
+			reason, token);
+	else
+		ft_dprintf(STDERR_FILENO, "Invalid DAG line %d: %s\n", line, reason);
+	return (2);
+}
+
+/**
+ * @brief Wires the standard streams and the input pipes of a stage in the
+ *        child and replaces it with the planned command.
+ *
+ * Every pipe of the DAG is close-on-exec, so the command keeps only the ones
+ * it reads as "/dev/fd/N", whose flag is cleared, and the ones duplicated
+ * onto its standard streams.
+ *
+ * @param dag The DAG. Its pinfo is cleaned if the command cannot run.
+ * @param i Index of the stage.
+ */
+static void	exec_node(t_dag *dag, size_t i)
+{
+	extern char	**environ;
+	t_dag_node	*node;
+	t_dag_node	*src;
+	size_t		j;
+	int			error;
+
+	node = &dag->nodes[i];
+	error = (node->in && set_infile(node->in))
+		|| (node->out && set_outfile(node->out, node->append));
+	j = 0;
+	while (!error && j < i)
+	{
+		src = &dag->nodes[j++];
+		if (src->consumer == (long)i && src->as_arg)
+			error = fcntl(src->pipe[0], F_SETFD, 0) == -1;
+		else if (src->consumer == (long)i)
+			error = dup2(src->pipe[0], STDIN_FILENO) == -1;
+	}
+	if (!error && node->consumer != -1)
+		error = dup2(node->pipe[1], STDOUT_FILENO) == -1;
+	if (!error)
+		execve(dag->pinfo->stages[i].path, dag->pinfo->stages[i].args,
+			environ);
+	perror("Error executing command");
+	clean_pinfo(dag->pinfo);
+}
+
+/**
+ * @brief Forks a stage of the DAG and arms its deadlines.
+ *
+ * @param dag The DAG.
+ * @param i Index of the stage. It keeps the status EXIT_FAILURE if it cannot
+ *          be forked.
+ */
+static void	launch_node(t_dag *dag, size_t i)
+{
+	t_stage			*stage;
+	struct timespec	start;
+
+	stage = &dag->pinfo->stages[i];
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	stage->pid = fork();
+	if (stage->pid == 0)
+	{
+		exec_node(dag, i);
+		exit(EXIT_FAILURE);
+	}
+	if (stage->pid == -1)
+		perror("Error forking");
+	stage->launch_ns = elapsed_ns(&start);
+	arm_stage(dag->pinfo, i);
+}
+
+void	close_dag(t_dag *dag)
+{
+	size_t	i;
+
+	i = 0;
+	while (i < dag->n)
+	{
+		if (dag->nodes[i].pipe[0] != -1)
+			close(dag->nodes[i].pipe[0]);
+		if (dag->nodes[i].pipe[1] != -1)
+			close(dag->nodes[i].pipe[1]);
+		dag->nodes[i].pipe[0] = -1;
+		dag->nodes[i].pipe[1] = -1;
+		++i;
+	}
+}
+
+int	dag_loop(t_pinfo *pinfo, char *file)
+{
+	t_dag	dag;
+	size_t	i;
+	int		status;
+
+	ft_bzero(&dag, sizeof(t_dag));
+	dag.pinfo = pinfo;
+	pinfo->opts.launch = LAUNCH_FORK;
+	pinfo->opts.splice = 0;
+	pinfo->opts.instrument = 0;
+	pinfo->opts.builtins = 0;
+	status = load_dag(&dag, file);
+	pinfo->n_stages = dag.n;
+	if (!status)
+		status = plan_stages(pinfo, dag.cmds);
+	if (!status)
+		status = wire_dag(&dag);
+	i = 0;
+	while (!status && i < dag.n)
+		launch_node(&dag, i++);
+	close_dag(&dag);
+	if (i > 0)
+		status = wait_childs(pinfo);
+	if (i > 0 && pinfo->opts.stats)
+		report_stats(pinfo, dag.cmds);
+	return (clean_pinfo(pinfo), status);
+}
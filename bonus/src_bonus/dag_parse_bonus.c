@@ -0,0 +1,152 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   dag_parse_bonus.c                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 09:52:02 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 09:52:02 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+long	find_node(t_dag *dag, const char *name, size_t len, size_t limit)
+{
+	size_t	i;
+
+	i = 0;
+	while (i < limit)
+	{
+		if (ft_strncmp(dag->nodes[i].name, name, len) == 0
+			&& dag->nodes[i].name[len] == '\0')
+			return (i);
+		++i;
+	}
+	return (-1);
+}
+
+/**
+ * @brief Parses the line of a stage into the next node of the DAG.
+ *
+ * The name is NUL-terminated in place and the command is kept as the rest
+ * of the line, to be planned later.
+ *
+ * @param dag The DAG, with room for one more node.
+ * @param line The line, without leading spaces, comment or newline.
+ * @param number Number of the line, from 1.
+ * @return 0 on success, 2 if the line is invalid.
+ */
+static int	parse_line(t_dag *dag, char *line, int number)
+{
+	t_dag_node	*node;
+	char		*sep;
+	size_t		len;
+
+	sep = ft_strchr(line, DAG_SEP);
+	if (!sep)
+		return (dag_error(number, "expected \"name: command\"", NULL));
+	len = 0;
+	while (ft_isalnum(line[len]) || line[len] == '_' || line[len] == '-')
+		++len;
+	if (len == 0 || line + len != sep)
+		return (dag_error(number, "invalid stage name", NULL));
+	if (find_node(dag, line, len, dag->n) != -1)
+		return (dag_error(number, "duplicate stage name", NULL));
+	line[len] = '\0';
+	++sep;
+	while (ft_isspace(*sep))
+		++sep;
+	node = &dag->nodes[dag->n];
+	node->name = line;
+	node->line = number;
+	node->consumer = -1;
+	ft_memset(node->pipe, -1, sizeof(node->pipe));
+	dag->cmds[dag->n++] = sep;
+	return (0);
+}
+
+/**
+ * @brief Allocates room for one node, and the stage it is planned into, per
+ *        line of the description.
+ *
+ * @param dag The DAG.
+ * @param data The description.
+ * @param len Length of the description.
+ * @return 0 on success, 1 if memory could not be allocated.
+ */
+static int	alloc_dag(t_dag *dag, char *data, size_t len)
+{
+	char	*eol;
+	size_t	lines;
+
+	lines = 1;
+	eol = ft_memchr(data, '\n', len);
+	while (eol)
+	{
+		++lines;
+		eol = ft_memchr(eol + 1, '\n', len - (eol + 1 - data));
+	}
+	dag->nodes = ft_arena_calloc(dag->pinfo->arena, lines, sizeof(t_dag_node));
+	dag->cmds = ft_arena_calloc(dag->pinfo->arena, lines + 1, sizeof(char *));
+	dag->pinfo->stages = ft_arena_calloc(dag->pinfo->arena, lines,
+			sizeof(t_stage));
+	return (!dag->nodes || !dag->cmds || !dag->pinfo->stages);
+}
+
+/**
+ * @brief Splits the description into lines and parses every stage,
+ *        skipping empty lines and comments.
+ *
+ * @param dag The DAG, with its nodes allocated.
+ * @param data The description, NUL-terminated.
+ * @return 0 on success, 2 if a line is invalid or there is no stage.
+ */
+static int	parse_dag(t_dag *dag, char *data)
+{
+	char	*eol;
+	int		number;
+	int		status;
+
+	number = 0;
+	status = 0;
+	while (data && !status)
+	{
+		eol = ft_strchr(data, '\n');
+		if (eol)
+			*eol = '\0';
+		++number;
+		while (ft_isspace(*data))
+			++data;
+		if (*data && *data != '#')
+			status = parse_line(dag, data, number);
+		data = eol;
+		if (data)
+			++data;
+	}
+	if (!status && dag->n == 0)
+		return (ft_perror("Empty DAG description", EINVAL, 0), 2);
+	return (status);
+}
+
+int	load_dag(t_dag *dag, char *file)
+{
+	char	*data;
+	size_t	len;
+	int		fd;
+
+	fd = STDIN_FILENO;
+	if (ft_strncmp(file, "-", 2) != 0)
+		fd = open(file, O_RDONLY | O_CLOEXEC);
+	if (fd == -1)
+		return (perror("Error opening DAG description"), 1);
+	data = read_all(dag->pinfo->arena, fd, &len);
+	if (fd != STDIN_FILENO)
+		close(fd);
+	if (!data)
+		return (perror("Error reading DAG description"), 1);
+	if (alloc_dag(dag, data, len))
+		return (perror("Error allocating DAG stages"), 1);
+	return (parse_dag(dag, data));
+}
@@ -0,0 +1,161 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   dag_wire_bonus.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 09:52:02 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 10:53:16 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+/**
+ * @brief Tells whether an argument of a stage is a redirection operator, a
+ *        reference to the output of another stage or a plain argument.
+ *
+ * @param arg The argument.
+ * @param quoted Non-zero if the argument was quoted or escaped. It is then
+ *               plain text, as "'<'" or "'{print $1}'" are to a shell.
+ * @return 1 for "<", ">" or ">>", 2 for a "{name}" token, 0 otherwise.
+ */
+static int	arg_kind(const char *arg, char quoted)
+{
+	size_t	len;
+
+	if (quoted)
+		return (0);
+	if (ft_strncmp(arg, "<", 2) == 0 || ft_strncmp(arg, ">", 2) == 0
+		|| ft_strncmp(arg, ">>", 3) == 0)
+		return (1);
+	len = ft_strlen(arg);
+	return (2 * (len > 2 && arg[0] == '{' && arg[len - 1] == '}'));
+}
+
+/**
+ * @brief Connects the output of the stage an argument refers to with the
+ *        stage it is an argument of.
+ *
+ * @param dag The DAG.
+ * @param i Index of the reading stage. Only earlier stages can be referred
+ *          to.
+ * @param arg The "{name}" argument. If the output is read as an argument, it
+ *            is replaced with the "/dev/fd/N" path of the pipe.
+ * @param as_arg Non-zero to read the output as an argument, zero to read it
+ *               as the standard input.
+ * @return 0 on success, 2 if the reference is invalid, or 1 if the pipe
+ *         cannot be created.
+ */
+static int	ref_node(t_dag *dag, size_t i, char **arg, char as_arg)
+{
+	t_dag_node	*src;
+	long		j;
+
+	j = find_node(dag, *arg + 1, ft_strlen(*arg) - 2, i);
+	if (j == -1)
+		return (dag_error(dag->nodes[i].line, "unknown or later stage", *arg));
+	src = &dag->nodes[j];
+	if (src->consumer != -1 || src->out)
+		return (dag_error(dag->nodes[i].line, "output already used", *arg));
+	if (pipe2(src->pipe, O_CLOEXEC) == -1)
+		return (perror("Error creating DAG pipe"), 1);
+	src->consumer = i;
+	src->as_arg = as_arg;
+	if (!as_arg)
+		return (0);
+	*arg = ft_arena_alloc(dag->pinfo->arena, DAG_PATH);
+	if (!*arg)
+		return (perror("Error allocating DAG path"), 1);
+	ft_snprintf(*arg, DAG_PATH, "/dev/fd/%d", src->pipe[0]);
+	return (0);
+}
+
+/**
+ * @brief Applies one redirection of a stage.
+ *
+ * @param dag The DAG.
+ * @param i Index of the stage.
+ * @param r Index of the "<", ">" or ">>" argument. The target is the
+ *          argument after it.
+ * @return 0 on success, 2 if the redirection is invalid, or 1 if a pipe
+ *         cannot be created.
+ */
+static int	take_redirect(t_dag *dag, size_t i, size_t r)
+{
+	t_dag_node	*node;
+	t_stage		*stage;
+	char		*target;
+
+	node = &dag->nodes[i];
+	stage = &dag->pinfo->stages[i];
+	target = stage->args[r + 1];
+	if (!target)
+		return (dag_error(node->line, "missing target after", stage->args[r]));
+	if (stage->args[r][0] == '<')
+	{
+		if (node->in || node->piped_in)
+			return (dag_error(node->line, "input redirected twice", "<"));
+		if (arg_kind(target, stage->quoted[r + 1]) != 2)
+			return (node->in = target, 0);
+		node->piped_in = 1;
+		return (ref_node(dag, i, &target, 0));
+	}
+	if (node->out)
+		return (dag_error(node->line, "output redirected twice",
+				stage->args[r]));
+	node->out = target;
+	node->append = stage->args[r][1] == '>';
+	return (0);
+}
+
+/**
+ * @brief Applies the redirections and references of a stage, removing the
+ *        redirections from its arguments.
+ *
+ * Only unquoted arguments are taken for operators or references.
+ *
+ * @param dag The DAG.
+ * @param i Index of the stage.
+ * @return 0 on success, or the status of the first failure.
+ */
+static int	wire_node(t_dag *dag, size_t i)
+{
+	t_stage	*stage;
+	size_t	r;
+	size_t	w;
+	int		status;
+	int		kind;
+
+	stage = &dag->pinfo->stages[i];
+	r = 1;
+	w = 1;
+	status = 0;
+	while (!status && stage->args[r])
+	{
+		kind = arg_kind(stage->args[r], stage->quoted[r]);
+		if (kind == 1)
+			status = take_redirect(dag, i, r);
+		else if (kind == 2)
+			status = ref_node(dag, i, &stage->args[r], 1);
+		stage->quoted[w] = stage->quoted[r];
+		if (kind != 1)
+			stage->args[w++] = stage->args[r];
+		r += 1 + (kind == 1);
+	}
+	stage->args[w] = NULL;
+	return (status);
+}
+
+int	wire_dag(t_dag *dag)
+{
+	size_t	i;
+	int		status;
+
+	status = 0;
+	i = 0;
+	while (!status && i < dag->n)
+		status = wire_node(dag, i++);
+	return (status);
+}
@@ -0,0 +1,115 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   deadline_bonus.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 08:14:49 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 10:59:47 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+void	signal_stage(t_stage *stage, long now)
+{
+	int	sig;
+
+	sig = SIGKILL;
+	stage->deadline_ns = 0;
+	if (stage->signals == 0)
+	{
+		sig = SIGTERM;
+		stage->deadline_ns = now + TIMEOUT_GRACE_MS * 1000000L;
+	}
+	if (stage->builtin)
+		cancel_builtin(stage->builtin, sig);
+	else
+		kill(stage->pid, sig);
+	++stage->signals;
+}
+
+void	arm_stage(t_pinfo *pinfo, size_t index)
+{
+	t_stage	*stage;
+	long	now;
+	long	timeout;
+
+	stage = &pinfo->stages[index];
+	now = now_ns();
+	if (index == 0 && pinfo->opts.timeout_ms > 0)
+		pinfo->deadline_ns = now + pinfo->opts.timeout_ms * 1000000L;
+	stage->pidfd = -1;
+	if (stage->pid == -1)
+	{
+		check_pipefail(pinfo, index);
+		return ;
+	}
+	timeout = duration_opt(pinfo->opts.stage_timeout, index);
+	if (timeout > 0)
+		stage->deadline_ns = now + timeout * 1000000L;
+	if (pinfo->deadline_ns && (!stage->deadline_ns
+			|| pinfo->deadline_ns < stage->deadline_ns))
+		stage->deadline_ns = pinfo->deadline_ns;
+}
+
+/**
+ * @brief Signals a stage if its deadline has passed and tells when it needs
+ *        attention next.
+ *
+ * A cancelled builtin stage is woken again until its thread is done:
+ * BUILTIN_SIG is lost if it arrives after the thread has checked the cancel
+ * flag but before it blocks in read(2) or write(2).
+ *
+ * @param stage The stage.
+ * @param now Current time in nanoseconds, see now_ns().
+ * @return Nanoseconds until the stage needs attention, or -1 if it does not.
+ */
+static long	stage_next(t_stage *stage, long now)
+{
+	t_builtin	*b;
+
+	b = stage->builtin;
+	if (b && stage->signals && !atomic_load(&b->done))
+		cancel_builtin(b, atomic_load(&b->cancel));
+	if (stage->deadline_ns && stage->deadline_ns <= now)
+		signal_stage(stage, now);
+	if (b && stage->signals && !atomic_load(&b->done)
+		&& (!stage->deadline_ns
+			|| stage->deadline_ns - now > BUILTIN_WAKE_MS * 1000000L))
+		return (BUILTIN_WAKE_MS * 1000000L);
+	if (stage->deadline_ns)
+		return (stage->deadline_ns - now);
+	return (-1);
+}
+
+int	check_deadlines(t_pinfo *pinfo)
+{
+	long	now;
+	long	next;
+	long	wait;
+	size_t	i;
+
+	now = now_ns();
+	next = -1;
+	i = pinfo->n_stages;
+	while (i > 0)
+	{
+		wait = stage_next(&pinfo->stages[--i], now);
+		if (wait != -1 && (next == -1 || wait < next))
+			next = wait;
+	}
+	if (next == -1)
+		return (-1);
+	if (next / 1000000 >= INT_MAX)
+		return (INT_MAX);
+	return (next / 1000000 + 1);
+}
+
+int	sooner(int timeout, int ms)
+{
+	if (timeout == -1 || ms < timeout)
+		return (ms);
+	return (timeout);
+}
@@ -0,0 +1,154 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   fanout_args_bonus.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 09:42:34 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 09:42:34 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+/**
+ * @brief Replaces the separator of a part with the "/dev/fd/N" path of the
+ *        pipe end connecting it to the parent.
+ *
+ * @param fo The fan-out, with its pipes created.
+ * @param job The part, laid out.
+ * @param part 0 for the trunk, whose last argument is replaced, or 1 plus
+ *             the index of a branch, whose first argument is replaced.
+ * @return 0 on success, 1 with an error message printed otherwise.
+ */
+static int	set_fd_path(t_fanout *fo, t_job *job, size_t part)
+{
+	char	**slot;
+	int		fd;
+
+	slot = &job->argv[1];
+	fd = fo->tee[1];
+	if (part == 0)
+		slot = &job->argv[job->argc - 1];
+	else
+		fd = fo->branches[part - 1].fd[0];
+	*slot = ft_arena_alloc(fo->pinfo->arena, FANOUT_PATH);
+	if (!*slot)
+		return (perror("Error allocating fan-out"), 1);
+	ft_snprintf(*slot, FANOUT_PATH, "/dev/fd/%d", fd);
+	return (0);
+}
+
+/**
+ * @brief Lays out the argv of one part of a fan-out.
+ *
+ * @param fo The fan-out.
+ * @param job The job to fill.
+ * @param args The part on the command line: the infile, the commands and
+ *             the separator for the trunk, or the separator, the commands
+ *             and the outfile for a branch. The separator is then replaced,
+ *             see set_fd_path().
+ * @param n Number of arguments in args.
+ * @return 0 on success, 1 with an error message printed otherwise.
+ */
+static int	layout_job(t_fanout *fo, t_job *job, char **args, int n)
+{
+	if (n < 3)
+		return (ft_perror("Fan-out part without commands", EINVAL, 0), 1);
+	job->argv = ft_arena_alloc(fo->pinfo->arena, sizeof(char *) * (n + 2));
+	if (!job->argv)
+		return (perror("Error allocating fan-out"), 1);
+	job->argv[0] = "pipex";
+	ft_memcpy(job->argv + 1, args, sizeof(char *) * n);
+	job->argv[n + 1] = NULL;
+	job->argc = n + 1;
+	return (0);
+}
+
+/**
+ * @brief Allocates the branches and creates the trunk pipe and the pipes of
+ *        every branch, which makes the branches live.
+ *
+ * @param fo The fan-out.
+ * @param n Number of branches. fo->n_branches only counts those whose
+ *          descriptors are set, so close_fanout() can run at any point.
+ * @return 0 on success, 1 with an error message printed otherwise.
+ */
+static int	open_fanout(t_fanout *fo, size_t n)
+{
+	t_branch	*branch;
+	int			size;
+
+	ft_memset(fo->tee, -1, sizeof(fo->tee));
+	fo->branches = ft_arena_calloc(fo->pinfo->arena, n, sizeof(t_branch));
+	if (!fo->branches)
+		return (perror("Error allocating fan-out"), 1);
+	if (pipe2(fo->tee, O_CLOEXEC) == -1)
+		return (perror("Error creating pipe"), 1);
+	size = fcntl(fo->tee[0], F_GETPIPE_SZ);
+	while (fo->n_branches < n)
+	{
+		branch = &fo->branches[fo->n_branches++];
+		ft_memset(branch->fd, -1, sizeof(branch->fd));
+		ft_memset(branch->lag, -1, sizeof(branch->lag));
+		if (pipe2(branch->fd, O_CLOEXEC) == -1
+			|| pipe2(branch->lag, O_CLOEXEC) == -1)
+			return (perror("Error creating pipe"), 1);
+		if (size > 0)
+			fcntl(branch->lag[1], F_SETPIPE_SZ, size);
+		++fo->live;
+	}
+	return (0);
+}
+
+int	layout_fanout(t_fanout *fo, int argc, char *argv[])
+{
+	t_job	*job;
+	int		start;
+	int		end;
+	size_t	i;
+
+	fo->wall_ns = now_ns();
+	if (open_fanout(fo, fanout_branches(argc, argv)))
+		return (1);
+	end = 1;
+	i = 0;
+	while (i <= fo->n_branches)
+	{
+		start = end++;
+		while (end < argc
+			&& ft_strncmp(argv[end], FANOUT_SEP, sizeof(FANOUT_SEP)) != 0)
+			++end;
+		job = &fo->trunk;
+		if (i > 0)
+			job = &fo->branches[i - 1].job;
+		if (layout_job(fo, job, argv + start, end - start + (i == 0))
+			|| set_fd_path(fo, job, i++))
+			return (1);
+	}
+	return (0);
+}
+
+void	close_fanout(t_fanout *fo, int keep)
+{
+	int		*fd;
+	size_t	i;
+
+	i = 0;
+	while (i < 2 + fo->n_branches * 4)
+	{
+		if (i < 2)
+			fd = &fo->tee[i];
+		else if ((i - 2) % 4 < 2)
+			fd = &fo->branches[(i - 2) / 4].fd[(i - 2) % 2];
+		else
+			fd = &fo->branches[(i - 2) / 4].lag[(i - 2) % 2];
+		if (*fd != -1 && *fd != keep)
+		{
+			close(*fd);
+			*fd = -1;
+		}
+		++i;
+	}
+}
@@ -0,0 +1,144 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   fanout_bonus.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 09:42:34 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 09:42:34 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+size_t	fanout_branches(int argc, char *argv[])
+{
+	size_t	n;
+	int		i;
+
+	n = 0;
+	i = 2;
+	while (i < argc)
+		n += ft_strncmp(argv[i++], FANOUT_SEP, sizeof(FANOUT_SEP)) == 0;
+	return (n);
+}
+
+/**
+ * @brief Forks a worker that runs one part of a fan-out with fork_loop().
+ *
+ * The worker closes every fan-out descriptor but the one its pipeline opens
+ * as "/dev/fd/N", and the parent closes its own copy of that one, so each
+ * branch sees end of file as soon as the parent closes its pipe and the
+ * parent sees EPIPE as soon as a branch is gone. The stats report of the
+ * worker is disabled.
+ *
+ * @param fo The fan-out.
+ * @param part 0 for the trunk, or 1 plus the index of a branch. Its status
+ *             is 1 if the worker cannot be forked.
+ */
+static void	start_worker(t_fanout *fo, size_t part)
+{
+	t_job	*job;
+	int		*keep;
+
+	job = &fo->trunk;
+	keep = &fo->tee[1];
+	if (part > 0)
+	{
+		job = &fo->branches[part - 1].job;
+		keep = &fo->branches[part - 1].fd[0];
+	}
+	job->start_ns = now_ns();
+	job->status = 1;
+	job->pid = fork();
+	if (job->pid == 0)
+	{
+		close_fanout(fo, *keep);
+		fo->pinfo->opts.stats = 0;
+		exit(fork_loop(fo->pinfo, job->argc, job->argv));
+	}
+	close(*keep);
+	*keep = -1;
+	if (job->pid == -1)
+		perror("Error forking fan-out worker");
+	fo->running += job->pid > 0;
+}
+
+/**
+ * @brief Waits for any worker and records the status, wall time and
+ *        resource usage of its part.
+ *
+ * @param fo The fan-out, with at least one worker running.
+ */
+static void	reap_worker(t_fanout *fo)
+{
+	struct rusage	usage;
+	t_job			*job;
+	pid_t			pid;
+	int				status;
+	size_t			i;
+
+	pid = wait4(-1, &status, 0, &usage);
+	if (pid == -1 && errno != EINTR)
+		fo->running = 0;
+	job = &fo->trunk;
+	i = 0;
+	while (pid > 0 && job->pid != pid && i < fo->n_branches)
+		job = &fo->branches[i++].job;
+	if (pid <= 0 || job->pid != pid)
+		return ;
+	job->wall_ns = now_ns() - job->start_ns;
+	job->usage = usage;
+	job->status = WEXITSTATUS(status);
+	if (WIFSIGNALED(status))
+		job->status = 128 + WTERMSIG(status);
+	job->pid = 0;
+	--fo->running;
+}
+
+int	fanout_loop(t_pinfo *pinfo, int argc, char *argv[])
+{
+	t_fanout	fo;
+	size_t		i;
+	int			status;
+
+	ft_bzero(&fo, sizeof(t_fanout));
+	fo.pinfo = pinfo;
+	if (ft_strncmp(argv[1], "here_doc", 9) == 0)
+		return (ft_perror("here_doc cannot fan out", EINVAL, 0),
+				clean_pinfo(pinfo), 1);
+	if (layout_fanout(&fo, argc, argv))
+		return (close_fanout(&fo, -1), clean_pinfo(pinfo), 1);
+	i = 0;
+	while (i <= fo.n_branches)
+		start_worker(&fo, i++);
+	signal(SIGPIPE, SIG_IGN);
+	pump_fanout(&fo);
+	while (fo.running > 0)
+		reap_worker(&fo);
+	fo.wall_ns = now_ns() - fo.wall_ns;
+	if (pinfo->opts.stats)
+		report_fanout(&fo);
+	status = fanout_status(&fo);
+	return (clean_pinfo(pinfo), status);
+}
+
+void	end_branch(t_fanout *fo, t_branch *branch)
+{
+	if (branch->stalled_at)
+		branch->blocked_ns += now_ns() - branch->stalled_at;
+	branch->stalled_at = 0;
+	branch->pending = 0;
+	close(branch->fd[1]);
+	close(branch->lag[0]);
+	close(branch->lag[1]);
+	branch->fd[1] = -1;
+	branch->lag[0] = -1;
+	branch->lag[1] = -1;
+	if (--fo->live == 0 && fo->tee[0] != -1)
+	{
+		close(fo->tee[0]);
+		fo->tee[0] = -1;
+	}
+}
@@ -0,0 +1,168 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   fanout_pump_bonus.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 09:42:34 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 09:42:34 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+/**
+ * @brief Moves what the lag of a branch holds into the branch, ending the
+ *        stall of the branch once it is empty.
+ *
+ * @param fo The fan-out.
+ * @param branch The branch, with data pending.
+ */
+static void	flush_branch(t_fanout *fo, t_branch *branch)
+{
+	ssize_t	moved;
+
+	moved = splice(branch->lag[0], NULL, branch->fd[1], NULL,
+			branch->pending, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+	if (moved == -1 && errno != EAGAIN)
+	{
+		if (errno != EPIPE)
+			perror("Error feeding branch");
+		end_branch(fo, branch);
+		return ;
+	}
+	if (moved > 0)
+		branch->pending -= moved;
+	if (branch->pending == 0 && branch->stalled_at)
+	{
+		branch->blocked_ns += now_ns() - branch->stalled_at;
+		branch->stalled_at = 0;
+	}
+}
+
+/**
+ * @brief Hands one round of the trunk output to a branch.
+ *
+ * @param fo The fan-out.
+ * @param branch The branch, with an empty lag.
+ * @param len Bytes held by the trunk pipe.
+ * @param consume Non-zero for the last branch, which splices the round out
+ *                of the trunk pipe instead of teeing it.
+ */
+static void	feed_branch(t_fanout *fo, t_branch *branch, size_t len,
+		char consume)
+{
+	ssize_t	moved;
+
+	if (consume)
+		moved = splice(fo->tee[0], NULL, branch->lag[1], NULL, len,
+				SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+	else
+		moved = tee(fo->tee[0], branch->lag[1], len, SPLICE_F_NONBLOCK);
+	if (moved <= 0)
+	{
+		perror("Error duplicating trunk output");
+		end_branch(fo, branch);
+		return ;
+	}
+	branch->pending = moved;
+	branch->bytes += moved;
+	flush_branch(fo, branch);
+	if (branch->pending > 0)
+	{
+		++branch->stalls;
+		branch->stalled_at = now_ns();
+	}
+}
+
+/**
+ * @brief Duplicates what the trunk pipe holds into every live branch, or
+ *        closes the trunk pipe at end of file.
+ *
+ * @param fo The fan-out, with every lag empty.
+ */
+static void	tee_round(t_fanout *fo)
+{
+	size_t	i;
+	size_t	last;
+	int		len;
+
+	if (ioctl(fo->tee[0], FIONREAD, &len) == -1 || len <= 0)
+	{
+		close(fo->tee[0]);
+		fo->tee[0] = -1;
+		return ;
+	}
+	last = fo->n_branches;
+	while (last > 0 && fo->branches[last - 1].fd[1] == -1)
+		--last;
+	i = 0;
+	while (i < last)
+	{
+		if (fo->branches[i].fd[1] != -1)
+			feed_branch(fo, &fo->branches[i], len, i + 1 == last);
+		++i;
+	}
+	fo->bytes += len;
+}
+
+/**
+ * @brief Fills the poll set: the trunk pipe while every lag is empty, and
+ *        the branches with data pending. Once the trunk pipe is closed,
+ *        every branch with nothing pending is ended.
+ *
+ * @param fo The fan-out.
+ * @param fds The poll set, with room for the trunk and every branch.
+ */
+static void	set_poll(t_fanout *fo, struct pollfd *fds)
+{
+	t_branch	*branch;
+	size_t		i;
+
+	fds[0].fd = fo->tee[0];
+	fds[0].events = POLLIN;
+	i = 0;
+	while (i < fo->n_branches)
+	{
+		branch = &fo->branches[i++];
+		if (fo->tee[0] == -1 && branch->fd[1] != -1 && branch->pending == 0)
+			end_branch(fo, branch);
+		fds[i].fd = -1;
+		fds[i].events = POLLOUT;
+		if (branch->pending > 0)
+		{
+			fds[i].fd = branch->fd[1];
+			fds[0].fd = -1;
+		}
+	}
+}
+
+void	pump_fanout(t_fanout *fo)
+{
+	struct pollfd	*fds;
+	size_t			i;
+
+	fds = ft_arena_calloc(fo->pinfo->arena, fo->n_branches + 1,
+			sizeof(struct pollfd));
+	while (fds && fo->live > 0)
+	{
+		set_poll(fo, fds);
+		if (fo->live > 0 && poll(fds, fo->n_branches + 1, -1) == -1
+			&& errno != EINTR)
+		{
+			perror("Error polling fan-out");
+			fo->live = 0;
+		}
+		i = 0;
+		while (fo->live > 0 && i < fo->n_branches)
+		{
+			if (fds[i + 1].fd != -1 && fds[i + 1].revents)
+				flush_branch(fo, &fo->branches[i]);
+			++i;
+		}
+		if (fo->live > 0 && fds[0].fd != -1 && fds[0].revents)
+			tee_round(fo);
+	}
+	close_fanout(fo, -1);
+}
@@ -0,0 +1,96 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   fanout_report_bonus.c                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 09:42:34 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 09:42:34 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+/**
+ * @brief Writes the status, wall time and resource usage of a fan-out part.
+ *
+ * @param out Output buffer of the report.
+ * @param job The part to report.
+ */
+static void	report_job_usage(t_outbuf *out, t_job *job)
+{
+	json_key_num(out, "stages", job->argc - 3);
+	json_put(out, ",");
+	json_key_num(out, "status", job->status);
+	json_put(out, ",");
+	json_key_num(out, "wall_ns", job->wall_ns);
+	json_put(out, ",");
+	json_key_rusage(out, &job->usage);
+}
+
+/**
+ * @brief Writes the JSON object describing one branch.
+ *
+ * @param out Output buffer of the report.
+ * @param branch The branch to report.
+ * @param index Position of the branch on the command line, from 0.
+ */
+static void	report_branch(t_outbuf *out, t_branch *branch, long index)
+{
+	if (index > 0)
+		json_put(out, ",");
+	json_put(out, "{");
+	json_key_num(out, "branch", index);
+	json_put(out, ",");
+	json_key_num(out, "bytes", branch->bytes);
+	json_put(out, ",");
+	json_key_num(out, "stalls", branch->stalls);
+	json_put(out, ",");
+	json_key_num(out, "blocked_ns", branch->blocked_ns);
+	json_put(out, ",");
+	report_job_usage(out, &branch->job);
+	json_put(out, "}");
+}
+
+void	report_fanout(t_fanout *fo)
+{
+	char		buf[REPORT_BUF];
+	t_outbuf	out;
+	size_t		i;
+
+	ft_outbuf_init(&out, STDERR_FILENO, buf, sizeof(buf));
+	json_put(&out, "{\"fanout\":{");
+	json_key_num(&out, "branches", fo->n_branches);
+	json_put(&out, ",");
+	json_key_num(&out, "bytes", fo->bytes);
+	json_put(&out, ",");
+	json_key_num(&out, "wall_ns", fo->wall_ns);
+	json_put(&out, "},\"trunk\":{");
+	report_job_usage(&out, &fo->trunk);
+	json_put(&out, "},\"branches\":[");
+	i = 0;
+	while (i < fo->n_branches)
+	{
+		report_branch(&out, &fo->branches[i], i);
+		++i;
+	}
+	json_put(&out, "]}\n");
+	ft_outbuf_flush(&out);
+}
+
+int	fanout_status(t_fanout *fo)
+{
+	size_t	i;
+
+	if (fo->pinfo->opts.pipefail && fo->trunk.status != 0)
+		return (fo->trunk.status);
+	i = 0;
+	while (i < fo->n_branches)
+	{
+		if (fo->branches[i].job.status != 0)
+			return (fo->branches[i].job.status);
+		++i;
+	}
+	return (0);
+}
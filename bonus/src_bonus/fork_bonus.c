@@ -6,7 +6,7 @@
 /*   By: pablo <pablo@student.42.fr>                +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/04/07 13:16:10 by pablo             #+#    #+#             */
-/*   Updated: 2025/05/22 22:17:56 by pablo            ###   ########.fr       */
+/*   Updated: 2026/10/17 11:05:54 by pabmart2         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -45,28 +45,106 @@ static pid_t	handle_fork(t_pinfo *pinfo, char *argv[])
 	return (pid);
 }
 
-int	fork_loop(int argc, char *argv[], int **pipes)
+/**
+ * @brief Launches the command at argv[pinfo->i] with the selected backend
+ *        and records how long the launch took.
+ *
+ * @param pinfo Pointer to a t_pinfo structure. pinfo->i is the argv index of
+ *              the command to launch.
+ * @param argv  Array of argument strings, typically passed from main().
+ */
+static void	launch_stage(t_pinfo *pinfo, char *argv[])
 {
-	int		i;
-	pid_t	pid;
-	t_pinfo	*pinfo;
+	t_stage			*stage;
+	struct timespec	start;
+
+	stage = &pinfo->stages[pinfo->i - pinfo->first];
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	if (pinfo->opts.splice && ((pinfo->i == pinfo->first
+				&& pinfo->relays[0].in == -1) || (argv[pinfo->i + 2] == NULL
+				&& pinfo->relays[1].in == -1)))
+	{
+		stage->pid = -1;
+		stage->status = EXIT_FAILURE;
+	}
+	else if (stage->builtin)
+		stage->pid = launch_builtin(pinfo, argv);
+	else if (pinfo->opts.launch == LAUNCH_SPAWN)
+		stage->pid = handle_spawn(pinfo, argv);
+	else
+		stage->pid = handle_fork(pinfo, argv);
+	stage->launch_ns = elapsed_ns(&start);
+	arm_stage(pinfo, pinfo->i - pinfo->first);
+	roll_pipes(pinfo);
+}
+
+int	set_stages(t_pinfo *pinfo, int argc, char *argv[])
+{
+	int		status;
 
-	pinfo = set_pinfo(pipes);
-	if (!pinfo)
+	if (pinfo->stages)
+		return (0);
+	pinfo->first = 2 + (ft_strncmp(argv[1], "here_doc", 9) == 0);
+	pinfo->n_stages = argc - 1 - pinfo->first;
+	pinfo->stages = ft_arena_calloc(pinfo->arena, pinfo->n_stages,
+			sizeof(t_stage));
+	if (!pinfo->stages)
+		return (perror("Error allocating stages"), 1);
+	status = plan_stages(pinfo, argv);
+	if (status)
+		return (status);
+	if (pinfo->first == 3 && set_heredoc(pinfo, argv[2]))
 		return (1);
-	i = 2;
-	if (ft_strncmp(argv[1], "here_doc", 9) == 0)
+	return (0);
+}
+
+/**
+ * @brief Releases the parent's copies of the pipeline pipes, starts the
+ *        builtin stages, pumps the relays set by PIPEX_SPLICE,
+ *        PIPEX_INSTRUMENT or PIPEX_HEREDOC_STREAM and waits for every stage.
+ *
+ * The inner pipes must be closed before pumping, otherwise the stages would
+ * never see end of file and the pump would never finish. The builtin threads
+ * start once every command is forked, so no child is forked from a process
+ * running them.
+ *
+ * @param pinfo Pointer to a t_pinfo structure with every stage launched.
+ * @return The exit status of the last stage.
+ */
+static int	finish_pipeline(t_pinfo *pinfo)
+{
+	clean_pipes(pinfo);
+	if (pinfo->opts.builtins)
+		start_builtins(pinfo);
+	if (pinfo->n_relays > 0)
 	{
-		i = 3;
-		pinfo->heredoc_tmp_file = set_heredoc_tmp_file(argv[2]);
-		if (!pinfo->heredoc_tmp_file)
-			return (clean_pinfo(pinfo), 1);
+		close_relay_ends(pinfo);
+		signal(SIGPIPE, SIG_IGN);
+		run_relays(pinfo);
 	}
-	while (i < argc - 1)
+	return (wait_childs(pinfo));
+}
+
+int	fork_loop(t_pinfo *pinfo, int argc, char *argv[])
+{
+	int		exit_status;
+
+	exit_status = set_stages(pinfo, argc, argv);
+	if (exit_status)
+		return (clean_pinfo(pinfo), exit_status);
+	if (set_relays(pinfo, argv))
+		return (clean_pinfo(pinfo), 1);
+	if ((pinfo->opts.pipe_size || pinfo->opts.instrument) && set_links(pinfo))
+		return (clean_pinfo(pinfo), 1);
+	pinfo->i = pinfo->first;
+	while (pinfo->i < argc - 1 && open_stage_pipe(pinfo) == 0)
 	{
-		pinfo->i = i;
-		pid = handle_fork(pinfo, argv);
-		++i;
+		launch_stage(pinfo, argv);
+		++pinfo->i;
 	}
-	return (wait_childs(pid, pinfo));
+	exit_status = finish_pipeline(pinfo);
+	if (pinfo->opts.stats)
+		report_stats(pinfo, argv);
+	clean_pinfo(pinfo);
+	return (exit_status);
 }
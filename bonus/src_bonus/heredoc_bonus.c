@@ -6,122 +6,95 @@
 /*   By: pablo <pablo@student.42.fr>                +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/04/05 18:31:11 by pablo             #+#    #+#             */
-/*   Updated: 2025/05/22 22:18:01 by pablo            ###   ########.fr       */
+/*   Updated: 2026/10/17 10:25:37 by pabmart2         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "pipex_bonus.h"
 
-static int	check_zero_eof(char eof, char line)
+/**
+ * @brief Writes a whole block, retrying short writes.
+ *
+ * @param fd Descriptor to write to.
+ * @param buf The block.
+ * @param len Length of the block.
+ * @return 0 on success, 1 on error.
+ */
+static int	write_all(int fd, const char *buf, size_t len)
 {
-	if (eof == '\0')
+	ssize_t	written;
+
+	while (len > 0)
 	{
-		if (line == '\n')
+		written = write(fd, buf, len);
+		if (written == -1)
 			return (1);
-		else
-			return (0);
+		buf += written;
+		len -= written;
 	}
-	return (1);
+	return (0);
 }
 
 /**
- * @brief Reads input from stdin until a specified EOF string is encountered.
- *
- * Continuously prompts the user with "heredoc >" and reads lines from stdin.
- * Lines are appended to a buffer until a line matching the EOF string is
- * encountered. The EOF comparison uses `ft_strncmp`. Returns the buffer
- * excluding the EOF line.
- *
- * @param eof The string marking the end of input (EOF).
- * @param eof_size The length of the EOF string.
- * @return A pointer to the buffer with input lines, or NULL on error.
- *
- * @note Memory:
- *
- * - Dynamically allocates memory for the buffer and strings.
- *
- * - Frees memory on errors or successful completion.
+ * @brief Finds how much of the buffer can be forwarded.
  *
- * Errors:
+ * Complete lines are forwarded up to the delimiter. An incomplete line is
+ * kept while it may still be the delimiter, and forwarded, tainting the rest
+ * of it, once it is longer or it fills the whole buffer. Forwarding the
+ * lines before it frees room, so it is kept then even if the buffer is
+ * full, and a delimiter split by a read is still found.
  *
- * - On read or join errors, frees memory, prints an error with `perror`,
- *   and returns NULL.
+ * @param hd The reader, with done set if the delimiter is found.
+ * @param at_eof Non-zero if the input has ended.
+ * @return Bytes at the start of the buffer to forward.
  */
-char	*heredoc(char *eof, size_t eof_size)
+static size_t	scan_lines(t_heredoc *hd, int at_eof)
 {
-	char	*buffer;
-	char	*line;
-	char	*tmp;
+	size_t	i;
+	size_t	end;
+	char	*nl;
 
-	buffer = NULL;
-	while (1)
+	i = 0;
+	while (i < hd->len && !hd->done)
 	{
-		ft_printf("heredoc >");
-		line = ft_get_next_line(STDIN_FILENO);
-		if (line)
+		nl = ft_memchr(hd->buf + i, '\n', hd->len - i);
+		end = hd->len;
+		if (nl)
+			end = nl - hd->buf;
+		if (!hd->tainted && end - i == hd->eof_len && (nl || at_eof)
+			&& ft_memcmp(hd->buf + i, hd->eof, hd->eof_len) == 0)
+			hd->done = 1;
+		else if (!nl && !at_eof && !hd->tainted && end - i <= hd->eof_len
+			&& (i > 0 || hd->len < HEREDOC_CHUNK))
+			return (i);
+		else
 		{
-			if (!ft_strncmp(line, eof, eof_size) && check_zero_eof(*eof, *line))
-				return (ft_free((void **)&line), ft_get_next_line(-1), buffer);
-			tmp = buffer;
-			buffer = ft_strjoin(buffer, line);
-			if (tmp)
-				ft_free((void **)&tmp);
-			ft_free((void **)&line);
-			if (!buffer)
-				return (ft_free((void **)&buffer), ft_get_next_line(-1),
-					perror("Error joining heredoc"), NULL);
+			hd->tainted = (nl == NULL);
+			i = end + (nl != NULL);
 		}
-		else
-			return (ft_free((void **)&buffer), perror("Heredoc error"), NULL);
-	}
-}
-
-static char	*gerate_tmp_heredoc_name(void)
-{
-	int		n;
-	char	*tmp_name;
-	char	*tmp_n;
-
-	n = 0;
-	tmp_n = ft_itoa(n);
-	tmp_name = ft_strjoin(".heredoc_tmp", tmp_n);
-	if (!tmp_n || !tmp_name)
-		return (NULL);
-	while (access(tmp_name, W_OK) != -1)
-	{
-		ft_free((void **)&tmp_n);
-		ft_free((void **)&tmp_name);
-		tmp_n = ft_itoa(++n);
-		tmp_name = ft_strjoin(".heredoc_tmp", tmp_n);
-		if (!tmp_n || !tmp_name)
-			return (NULL);
 	}
-	errno = 0;
-	ft_free((void **)&tmp_n);
-	return (tmp_name);
+	hd->done |= at_eof;
+	return (i);
 }
 
-char	*set_heredoc_tmp_file(char *eof)
+ssize_t	heredoc_step(t_heredoc *hd, int in, int out)
 {
-	char	*buffer;
-	char	*tmp_name;
-	int		tmp_file;
+	ssize_t	n;
+	size_t	ready;
 
-	buffer = heredoc(eof, ft_strlen(eof));
-	if (!buffer)
-		return (NULL);
-	tmp_name = gerate_tmp_heredoc_name();
-	if (!tmp_name)
-		return (ft_free((void **)&buffer),
-			perror("Error generating heredoc tmp filename"), NULL);
-	tmp_file = open(tmp_name, O_WRONLY | O_CREAT | O_TRUNC, 0644);
-	if (tmp_file == -1)
-		return (ft_free((void **)&buffer), ft_free((void **)tmp_name),
-			perror("Error opening here_doc tmp file"), NULL);
-	write(tmp_file, buffer, ft_strlen(buffer));
-	if (close(tmp_file))
-		return (ft_free((void **)&buffer), ft_free((void **)&tmp_name),
-			perror("Error closing here_doc tmp file"), NULL);
-	ft_free((void **)&buffer);
-	return (tmp_name);
+	n = read(in, hd->buf + hd->len, HEREDOC_CHUNK - hd->len);
+	if (n == -1)
+		return (-1);
+	hd->len += n;
+	ready = scan_lines(hd, n == 0);
+	if (ready > 0 && write_all(out, hd->buf, ready))
+		return (-1);
+	hd->len -= ready;
+	ft_memmove(hd->buf, hd->buf + ready, hd->len);
+	if (hd->prompt && !hd->done && !hd->tainted && hd->len == 0)
+		ft_printf("heredoc >");
+	if (ready > 0 || hd->done)
+		return (ready);
+	errno = EAGAIN;
+	return (-1);
 }
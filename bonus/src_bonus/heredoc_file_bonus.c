@@ -0,0 +1,89 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   heredoc_file_bonus.c                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 08:53:04 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 09:37:26 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+int	anon_file(const char *name)
+{
+	int	fd;
+
+	fd = memfd_create(name, MFD_CLOEXEC);
+	if (fd == -1)
+		fd = open(HEREDOC_TMPDIR, O_TMPFILE | O_RDWR | O_CLOEXEC, 0600);
+	return (fd);
+}
+
+/**
+ * @brief Allocates a heredoc reader from the arena and prints the first
+ *        prompt if stdin is a terminal.
+ *
+ * @param arena The arena of the run.
+ * @param eof The delimiter.
+ * @return The reader, or NULL.
+ */
+static t_heredoc	*new_heredoc(t_arena *arena, char *eof)
+{
+	t_heredoc	*hd;
+
+	hd = ft_arena_calloc(arena, 1, sizeof(t_heredoc));
+	if (!hd)
+		return (NULL);
+	hd->buf = ft_arena_alloc(arena, HEREDOC_CHUNK);
+	if (!hd->buf)
+		return (NULL);
+	hd->eof = eof;
+	hd->eof_len = ft_strlen(eof);
+	hd->prompt = isatty(STDIN_FILENO);
+	if (hd->prompt)
+		ft_printf("heredoc >");
+	return (hd);
+}
+
+/**
+ * @brief Reads the whole heredoc into an anonymous file.
+ *
+ * @param hd The reader.
+ * @return An O_CLOEXEC descriptor of the file, positioned at its start, or
+ *         -1 with an error message printed.
+ */
+static int	open_heredoc(t_heredoc *hd)
+{
+	int	fd;
+
+	fd = anon_file(HEREDOC_NAME);
+	if (fd == -1)
+		return (perror("Error creating heredoc file"), -1);
+	while (!hd->done)
+	{
+		if (heredoc_step(hd, STDIN_FILENO, fd) == -1 && errno != EAGAIN)
+			return (close(fd), perror("Error writing heredoc file"), -1);
+	}
+	if (lseek(fd, 0, SEEK_SET) == -1)
+		return (close(fd), perror("Error writing heredoc file"), -1);
+	return (fd);
+}
+
+int	set_heredoc(t_pinfo *pinfo, char *eof)
+{
+	t_heredoc	*hd;
+
+	hd = new_heredoc(pinfo->arena, eof);
+	if (!hd)
+		return (perror("Error allocating heredoc"), 1);
+	if (pinfo->opts.heredoc_stream)
+	{
+		pinfo->heredoc = hd;
+		return (0);
+	}
+	pinfo->heredoc_fd = open_heredoc(hd);
+	return (pinfo->heredoc_fd == -1);
+}
@@ -0,0 +1,60 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   json_usage_bonus.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 08:07:55 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 09:18:48 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+void	json_key_rusage(t_outbuf *out, struct rusage *usage)
+{
+	json_put(out, "\"rusage\":{");
+	json_key_num(out, "utime_us", usage->ru_utime.tv_sec * 1000000L
+		+ usage->ru_utime.tv_usec);
+	json_put(out, ",");
+	json_key_num(out, "stime_us", usage->ru_stime.tv_sec * 1000000L
+		+ usage->ru_stime.tv_usec);
+	json_put(out, ",");
+	json_key_num(out, "maxrss_kb", usage->ru_maxrss);
+	json_put(out, ",");
+	json_key_num(out, "majflt", usage->ru_majflt);
+	json_put(out, ",");
+	json_key_num(out, "minflt", usage->ru_minflt);
+	json_put(out, ",");
+	json_key_num(out, "nvcsw", usage->ru_nvcsw);
+	json_put(out, ",");
+	json_key_num(out, "nivcsw", usage->ru_nivcsw);
+	json_put(out, "}");
+}
+
+void	json_key_arena(t_outbuf *out, t_arena *arena)
+{
+	json_put(out, "\"arena\":{");
+	json_key_num(out, "peak", arena->peak);
+	json_put(out, ",");
+	json_key_num(out, "reserved", arena->reserved);
+	json_put(out, ",");
+	json_key_num(out, "chunks", arena->chunks);
+	json_put(out, "}");
+}
+
+void	json_relay_traffic(t_outbuf *out, t_relay *relay)
+{
+	json_key_num(out, "bytes", relay->bytes);
+	json_put(out, ",");
+	json_key_num(out, "reads", relay->reads);
+	json_put(out, ",");
+	json_key_num(out, "writes", relay->writes);
+	json_put(out, ",");
+	json_key_num(out, "blocked_ns", relay->blocked_ns);
+	json_put(out, ",");
+	json_key_num(out, "wait_ns", relay->wait_ns);
+	json_put(out, ",");
+	json_key_num(out, "splice", !relay->use_rw);
+}
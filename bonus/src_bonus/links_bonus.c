@@ -0,0 +1,97 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   links_bonus.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 08:00:18 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 08:48:24 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+/**
+ * @brief Reads the largest capacity an unprivileged pipe may be given.
+ *
+ * @return The value of PIPE_MAX_FILE, or PIPE_MAX_DEFAULT if it cannot be
+ *         read.
+ */
+static int	pipe_max_size(void)
+{
+	char	buffer[32];
+	ssize_t	n;
+	int		fd;
+
+	n = -1;
+	fd = open(PIPE_MAX_FILE, O_RDONLY | O_CLOEXEC);
+	if (fd != -1)
+	{
+		n = read(fd, buffer, sizeof(buffer) - 1);
+		close(fd);
+	}
+	if (n <= 0)
+		return (PIPE_MAX_DEFAULT);
+	buffer[n] = '\0';
+	return (ft_atoi(buffer));
+}
+
+void	resize_link(t_link *link, int fd, long size)
+{
+	if (size > link->max)
+		size = link->max;
+	if (fcntl(fd, F_SETPIPE_SZ, (int)size) == -1)
+	{
+		perror("Error resizing pipe");
+		link->max = link->size;
+	}
+	else
+		link->size = fcntl(fd, F_GETPIPE_SZ);
+}
+
+void	open_link(t_pinfo *pinfo, size_t index, int fd)
+{
+	t_link	*link;
+	long	size;
+
+	link = &pinfo->links[index];
+	size = pipe_size_opt(pinfo->opts.pipe_size, index);
+	link->size = fcntl(fd, F_GETPIPE_SZ);
+	if (size > 0)
+		resize_link(link, fd, size);
+	else if (size == -1)
+	{
+		link->autosize = 1;
+		link->rd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+		if (link->rd == -1)
+			perror("Error duplicating pipe");
+	}
+}
+
+int	set_links(t_pinfo *pinfo)
+{
+	size_t	i;
+	int		max;
+
+	pinfo->links = ft_arena_calloc(pinfo->arena, pinfo->n_stages - 1,
+			sizeof(t_link));
+	if (!pinfo->links)
+		return (perror("Error allocating links"), 1);
+	pinfo->n_links = pinfo->n_stages - 1;
+	max = pipe_max_size();
+	i = 0;
+	while (i < pinfo->n_links)
+	{
+		pinfo->links[i].rd = -1;
+		pinfo->links[i++].max = max;
+	}
+	return (0);
+}
+
+void	close_link(t_link *link)
+{
+	if (link->rd != -1 && close(link->rd) == -1)
+		perror("Error closing pipe");
+	link->rd = -1;
+}
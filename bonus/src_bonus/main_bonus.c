@@ -6,29 +6,63 @@
 /*   By: pablo <pablo@student.42.fr>                +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/04/02 11:59:19 by pablo             #+#    #+#             */
-/*   Updated: 2025/05/22 22:18:05 by pablo            ###   ########.fr       */
+/*   Updated: 2026/10/17 09:53:50 by pabmart2         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "libft.h"
 #include "pipex_bonus.h"
 
-int	main(int argc, char *argv[])
+/**
+ * @brief Checks the number of arguments for the mode they select, exiting
+ *        with a usage error if it does not fit.
+ *
+ * @param argc The argument count passed to the program.
+ * @param argv The argument vector passed to the program.
+ * @return 'b' for a batch manifest, 'd' for a DAG description, or 0 for a
+ *         pipeline.
+ */
+static char	check_args(int argc, char *argv[])
 {
-	size_t	n_pipes;
-	int		**pipes;
+	char	mode;
 
-	n_pipes = argc - 4;
-	if (argc > 2 && ft_strncmp(argv[1], "here_doc", 9) == 0)
+	mode = 0;
+	if (argc > 1 && ft_strncmp(argv[1], "batch", 6) == 0)
+		mode = 'b';
+	else if (argc > 1 && ft_strncmp(argv[1], "dag", 4) == 0)
+		mode = 'd';
+	if (mode == 'b' && argc != 3)
+		ft_perror("Usage: pipex batch manifest", EINVAL, EXIT_FAILURE);
+	else if (mode == 'd' && argc != 3)
+		ft_perror("Usage: pipex dag file", EINVAL, EXIT_FAILURE);
+	else if (argc > 2 && ft_strncmp(argv[1], "here_doc", 9) == 0)
 	{
-		++n_pipes;
 		if (argc < 6)
 			ft_perror("Not enough arguments", EINVAL, EXIT_FAILURE);
 	}
-	else if (argc < 5)
+	else if (!mode && argc < 5)
 		ft_perror("Not enough arguments", EINVAL, EXIT_FAILURE);
-	pipes = ft_calloc(n_pipes + 1, sizeof(int *));
-	if (create_pipes(pipes, n_pipes))
-		ft_perror("Error creating pipes", 0, EXIT_FAILURE);
-	return (fork_loop(argc, argv, pipes));
+	return (mode);
+}
+
+int	main(int argc, char *argv[])
+{
+	t_arena	arena;
+	t_pinfo	*pinfo;
+	char	mode;
+
+	mode = check_args(argc, argv);
+	ft_arena_init(&arena);
+	pinfo = set_pinfo(&arena);
+	if (!pinfo)
+		return (ft_arena_destroy(&arena), 1);
+	if (mode == 'b')
+		return (batch_loop(pinfo, argv[2]));
+	if (mode == 'd')
+		return (dag_loop(pinfo, argv[2]));
+	if (fanout_branches(argc, argv) > 0)
+		return (fanout_loop(pinfo, argc, argv));
+	if (pinfo->opts.shards > 1)
+		return (shard_loop(pinfo, argc, argv));
+	return (fork_loop(pinfo, argc, argv));
 }
@@ -0,0 +1,109 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   options_bonus.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 07:46:07 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 10:11:33 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+/**
+ * @brief Reads an option from the environment.
+ *
+ * @param name Name of the environment variable.
+ * @param flag If not NULL, set to 1 if the variable is set to anything other
+ *             than "" or "0", 0 otherwise.
+ * @return The value of the variable, or NULL if it is unset or empty.
+ */
+static char	*env_opt(const char *name, char *flag)
+{
+	char	*value;
+
+	value = ft_getenv(name);
+	if (value && !*value)
+		value = NULL;
+	if (flag)
+		*flag = value && ft_strncmp(value, "0", 2) != 0;
+	return (value);
+}
+
+/**
+ * @brief Finds an entry of a comma separated option list.
+ *
+ * @param spec The option value.
+ * @param index Index of the entry, from 0.
+ * @return The start of the entry, or of the last one if the list is shorter.
+ */
+static const char	*list_entry(const char *spec, size_t index)
+{
+	while (index-- > 0 && ft_strchr(spec, ','))
+		spec = ft_strchr(spec, ',') + 1;
+	return (spec);
+}
+
+void	set_popts(t_popts *opts)
+{
+	char	*value;
+
+	opts->launch = LAUNCH_FORK;
+	value = env_opt("PIPEX_LAUNCH", NULL);
+	if (value && ft_strncmp(value, "spawn", 6) == 0)
+		opts->launch = LAUNCH_SPAWN;
+	env_opt("PIPEX_STATS", &opts->stats);
+	env_opt("PIPEX_SPLICE", &opts->splice);
+	env_opt("PIPEX_INSTRUMENT", &opts->instrument);
+	env_opt("PIPEX_PIPEFAIL", &opts->pipefail);
+	opts->pipe_size = env_opt("PIPEX_PIPE_SIZE", NULL);
+	opts->timeout_ms = duration_opt(env_opt("PIPEX_TIMEOUT", NULL), 0);
+	opts->stage_timeout = env_opt("PIPEX_STAGE_TIMEOUT", NULL);
+	opts->path_index = PATH_INDEX_STAGES;
+	value = env_opt("PIPEX_PATH_INDEX", NULL);
+	if (value)
+		opts->path_index = ft_atoi(value);
+	env_opt("PIPEX_HEREDOC_STREAM", &opts->heredoc_stream);
+	env_opt("PIPEX_BUILTINS", &opts->builtins);
+	value = env_opt("PIPEX_SHARDS", NULL);
+	if (value)
+		opts->shards = ft_atoi(value);
+}
+
+long	pipe_size_opt(const char *spec, size_t link)
+{
+	long	size;
+
+	if (!spec)
+		return (0);
+	spec = list_entry(spec, link);
+	if (ft_strncmp(spec, "auto", 4) == 0 && (!spec[4] || spec[4] == ','))
+		return (-1);
+	size = 0;
+	while (ft_isdigit(*spec) && size <= INT_MAX)
+		size = size * 10 + *spec++ - '0';
+	if (*spec == 'k' || *spec == 'K')
+		size *= 1024;
+	else if (*spec == 'm' || *spec == 'M')
+		size *= 1024 * 1024;
+	return (size);
+}
+
+long	duration_opt(const char *spec, size_t index)
+{
+	long	ms;
+
+	if (!spec)
+		return (0);
+	spec = list_entry(spec, index);
+	ms = 0;
+	while (ft_isdigit(*spec) && ms <= INT_MAX)
+		ms = ms * 10 + *spec++ - '0';
+	if (spec[0] == 'm' && spec[1] == 's')
+		return (ms);
+	if (spec[0] == 'm')
+		return (ms * 60000);
+	return (ms * 1000);
+}
@@ -0,0 +1,139 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   path_index_bonus.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 08:32:25 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 08:41:39 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+/**
+ * @brief Finds the slot of a name with linear probing.
+ *
+ * @param index The index. Its table must have at least one free slot.
+ * @param name The name to look for.
+ * @param len Length of the name, including its terminating NUL.
+ * @param hash Hash of the name, see fnv_hash().
+ * @return The slot holding the name, or the free slot where it belongs.
+ */
+static t_path_slot	*find_slot(t_path_index *index, const char *name,
+		size_t len, unsigned long hash)
+{
+	t_path_slot	*slot;
+	size_t		i;
+
+	i = hash & index->mask;
+	slot = &index->slots[i];
+	while (slot->name && (slot->hash != hash
+			|| ft_strncmp(index->pool + slot->name - 1, name, len) != 0))
+	{
+		i = (i + 1) & index->mask;
+		slot = &index->slots[i];
+	}
+	return (slot);
+}
+
+/**
+ * @brief Doubles the hash table of the index and moves every name to it.
+ *
+ * The old table is left in the scratch arena of the index.
+ *
+ * @param index The index to grow.
+ * @return 0 on success, 1 if memory could not be allocated.
+ */
+static int	grow_slots(t_path_index *index)
+{
+	t_path_slot	*old;
+	char		*name;
+	size_t		size;
+	size_t		i;
+
+	old = index->slots;
+	size = PATH_INDEX_SLOTS;
+	if (old)
+		size = (index->mask + 1) * 2;
+	index->slots = ft_arena_calloc(&index->arena, size, sizeof(t_path_slot));
+	if (!index->slots)
+	{
+		index->slots = old;
+		return (1);
+	}
+	i = index->mask + 1;
+	index->mask = size - 1;
+	while (old && i-- > 0)
+		if (old[i].name)
+		{
+			name = index->pool + old[i].name - 1;
+			*find_slot(index, name, ft_strlen(name) + 1, old[i].hash) = old[i];
+		}
+	return (0);
+}
+
+/**
+ * @brief Makes room in the string pool for another name.
+ *
+ * @param index The index.
+ * @param len Length of the name, including its terminating NUL.
+ * @return 0 on success, 1 if memory could not be allocated.
+ */
+static int	grow_pool(t_path_index *index, size_t len)
+{
+	size_t	cap;
+	char	*pool;
+
+	cap = index->pool_cap * 2;
+	if (cap < PATH_INDEX_POOL)
+		cap = PATH_INDEX_POOL;
+	while (cap < index->pool_len + len)
+		cap *= 2;
+	pool = ft_arena_alloc(&index->arena, cap);
+	if (!pool)
+		return (1);
+	if (index->pool)
+		ft_memcpy(pool, index->pool, index->pool_len);
+	index->pool = pool;
+	index->pool_cap = cap;
+	return (0);
+}
+
+int	path_index_add(t_path_index *index, const char *name, size_t dir)
+{
+	t_path_slot		*slot;
+	unsigned long	hash;
+	size_t			len;
+
+	if ((index->used + 1) * 2 > index->mask + 1 && grow_slots(index))
+		return (1);
+	len = ft_strlen(name) + 1;
+	hash = fnv_hash(name, CMD_CACHE_FNV);
+	slot = find_slot(index, name, len, hash);
+	if (slot->name)
+		return (0);
+	if (index->pool_len + len > index->pool_cap && grow_pool(index, len))
+		return (1);
+	ft_memcpy(index->pool + index->pool_len, name, len);
+	slot->hash = hash;
+	slot->name = index->pool_len + 1;
+	slot->dir = dir;
+	index->pool_len += len;
+	++index->used;
+	return (0);
+}
+
+t_path_slot	*path_index_find(t_path_index *index, const char *name)
+{
+	t_path_slot	*slot;
+
+	if (!index->slots)
+		return (NULL);
+	slot = find_slot(index, name, ft_strlen(name) + 1,
+			fnv_hash(name, CMD_CACHE_FNV));
+	if (!slot->name)
+		return (NULL);
+	return (slot);
+}
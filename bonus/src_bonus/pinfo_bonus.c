@@ -6,39 +6,55 @@
 /*   By: pablo <pablo@student.42.fr>                +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/05/15 17:10:22 by pabmart2          #+#    #+#             */
-/*   Updated: 2025/05/22 22:18:08 by pablo            ###   ########.fr       */
+/*   Updated: 2026/10/17 08:49:22 by pabmart2         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "pipex_bonus.h"
 
+/**
+ * @brief Closes every descriptor held by a pinfo structure.
+ *
+ * @param pinfo The structure to close.
+ */
+static void	close_pinfo(t_pinfo *pinfo)
+{
+	clean_pipes(pinfo);
+	while (pinfo->n_relays > 0)
+		close_relay(&pinfo->relays[--pinfo->n_relays]);
+	close_relay_ends(pinfo);
+	while (pinfo->n_links > 0)
+		close_link(&pinfo->links[--pinfo->n_links]);
+	if (pinfo->heredoc_fd != -1)
+		close(pinfo->heredoc_fd);
+	pinfo->heredoc_fd = -1;
+	cmd_cache_close(&pinfo->cmd_cache);
+}
+
 void	clean_pinfo(t_pinfo *pinfo)
 {
-	if (pinfo->paths)
-		ft_matrix_free((void **)(pinfo->paths), 0);
-	if (pinfo->pipes)
-		clean_pipes(pinfo->pipes);
-	if (pinfo->heredoc_tmp_file)
-		ft_free((void **)(&pinfo->heredoc_tmp_file));
-	ft_free((void **)&pinfo);
+	close_pinfo(pinfo);
+	ft_arena_destroy(pinfo->arena);
 }
 
-t_pinfo	*set_pinfo(int **pipes)
+t_pinfo	*set_pinfo(t_arena *arena)
 {
 	t_pinfo	*pinfo;
-	char	**paths;
+	char	*path;
 
-	paths = ft_split(ft_getenv("PATH"), ':');
-	if (!paths)
-	{
-		clean_pipes(pipes);
-		ft_perror("Error getting cmd paths", 0, EXIT_FAILURE);
-	}
-	pinfo = malloc(sizeof(t_pinfo));
-	if (!pinfo)
-		return (NULL);
-	pinfo->paths = paths;
-	pinfo->pipes = pipes;
-	pinfo->heredoc_tmp_file = NULL;
+	path = ft_getenv("PATH");
+	if (!path)
+		path = "";
+	pinfo = ft_arena_calloc(arena, 1, sizeof(t_pinfo));
+	if (pinfo)
+		pinfo->paths = ft_arena_split(arena, path, ':');
+	if (!pinfo || !pinfo->paths)
+		return (perror("Error getting cmd paths"), NULL);
+	pinfo->arena = arena;
+	ft_memset(pinfo->pipes, -1, sizeof(pinfo->pipes));
+	pinfo->heredoc_fd = -1;
+	pinfo->relay_ends[0] = -1;
+	pinfo->relay_ends[1] = -1;
+	set_popts(&pinfo->opts);
 	return (pinfo);
 }
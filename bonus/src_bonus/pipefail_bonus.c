@@ -0,0 +1,95 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pipefail_bonus.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 08:18:56 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 10:21:07 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+/**
+ * @brief Closes the parent ends of the relays and links feeding the stages
+ *        upstream of a failed one, so they see EOF or get SIGPIPE at once.
+ *
+ * @param pinfo Pipeline information.
+ * @param index Index of the failed stage. It must not be 0.
+ */
+static void	close_upstream(t_pinfo *pinfo, size_t index)
+{
+	size_t	k;
+
+	if (pinfo->n_relays > 0)
+		close_relay(&pinfo->relays[0]);
+	k = 0;
+	while (k < index && k < pinfo->n_links)
+	{
+		close_link(&pinfo->links[k]);
+		if (2 + k < pinfo->n_relays)
+			close_relay(&pinfo->relays[2 + k]);
+		++k;
+	}
+}
+
+/**
+ * @brief Records the failed stage and tears down every stage upstream of
+ *        it.
+ *
+ * @param pinfo Pipeline information.
+ * @param index Index of the failed stage, from 0.
+ */
+static void	fail_pipeline(t_pinfo *pinfo, size_t index)
+{
+	t_stage	*stage;
+	size_t	i;
+
+	pinfo->failed = index;
+	pinfo->failed_at = now_ns();
+	pinfo->teardown_ns = 0;
+	if (index == 0)
+		return ;
+	i = 0;
+	while (i < index)
+	{
+		stage = &pinfo->stages[i++];
+		if (stage->pid != -1 && !stage->reaped && stage->signals == 0)
+			signal_stage(stage, pinfo->failed_at);
+	}
+	close_upstream(pinfo, index);
+}
+
+void	check_pipefail(t_pinfo *pinfo, size_t index)
+{
+	if (!pinfo->opts.pipefail)
+		return ;
+	if (pinfo->failed_at && index < pinfo->failed)
+		pinfo->teardown_ns = now_ns() - pinfo->failed_at;
+	else if (pinfo->stages[index].status != 0 && (!pinfo->failed_at
+			|| pinfo->stages[pinfo->failed].status == 128 + SIGPIPE))
+		fail_pipeline(pinfo, index);
+}
+
+int	pipeline_status(t_pinfo *pinfo)
+{
+	if (pinfo->failed_at)
+		return (pinfo->stages[pinfo->failed].status);
+	return (pinfo->stages[pinfo->n_stages - 1].status);
+}
+
+void	report_pipefail(t_outbuf *out, t_pinfo *pinfo)
+{
+	if (!pinfo->failed_at)
+		return ;
+	json_put(out, ",\"pipefail\":{");
+	json_key_num(out, "stage", pinfo->failed);
+	json_put(out, ",");
+	json_key_num(out, "status",
+		pinfo->stages[pinfo->failed].status);
+	json_put(out, ",");
+	json_key_num(out, "teardown_ns", pinfo->teardown_ns);
+	json_put(out, "}");
+}
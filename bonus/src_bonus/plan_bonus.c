@@ -0,0 +1,96 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   plan_bonus.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 08:28:39 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 10:53:16 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+/**
+ * @brief Tokenizes the command of a stage and resolves its executable.
+ *
+ * The stage is marked as not launched, with EXIT_FAILURE as the status it
+ * keeps if it never is. With PIPEX_BUILTINS, a command plan_builtin()
+ * supports is not resolved.
+ *
+ * @param pinfo Pipeline information holding the PATH array, the command
+ *              cache and the arena.
+ * @param stage The stage to plan.
+ * @param cmd Command string of the stage as given on the command line.
+ * @param index The PATH index, see path_index_build().
+ * @return 0 on success, 127 if the command is empty or was not found, 2 if
+ *         it leaves a quote open, or 1 if memory could not be allocated.
+ */
+static int	plan_stage(t_pinfo *pinfo, t_stage *stage, char *cmd,
+		t_path_index *index)
+{
+	stage->pid = -1;
+	stage->status = EXIT_FAILURE;
+	stage->args = split_args(pinfo->arena, cmd, &stage->quoted);
+	if (!stage->args && errno == EINVAL)
+		return (ft_perror("Unterminated quote in command", 0, 0), 2);
+	if (!stage->args)
+		return (perror("Error splitting arguments from command"), 1);
+	if (pinfo->opts.builtins)
+		stage->builtin = plan_builtin(pinfo, stage->args);
+	if (stage->builtin)
+		return (0);
+	stage->path = get_cmd_path(pinfo, stage->args[0], index);
+	if (!stage->path)
+	{
+		stage->status = 127;
+		if (stage->args[0])
+			ft_perror("Command not found", 0, 0);
+		return (127);
+	}
+	return (0);
+}
+
+/**
+ * @brief Picks the PATH index to resolve the stages with.
+ *
+ * @param pinfo Pipeline information with the stages allocated.
+ * @param local Index to build when pinfo has no shared one. It is left empty
+ *              unless the pipeline has at least PIPEX_PATH_INDEX stages.
+ * @return The shared index, or local.
+ */
+static t_path_index	*stage_index(t_pinfo *pinfo, t_path_index *local)
+{
+	if (pinfo->path_index)
+		return (pinfo->path_index);
+	ft_bzero(local, sizeof(t_path_index));
+	if (pinfo->opts.path_index > 0
+		&& pinfo->n_stages >= (size_t)pinfo->opts.path_index)
+		path_index_build(local, pinfo->paths);
+	return (local);
+}
+
+int	plan_stages(t_pinfo *pinfo, char *argv[])
+{
+	t_path_index	local;
+	t_path_index	*index;
+	size_t			i;
+	int				status;
+	int				error;
+
+	index = stage_index(pinfo, &local);
+	status = 0;
+	i = 0;
+	while (i < pinfo->n_stages && status != 1)
+	{
+		error = plan_stage(pinfo, &pinfo->stages[i], argv[pinfo->first + i],
+				index);
+		if (error)
+			status = error;
+		++i;
+	}
+	if (index == &local)
+		path_index_clean(&local);
+	return (status);
+}
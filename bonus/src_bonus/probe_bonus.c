@@ -0,0 +1,89 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   probe_bonus.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 08:06:30 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 08:48:24 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+long	elapsed_ns(struct timespec *start)
+{
+	struct timespec	now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((now.tv_sec - start->tv_sec) * 1000000000L
+		+ (now.tv_nsec - start->tv_nsec));
+}
+
+long	now_ns(void)
+{
+	struct timespec	now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec * 1000000000L + now.tv_nsec);
+}
+
+/**
+ * @brief Accounts the time since the previous sample to the state found
+ *        then, and samples the fill level of the relay pipes again.
+ *
+ * @param relay The relay to sample.
+ * @param dt Nanoseconds since the previous sample.
+ */
+static void	sample_relay(t_relay *relay, long dt)
+{
+	int	avail;
+
+	if (relay->in == -1)
+		return ;
+	relay->blocked_ns += relay->blocked * dt;
+	relay->wait_ns += relay->waiting * dt;
+	relay->blocked = relay->poll_in
+		&& ioctl(relay->in, FIONREAD, &avail) != -1
+		&& avail + PIPE_BUF > fcntl(relay->in, F_GETPIPE_SZ);
+	relay->waiting = relay->poll_out
+		&& ioctl(relay->out, FIONREAD, &avail) != -1 && avail == 0;
+}
+
+int	probe_link(t_pinfo *pinfo, size_t index, int *read_end)
+{
+	int	fds[2];
+
+	if (pipe2(fds, O_CLOEXEC) == -1)
+		return (perror("Error creating pipe"), 1);
+	init_relay(&pinfo->relays[2 + index], *read_end, fds[1]);
+	pinfo->relays[2 + index].poll_in = 1;
+	pinfo->relays[2 + index].poll_out = 1;
+	*read_end = fds[0];
+	return (0);
+}
+
+int	relay_tick(t_pinfo *pinfo)
+{
+	long	dt;
+	int		timeout;
+	size_t	i;
+
+	timeout = check_deadlines(pinfo);
+	if (tune_links(pinfo))
+		timeout = sooner(timeout, PIPE_TUNE_MS);
+	if (pinfo->opts.pipefail && reap_stages(pinfo))
+		timeout = sooner(timeout, SUPERVISE_POLL_MS);
+	if (!pinfo->opts.instrument)
+		return (timeout);
+	dt = elapsed_ns(&pinfo->sampled_at);
+	if (dt >= RELAY_SAMPLE_MS * 1000000L)
+	{
+		clock_gettime(CLOCK_MONOTONIC, &pinfo->sampled_at);
+		i = 0;
+		while (i < pinfo->n_relays)
+			sample_relay(&pinfo->relays[i++], dt);
+	}
+	return (RELAY_SAMPLE_MS);
+}
@@ -0,0 +1,152 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pump_bonus.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 07:50:31 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 09:37:26 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+/**
+ * @brief Builds the poll set of every unfinished relay.
+ *
+ * @param relays Array of relays. Their slot indexes are updated.
+ * @param n Number of relays.
+ * @param fds Poll set to fill. It must hold 2 * n entries.
+ * @return Number of entries in the poll set. 0 once every relay is finished.
+ */
+static nfds_t	set_poll_slots(t_relay *relays, size_t n, struct pollfd *fds)
+{
+	nfds_t	n_fds;
+
+	n_fds = 0;
+	while (n-- > 0)
+	{
+		relays->slot[0] = -1;
+		relays->slot[1] = -1;
+		if (relays->in != -1 && relays->poll_in)
+		{
+			relays->slot[0] = n_fds;
+			fds[n_fds++] = (struct pollfd){.fd = relays->in, .events = POLLIN};
+		}
+		if (relays->in != -1 && relays->poll_out)
+		{
+			relays->slot[1] = n_fds;
+			fds[n_fds++] = (struct pollfd){.fd = relays->out,
+				.events = POLLOUT};
+		}
+		++relays;
+	}
+	return (n_fds);
+}
+
+/**
+ * @brief Tells whether a relay can make progress after poll().
+ *
+ * @param relay The relay to check.
+ * @param fds The poll set after poll() returned.
+ * @return 1 if every polled end is ready, -1 if the reader of out went away,
+ *         0 otherwise.
+ */
+static int	relay_state(t_relay *relay, struct pollfd *fds)
+{
+	if (relay->in == -1)
+		return (0);
+	if (relay->slot[1] != -1 && fds[relay->slot[1]].revents & POLLERR)
+		return (-1);
+	if (relay->slot[0] != -1 && !fds[relay->slot[0]].revents)
+		return (0);
+	if (relay->slot[1] != -1 && !fds[relay->slot[1]].revents)
+		return (0);
+	return (1);
+}
+
+/**
+ * @brief Moves one chunk of a ready relay, finishing it at EOF or on error.
+ *
+ * A relay streaming the heredoc moves it through heredoc_step() and finishes
+ * at the delimiter.
+ *
+ * @param relay The relay to pump.
+ */
+static void	relay_step(t_relay *relay)
+{
+	ssize_t	moved;
+
+	if (relay->heredoc)
+		moved = heredoc_step(relay->heredoc, relay->in, relay->out);
+	else if (relay->use_rw)
+		moved = relay_rw(relay);
+	else
+		moved = splice(relay->in, NULL, relay->out, NULL, relay_chunk(relay),
+				SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+	if (moved == -1 && errno == EINVAL && !relay->use_rw)
+		relay->use_rw = 1;
+	else if (moved > 0)
+		relay_moved(relay, moved);
+	else if (moved == 0 || errno != EAGAIN)
+	{
+		if (moved == -1 && errno != EPIPE)
+			perror("Error relaying data");
+		close_relay(relay);
+	}
+	if (relay->heredoc && relay->heredoc->done)
+		close_relay(relay);
+}
+
+/**
+ * @brief Pumps every relay that poll() reported as ready.
+ *
+ * @param relays Array of relays.
+ * @param n Number of relays.
+ * @param fds The poll set after poll() returned.
+ */
+static void	step_relays(t_relay *relays, size_t n, struct pollfd *fds)
+{
+	size_t	i;
+	int		state;
+
+	i = 0;
+	while (i < n)
+	{
+		state = relay_state(&relays[i], fds);
+		if (state == -1)
+			close_relay(&relays[i]);
+		else if (state == 1)
+			relay_step(&relays[i]);
+		++i;
+	}
+}
+
+void	run_relays(t_pinfo *pinfo)
+{
+	struct pollfd	*fds;
+	nfds_t			n_fds;
+	size_t			i;
+	t_arena_mark	mark;
+
+	clock_gettime(CLOCK_MONOTONIC, &pinfo->sampled_at);
+	mark = ft_arena_mark(pinfo->arena);
+	fds = ft_arena_alloc(pinfo->arena,
+			sizeof(struct pollfd) * pinfo->n_relays * 2);
+	n_fds = 0;
+	if (fds)
+		n_fds = set_poll_slots(pinfo->relays, pinfo->n_relays, fds);
+	while (n_fds > 0
+		&& (poll(fds, n_fds, relay_tick(pinfo)) != -1 || errno == EINTR))
+	{
+		step_relays(pinfo->relays, pinfo->n_relays, fds);
+		n_fds = set_poll_slots(pinfo->relays, pinfo->n_relays, fds);
+	}
+	if (!fds || n_fds > 0)
+		perror("Error pumping relays");
+	i = 0;
+	while (i < pinfo->n_relays)
+		close_relay(&pinfo->relays[i++]);
+	ft_arena_reset(pinfo->arena, mark);
+}
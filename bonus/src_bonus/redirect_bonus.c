@@ -0,0 +1,68 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   redirect_bonus.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 07:52:55 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 09:37:26 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+int	open_endpoint(t_pinfo *pinfo, char *argv[], char output)
+{
+	int	fd;
+
+	if (pinfo->shard)
+		return (pinfo->shard->fd[(int)output]);
+	if (output)
+		return (open_outfile(argv[pinfo->first + pinfo->n_stages],
+				pinfo->first == 3));
+	if (pinfo->heredoc_fd == -1)
+		return (open_infile(argv[1]));
+	fd = fcntl(pinfo->heredoc_fd, F_DUPFD_CLOEXEC, 0);
+	if (fd == -1)
+		perror("Error duplicating heredoc");
+	return (fd);
+}
+
+int	stage_endpoint(t_pinfo *pinfo, char *argv[], char output)
+{
+	if (pinfo->relay_ends[(int)output] != -1)
+		return (pinfo->relay_ends[(int)output]);
+	return (open_endpoint(pinfo, argv, output));
+}
+
+int	redirect_endpoint(t_pinfo *pinfo, char *argv[], char output)
+{
+	int	target;
+	int	fd;
+
+	fd = pinfo->relay_ends[(int)output];
+	if (fd == -1 && output)
+		return (set_outfile(argv[pinfo->first + pinfo->n_stages],
+				pinfo->first == 3));
+	if (fd == -1)
+		fd = pinfo->heredoc_fd;
+	if (fd == -1)
+		return (set_infile(argv[1]));
+	target = STDIN_FILENO;
+	if (output)
+		target = STDOUT_FILENO;
+	if (dup2(fd, target) == -1)
+		return (perror("Error duplicating file"), 1);
+	return (0);
+}
+
+void	close_relay_ends(t_pinfo *pinfo)
+{
+	if (pinfo->relay_ends[0] != -1 && close(pinfo->relay_ends[0]) == -1)
+		perror("Error closing relay");
+	if (pinfo->relay_ends[1] != -1 && close(pinfo->relay_ends[1]) == -1)
+		perror("Error closing relay");
+	pinfo->relay_ends[0] = -1;
+	pinfo->relay_ends[1] = -1;
+}
@@ -0,0 +1,101 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   relay_bonus.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 07:52:55 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 09:37:26 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+void	init_relay(t_relay *relay, int in, int out)
+{
+	ft_bzero(relay, sizeof(t_relay));
+	relay->in = in;
+	relay->out = out;
+	relay->slot[0] = -1;
+	relay->slot[1] = -1;
+	relay->left = SIZE_MAX;
+	if (in == -1 || out == -1)
+		close_relay(relay);
+}
+
+void	close_relay(t_relay *relay)
+{
+	if (relay->in != -1 && close(relay->in) == -1)
+		perror("Error closing relay");
+	if (relay->out != -1 && close(relay->out) == -1)
+		perror("Error closing relay");
+	relay->in = -1;
+	relay->out = -1;
+}
+
+/**
+ * @brief Sets an endpoint relay and the pipe it hands to an end command.
+ *
+ * The relay of the input also streams the heredoc if there is one.
+ *
+ * @param pinfo Pipeline information with the relays allocated.
+ * @param fd The input or the outfile, or -1 to leave the relay finished.
+ * @param output Non-zero for the outfile, zero for the input.
+ * @return 0 on success, 1 if the pipe could not be created.
+ */
+static int	set_endpoint_relay(t_pinfo *pinfo, int fd, char output)
+{
+	t_relay	*relay;
+	int		ends[2];
+
+	if (pipe2(ends, O_CLOEXEC) == -1)
+	{
+		if (fd != -1)
+			close(fd);
+		return (perror("Error creating pipe"), 1);
+	}
+	relay = &pinfo->relays[(int)output];
+	pinfo->relay_ends[(int)output] = ends[(int)output];
+	if (output)
+		init_relay(relay, ends[0], fd);
+	else
+		init_relay(relay, fd, ends[1]);
+	relay->poll_in = output || pinfo->heredoc;
+	relay->poll_out = !output;
+	if (!output)
+		relay->heredoc = pinfo->heredoc;
+	if (!output && pinfo->shard)
+		relay->left = pinfo->shard->len;
+	if (!output && fd != -1 && !pinfo->heredoc)
+		posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+	return (0);
+}
+
+int	set_relays(t_pinfo *pinfo, char *argv[])
+{
+	size_t	n;
+	int		in;
+
+	if (!pinfo->opts.splice && !pinfo->opts.instrument && !pinfo->heredoc)
+		return (0);
+	n = 2;
+	if (pinfo->opts.instrument)
+		n += pinfo->n_stages - 1;
+	pinfo->relays = ft_arena_calloc(pinfo->arena, n, sizeof(t_relay));
+	if (!pinfo->relays)
+		return (perror("Error allocating relays"), 1);
+	pinfo->n_relays = n;
+	while (n > 0)
+		init_relay(&pinfo->relays[--n], -1, -1);
+	in = STDIN_FILENO;
+	if (!pinfo->heredoc && pinfo->opts.splice)
+		in = open_endpoint(pinfo, argv, 0);
+	if ((pinfo->heredoc || pinfo->opts.splice)
+		&& set_endpoint_relay(pinfo, in, 0))
+		return (1);
+	if (pinfo->opts.splice
+		&& set_endpoint_relay(pinfo, open_endpoint(pinfo, argv, 1), 1))
+		return (1);
+	return (0);
+}
@@ -0,0 +1,53 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   relay_io_bonus.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 09:32:13 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 09:32:13 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+ssize_t	relay_rw(t_relay *relay)
+{
+	char	buffer[RELAY_CHUNK];
+	ssize_t	n;
+	ssize_t	written;
+	ssize_t	total;
+
+	n = read(relay->in, buffer, relay_chunk(relay));
+	relay->reads += n > 0;
+	total = 0;
+	while (n > 0 && total < n)
+	{
+		written = write(relay->out, buffer + total, n - total);
+		if (written == -1)
+			return (-1);
+		++relay->writes;
+		total += written;
+	}
+	return (n);
+}
+
+size_t	relay_chunk(t_relay *relay)
+{
+	if (relay->left < RELAY_CHUNK)
+		return (relay->left);
+	return (RELAY_CHUNK);
+}
+
+void	relay_moved(t_relay *relay, ssize_t moved)
+{
+	relay->bytes += moved;
+	relay->reads += !relay->use_rw;
+	relay->writes += !relay->use_rw;
+	if (relay->left == SIZE_MAX)
+		return ;
+	relay->left -= moved;
+	if (relay->left == 0)
+		close_relay(relay);
+}
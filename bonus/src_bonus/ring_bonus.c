@@ -0,0 +1,54 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ring_bonus.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 10:01:36 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 10:01:36 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+t_ring	*ring_new(t_arena *arena, size_t size)
+{
+	t_ring	*ring;
+
+	ring = ft_arena_calloc(arena, 1, sizeof(t_ring));
+	if (ring)
+		ring->data = ft_arena_alloc(arena, size);
+	if (!ring || !ring->data)
+		return (perror("Error allocating ring"), NULL);
+	ring->size = size;
+	return (ring);
+}
+
+int	ring_wait(t_ring *ring, int seq, _Atomic int *cancel)
+{
+	atomic_fetch_add(&ring->waiters, 1);
+	if (!atomic_load(cancel))
+		syscall(SYS_futex, &ring->seq, FUTEX_WAIT_PRIVATE, seq, NULL, NULL, 0);
+	atomic_fetch_sub(&ring->waiters, 1);
+	if (atomic_load(cancel))
+		return (errno = EINTR, -1);
+	return (0);
+}
+
+void	ring_wake(t_ring *ring)
+{
+	atomic_fetch_add(&ring->seq, 1);
+	if (atomic_load(&ring->waiters) > 0)
+		syscall(SYS_futex, &ring->seq, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL,
+			0);
+}
+
+void	ring_close(t_ring *ring, char producer)
+{
+	if (producer)
+		atomic_store(&ring->eof, 1);
+	else
+		atomic_store(&ring->gone, 1);
+	ring_wake(ring);
+}
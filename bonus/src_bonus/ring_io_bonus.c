@@ -0,0 +1,77 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ring_io_bonus.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 10:01:36 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 10:01:36 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+ssize_t	ring_write(t_ring *ring, const char *data, size_t len,
+		_Atomic int *cancel)
+{
+	size_t	head;
+	size_t	room;
+	size_t	off;
+	int		seq;
+
+	head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+	room = 0;
+	while (room == 0)
+	{
+		seq = atomic_load(&ring->seq);
+		if (atomic_load(&ring->gone))
+			return (errno = EPIPE, -1);
+		room = ring->size - (head - atomic_load(&ring->tail));
+		if (room == 0 && ring_wait(ring, seq, cancel))
+			return (-1);
+	}
+	off = head & (ring->size - 1);
+	if (room > ring->size - off)
+		room = ring->size - off;
+	if (room > len)
+		room = len;
+	ft_memcpy(ring->data + off, data, room);
+	atomic_store(&ring->head, head + room);
+	ring_wake(ring);
+	return (room);
+}
+
+ssize_t	ring_peek(t_ring *ring, char **data, _Atomic int *cancel)
+{
+	size_t	tail;
+	size_t	avail;
+	size_t	off;
+	int		seq;
+	char	eof;
+
+	tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+	avail = 0;
+	while (avail == 0)
+	{
+		seq = atomic_load(&ring->seq);
+		eof = atomic_load(&ring->eof);
+		avail = atomic_load(&ring->head) - tail;
+		if (avail == 0 && eof)
+			return (0);
+		if (avail == 0 && ring_wait(ring, seq, cancel))
+			return (-1);
+	}
+	off = tail & (ring->size - 1);
+	if (avail > ring->size - off)
+		avail = ring->size - off;
+	*data = ring->data + off;
+	return (avail);
+}
+
+void	ring_consume(t_ring *ring, size_t len)
+{
+	atomic_store(&ring->tail, atomic_load_explicit(&ring->tail,
+			memory_order_relaxed) + len);
+	ring_wake(ring);
+}
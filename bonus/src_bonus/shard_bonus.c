@@ -0,0 +1,148 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   shard_bonus.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 09:33:02 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 11:05:54 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+/**
+ * @brief Starts the clock of the run and opens the outfile for the first
+ *        range and an anonymous file for every other one.
+ *
+ * @param run The run, with its ranges cut.
+ * @param file Path of the outfile.
+ * @return The outfile, or -1 with every descriptor closed.
+ */
+static int	open_shards(t_shards *run, char *file)
+{
+	int		out;
+	size_t	i;
+
+	run->wall_ns = now_ns();
+	out = open_outfile(file, 0);
+	if (out == -1)
+		return (-1);
+	run->shards[0].fd[1] = out;
+	i = 1;
+	while (i < run->n)
+	{
+		run->shards[i].fd[1] = anon_file(SHARD_NAME);
+		if (run->shards[i].fd[1] == -1)
+		{
+			perror("Error creating shard file");
+			while (i > 0)
+				close(run->shards[i--].fd[1]);
+			return (close(out), -1);
+		}
+		++i;
+	}
+	return (out);
+}
+
+/**
+ * @brief Forks a worker that runs the pipeline over one range.
+ *
+ * The worker opens the infile at the start of the range and runs
+ * fork_loop() with splice relays, so the input relay stops at the end of
+ * the range. It keeps the stages planned by shard_loop(). Its own stats
+ * report is disabled.
+ *
+ * @param pinfo The template pinfo of the run.
+ * @param shard The range to pipe.
+ * @param argc Number of command line arguments.
+ * @param argv Array of command line arguments.
+ * @return 1 if the worker was started, 0 otherwise.
+ */
+static int	start_shard(t_pinfo *pinfo, t_shard *shard, int argc,
+		char *argv[])
+{
+	shard->start_ns = now_ns();
+	shard->pid = fork();
+	if (shard->pid == 0)
+	{
+		shard->fd[0] = open_infile(argv[1]);
+		if (shard->fd[0] != -1
+			&& lseek(shard->fd[0], shard->offset, SEEK_SET) == -1)
+			perror("Error seeking infile");
+		pinfo->shard = shard;
+		pinfo->opts.splice = 1;
+		pinfo->opts.stats = 0;
+		exit(fork_loop(pinfo, argc, argv));
+	}
+	if (shard->pid == -1)
+	{
+		shard->pid = 0;
+		shard->status = 1;
+		perror("Error forking shard");
+	}
+	return (shard->pid != 0);
+}
+
+/**
+ * @brief Waits for any worker and records the status, wall time and
+ *        resource usage of its range.
+ *
+ * @param run The run, with at least one worker running.
+ */
+static void	reap_shard(t_shards *run)
+{
+	struct rusage	usage;
+	t_shard			*shard;
+	pid_t			pid;
+	int				status;
+	size_t			i;
+
+	pid = wait4(-1, &status, 0, &usage);
+	if (pid == -1 && errno != EINTR)
+		run->running = 0;
+	i = 0;
+	while (pid > 0 && i < run->n && run->shards[i].pid != pid)
+		++i;
+	if (pid <= 0 || i == run->n)
+		return ;
+	shard = &run->shards[i];
+	shard->wall_ns = now_ns() - shard->start_ns;
+	run->busy_ns += shard->wall_ns;
+	shard->usage = usage;
+	shard->status = WEXITSTATUS(status);
+	if (WIFSIGNALED(status))
+		shard->status = 128 + WTERMSIG(status);
+	shard->pid = 0;
+	--run->running;
+}
+
+int	shard_loop(t_pinfo *pinfo, int argc, char *argv[])
+{
+	t_shards	run;
+	size_t		i;
+	int			out;
+
+	ft_bzero(&run, sizeof(t_shards));
+	if (ft_strncmp(argv[1], "here_doc", 9) == 0
+		|| split_infile(&run, argv[1], pinfo->opts.shards))
+		return (fork_loop(pinfo, argc, argv));
+	out = set_stages(pinfo, argc, argv);
+	if (out)
+		return (clean_pinfo(pinfo), out);
+	out = open_shards(&run, argv[argc - 1]);
+	if (out == -1)
+		return (clean_pinfo(pinfo), 1);
+	i = 0;
+	while (i < run.n)
+		run.running += start_shard(pinfo, &run.shards[i++], argc, argv);
+	while (run.running > 0)
+		reap_shard(&run);
+	concat_shards(&run, out);
+	run.wall_ns = now_ns() - run.wall_ns;
+	if (pinfo->opts.stats)
+		report_shards(&run);
+	clean_pinfo(pinfo);
+	return (shard_status(&run));
+}
@@ -0,0 +1,127 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   shard_output_bonus.c                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 09:33:02 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 11:05:55 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+/**
+ * @brief Appends the output of one range to the outfile.
+ *
+ * The data is moved with sendfile(2), falling back to read(2)/write(2) for
+ * an outfile that does not support it.
+ *
+ * @param shard The range, holding its output in fd[1].
+ * @param out The outfile.
+ */
+static void	copy_shard(t_shard *shard, int out)
+{
+	t_relay	relay;
+	ssize_t	n;
+
+	init_relay(&relay, shard->fd[1], out);
+	n = 1;
+	if (lseek(shard->fd[1], 0, SEEK_SET) == -1)
+		n = -1;
+	while (n > 0 && !relay.use_rw)
+	{
+		n = sendfile(out, shard->fd[1], NULL, SHARD_COPY);
+		if (n == -1 && errno == EINVAL)
+		{
+			relay.use_rw = 1;
+			n = 1;
+		}
+	}
+	while (n > 0)
+		n = relay_rw(&relay);
+	if (n == -1)
+		perror("Error writing shard output");
+}
+
+void	concat_shards(t_shards *run, int out)
+{
+	size_t	i;
+
+	i = 1;
+	while (i < run->n)
+	{
+		copy_shard(&run->shards[i], out);
+		close(run->shards[i++].fd[1]);
+	}
+	close(out);
+}
+
+/**
+ * @brief Writes the JSON object describing one range.
+ *
+ * @param out Output buffer of the report.
+ * @param shard The range to report.
+ * @param index Position of the range in the infile, from 0.
+ */
+static void	report_range(t_outbuf *out, t_shard *shard, long index)
+{
+	if (index > 0)
+		json_put(out, ",");
+	json_put(out, "{");
+	json_key_num(out, "shard", index);
+	json_put(out, ",");
+	json_key_num(out, "offset", shard->offset);
+	json_put(out, ",");
+	json_key_num(out, "bytes", shard->len);
+	json_put(out, ",");
+	json_key_num(out, "status", shard->status);
+	json_put(out, ",");
+	json_key_num(out, "wall_ns", shard->wall_ns);
+	json_put(out, ",");
+	json_key_rusage(out, &shard->usage);
+	json_put(out, "}");
+}
+
+void	report_shards(t_shards *run)
+{
+	char		buf[REPORT_BUF];
+	char		speedup[32];
+	t_outbuf	out;
+	long		x100;
+	size_t		i;
+
+	x100 = run->busy_ns / (run->wall_ns / 100 + 1);
+	ft_snprintf(speedup, sizeof(speedup), ",\"speedup\":%d.%d%d",
+		(int)(x100 / 100), (int)(x100 / 10 % 10), (int)(x100 % 10));
+	ft_outbuf_init(&out, STDERR_FILENO, buf, sizeof(buf));
+	json_put(&out, "{\"shards\":{");
+	json_key_num(&out, "count", run->n);
+	json_put(&out, ",");
+	json_key_num(&out, "wall_ns", run->wall_ns);
+	json_put(&out, speedup);
+	json_put(&out, "},\"ranges\":[");
+	i = 0;
+	while (i < run->n)
+	{
+		report_range(&out, &run->shards[i], i);
+		++i;
+	}
+	json_put(&out, "]}\n");
+	ft_outbuf_flush(&out);
+}
+
+int	shard_status(t_shards *run)
+{
+	size_t	i;
+
+	i = 0;
+	while (i < run->n)
+	{
+		if (run->shards[i].status != 0)
+			return (run->shards[i].status);
+		++i;
+	}
+	return (0);
+}
@@ -0,0 +1,75 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   shard_split_bonus.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 09:33:02 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 09:33:02 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+/**
+ * @brief Cuts a mapped infile into at most k ranges, each one ending at the
+ *        first newline after a multiple of size / k.
+ *
+ * Ranges that would be empty, because a line spans several cut points, are
+ * skipped.
+ *
+ * @param run The run to fill.
+ * @param map The mapped infile.
+ * @param size Size of the infile, more than 0.
+ * @param k Number of ranges wanted, from 2 to SHARD_MAX.
+ */
+static void	cut_ranges(t_shards *run, const char *map, size_t size, long k)
+{
+	size_t	start;
+	size_t	end;
+	char	*nl;
+	long	i;
+
+	start = 0;
+	i = 0;
+	while (++i <= k && start < size)
+	{
+		end = size * i / k;
+		if (i < k && end > start)
+		{
+			nl = ft_memchr(map + end - 1, '\n', size - end + 1);
+			end = size;
+			if (nl)
+				end = nl - map + 1;
+		}
+		if (end > start)
+		{
+			run->shards[run->n].offset = start;
+			run->shards[run->n++].len = end - start;
+			start = end;
+		}
+	}
+}
+
+int	split_infile(t_shards *run, char *file, long k)
+{
+	struct stat	st;
+	char		*map;
+	int			fd;
+
+	if (k > SHARD_MAX)
+		k = SHARD_MAX;
+	fd = open(file, O_RDONLY | O_CLOEXEC);
+	if (fd == -1)
+		return (1);
+	map = MAP_FAILED;
+	if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+		map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED)
+		return (1);
+	cut_ranges(run, map, st.st_size, k);
+	munmap(map, st.st_size);
+	return (run->n < 2);
+}
@@ -0,0 +1,126 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   spawn_bonus.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 07:48:22 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 08:57:16 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+/**
+ * @brief Picks the descriptors that will become the standard input and output
+ *        of the stage, opening the endpoint file for the first and last one
+ *        or taking the relay pipe ends, see stage_endpoint().
+ *
+ * The pipe ends come from pinfo->pipes, see open_stage_pipe().
+ *
+ * @param pinfo Pipeline information. pinfo->i is the argv index of the
+ *              command to launch.
+ * @param argv Array of command line arguments
+ * @param fds Filled with [stdin_fd, stdout_fd] for the stage. Endpoint files
+ *            that fail to open are left as -1.
+ *
+ * @return 0 on success, 1 if an endpoint file could not be opened.
+ */
+static int	set_stage_fds(t_pinfo *pinfo, char *argv[], int *fds)
+{
+	fds[0] = pinfo->pipes[0];
+	fds[1] = pinfo->pipes[1];
+	if (pinfo->i == pinfo->first)
+		fds[0] = stage_endpoint(pinfo, argv, 0);
+	if (fds[0] == -1)
+		return (1);
+	if (argv[pinfo->i + 2] == NULL)
+		fds[1] = stage_endpoint(pinfo, argv, 1);
+	return (fds[1] == -1);
+}
+
+/**
+ * @brief Closes the endpoint files opened by set_stage_fds(), if any. Relay
+ *        pipe ends belong to pinfo and are left open.
+ *
+ * @param pinfo Pipeline information. pinfo->i is the argv index of the
+ *              command being launched.
+ * @param argv Array of command line arguments
+ * @param fds The [stdin_fd, stdout_fd] pair of the stage.
+ */
+static void	close_endpoints(t_pinfo *pinfo, char *argv[], int *fds)
+{
+	if (pinfo->i == pinfo->first && fds[0] != -1
+		&& fds[0] != pinfo->relay_ends[0] && close(fds[0]) == -1)
+		perror("Error closing file");
+	if (argv[pinfo->i + 2] == NULL && fds[1] != -1
+		&& fds[1] != pinfo->relay_ends[1] && close(fds[1]) == -1)
+		perror("Error closing file");
+}
+
+/**
+ * @brief Expresses the dup2() wiring of a forked child as spawn file
+ *        actions.
+ *
+ * Endpoint files and pipes are all close-on-exec, so two dup2() actions are
+ * the whole fd plan of the child, whatever the length of the pipeline.
+ *
+ * @param actions The file actions object to initialize.
+ * @param fds The [stdin_fd, stdout_fd] pair of the stage.
+ *
+ * @return 0 on success, 1 on failure. On failure actions is left destroyed.
+ */
+static int	set_file_actions(posix_spawn_file_actions_t *actions, int *fds)
+{
+	int	err;
+
+	if (posix_spawn_file_actions_init(actions))
+		return (1);
+	err = posix_spawn_file_actions_adddup2(actions, fds[0], STDIN_FILENO);
+	if (!err)
+		err = posix_spawn_file_actions_adddup2(actions, fds[1], STDOUT_FILENO);
+	if (err)
+		posix_spawn_file_actions_destroy(actions);
+	return (err != 0);
+}
+
+/**
+ * @brief Spawns the planned command of a stage with its file actions.
+ *
+ * @param stage The stage to spawn, resolved by plan_stages().
+ * @param fds The [stdin_fd, stdout_fd] pair of the stage.
+ *
+ * @return The PID of the new process, or -1 with an error message printed.
+ */
+static pid_t	spawn_cmd(t_stage *stage, int *fds)
+{
+	extern char					**environ;
+	posix_spawn_file_actions_t	actions;
+	pid_t						pid;
+	int							err;
+
+	if (set_file_actions(&actions, fds))
+		return (perror("Error preparing spawn"), -1);
+	err = posix_spawn(&pid, stage->path, &actions, NULL, stage->args,
+			environ);
+	posix_spawn_file_actions_destroy(&actions);
+	if (err)
+		return (ft_perror("Error executing command", err, 0), -1);
+	return (pid);
+}
+
+pid_t	handle_spawn(t_pinfo *pinfo, char *argv[])
+{
+	t_stage	*stage;
+	int		fds[2];
+	pid_t	pid;
+
+	stage = &pinfo->stages[pinfo->i - pinfo->first];
+	stage->status = EXIT_FAILURE;
+	if (set_stage_fds(pinfo, argv, fds))
+		return (close_endpoints(pinfo, argv, fds), -1);
+	pid = spawn_cmd(stage, fds);
+	close_endpoints(pinfo, argv, fds);
+	return (pid);
+}
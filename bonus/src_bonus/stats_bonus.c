@@ -0,0 +1,143 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   stats_bonus.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 07:48:22 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 10:11:33 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+/**
+ * @brief Writes the JSON object describing one stage, preceded by a comma
+ *        unless it is the first one.
+ *
+ * @param out Output buffer of the report.
+ * @param stage The stage to report.
+ * @param index Position of the stage in the pipeline, from 0.
+ * @param cmd Command string of the stage as given on the command line.
+ */
+static void	report_stage(t_outbuf *out, t_stage *stage, long index, char *cmd)
+{
+	if (index > 0)
+		json_put(out, ",");
+	json_put(out, "{");
+	json_key_num(out, "index", index);
+	json_put(out, ",");
+	json_key_str(out, "cmd", cmd);
+	json_put(out, ",");
+	json_key_num(out, "pid", stage->pid);
+	json_put(out, ",");
+	json_key_num(out, "builtin", stage->builtin != NULL);
+	json_put(out, ",");
+	json_key_num(out, "status", stage->status);
+	json_put(out, ",");
+	json_key_num(out, "launch_ns", stage->launch_ns);
+	json_put(out, ",");
+	json_key_num(out, "signals_sent", stage->signals);
+	json_put(out, ",");
+	json_key_rusage(out, &stage->usage);
+	json_put(out, "}");
+}
+
+/**
+ * @brief Writes the JSON object describing one endpoint relay.
+ *
+ * @param out Output buffer of the report.
+ * @param relay The relay to report.
+ * @param name Name of the endpoint the relay serves.
+ * @param sep Separator written before the object.
+ */
+static void	report_endpoint(t_outbuf *out, t_relay *relay, char *name,
+		char *sep)
+{
+	json_put(out, sep);
+	json_put(out, "{");
+	json_key_str(out, "endpoint", name);
+	json_put(out, ",");
+	json_relay_traffic(out, relay);
+	json_put(out, "}");
+}
+
+/**
+ * @brief Writes the JSON array of the capacity of every link, along with its
+ *        traffic if instrumented, closing the previous array first.
+ *
+ * @param out Output buffer of the report.
+ * @param pinfo Pipeline information with at least one link set.
+ */
+static void	report_links(t_outbuf *out, t_pinfo *pinfo)
+{
+	size_t	i;
+
+	json_put(out, "],\"links\":[{");
+	i = 0;
+	while (i < pinfo->n_links)
+	{
+		json_key_num(out, "index", i);
+		json_put(out, ",");
+		json_key_num(out, "size", pinfo->links[i].size);
+		json_put(out, ",");
+		json_key_num(out, "auto", pinfo->links[i].autosize);
+		json_put(out, ",");
+		json_key_num(out, "grows", pinfo->links[i].grows);
+		if (pinfo->opts.instrument)
+		{
+			json_put(out, ",");
+			json_relay_traffic(out, &pinfo->relays[2 + i]);
+		}
+		if (++i < pinfo->n_links)
+			json_put(out, "},{");
+	}
+	json_put(out, "}");
+}
+
+/**
+ * @brief Writes the whole JSON run report.
+ *
+ * @param out Output buffer of the report.
+ * @param pinfo Pipeline information after every stage has been waited for.
+ * @param argv Array of command line arguments.
+ */
+static void	report_run(t_outbuf *out, t_pinfo *pinfo, char *argv[])
+{
+	size_t	i;
+
+	json_put(out, "{");
+	if (pinfo->opts.launch == LAUNCH_SPAWN)
+		json_key_str(out, "launch", "spawn");
+	else
+		json_key_str(out, "launch", "fork");
+	json_put(out, ",");
+	json_key_arena(out, pinfo->arena);
+	report_pipefail(out, pinfo);
+	json_put(out, ",\"stages\":[");
+	i = 0;
+	while (i < pinfo->n_stages)
+	{
+		report_stage(out, &pinfo->stages[i], i, argv[pinfo->first + i]);
+		++i;
+	}
+	if (pinfo->opts.splice)
+	{
+		report_endpoint(out, &pinfo->relays[0], "infile", "],\"relays\":[");
+		report_endpoint(out, &pinfo->relays[1], "outfile", ",");
+	}
+	if (pinfo->n_links > 0)
+		report_links(out, pinfo);
+	json_put(out, "]}\n");
+}
+
+void	report_stats(t_pinfo *pinfo, char *argv[])
+{
+	char		buf[REPORT_BUF];
+	t_outbuf	out;
+
+	ft_outbuf_init(&out, STDERR_FILENO, buf, sizeof(buf));
+	report_run(&out, pinfo, argv);
+	ft_outbuf_flush(&out);
+}
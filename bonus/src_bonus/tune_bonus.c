@@ -0,0 +1,85 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   tune_bonus.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 08:00:18 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 10:11:34 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex_bonus.h"
+
+/**
+ * @brief Tells whether a stage has exited, without reaping it.
+ *
+ * @param stage The stage.
+ * @return 1 if the stage is gone, 0 if it is still running.
+ */
+static int	stage_exited(t_stage *stage)
+{
+	siginfo_t	info;
+
+	if (stage->pid == -1 || stage->reaped)
+		return (1);
+	if (stage->builtin)
+		return (atomic_load(&stage->builtin->done));
+	info.si_pid = 0;
+	if (waitid(P_PID, stage->pid, &info, WEXITED | WNOHANG | WNOWAIT) == -1)
+		return (1);
+	return (info.si_pid != 0);
+}
+
+/**
+ * @brief Samples the fill level of an auto-tuned link and doubles its
+ *        capacity once it has been found full PIPE_TUNE_STREAK times in a
+ *        row.
+ *
+ * @param link The link to sample.
+ */
+static void	tune_link(t_link *link)
+{
+	int	avail;
+	int	size;
+
+	if (ioctl(link->rd, FIONREAD, &avail) == -1)
+		return ;
+	if (avail + PIPE_BUF < link->size)
+		link->streak = 0;
+	else if (++link->streak >= PIPE_TUNE_STREAK && link->size < link->max)
+	{
+		link->streak = 0;
+		size = link->size;
+		resize_link(link, link->rd, (long)size * 2);
+		link->grows += link->size > size;
+	}
+}
+
+int	tune_links(t_pinfo *pinfo)
+{
+	size_t	i;
+	int		active;
+	char	due;
+
+	due = elapsed_ns(&pinfo->tuned_at) >= PIPE_TUNE_MS * 1000000L;
+	if (due)
+		clock_gettime(CLOCK_MONOTONIC, &pinfo->tuned_at);
+	active = 0;
+	i = 0;
+	while (i < pinfo->n_links)
+	{
+		if (due && pinfo->links[i].rd != -1
+			&& stage_exited(&pinfo->stages[i + 1]))
+			close_link(&pinfo->links[i]);
+		if (pinfo->links[i].rd != -1)
+		{
+			++active;
+			if (due)
+				tune_link(&pinfo->links[i]);
+		}
+		++i;
+	}
+	return (active);
+}
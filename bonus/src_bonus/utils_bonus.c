@@ -6,84 +6,78 @@
 /*   By: pablo <pablo@student.42.fr>                +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/04/05 18:29:14 by pablo             #+#    #+#             */
-/*   Updated: 2025/05/22 22:18:11 by pablo            ###   ########.fr       */
+/*   Updated: 2026/10/17 10:58:08 by pabmart2         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "pipex_bonus.h"
 
-void	clean_pipes(int **pipes)
+void	clean_pipes(t_pinfo *pinfo)
 {
 	size_t	i;
 	char	status;
 
 	i = 0;
 	status = 0;
-	while (pipes[i])
+	while (i < 3)
 	{
-		if (close(pipes[i][0]) == -1)
+		if (pinfo->pipes[i] != -1 && close(pinfo->pipes[i]) == -1)
 			status = 1;
-		if (close(pipes[i][1]) == -1)
-			status = 1;
-		ft_free((void **)&pipes[i]);
-		++i;
+		pinfo->pipes[i++] = -1;
 	}
-	ft_free((void **)&pipes[i]);
-	ft_free((void **)&pipes);
 	if (status)
 		ft_perror("Fatal error closing pipes", 0, 0);
 }
 
-int	create_pipes(int **pipes, size_t n_pipes)
+int	open_stage_pipe(t_pinfo *pinfo)
 {
-	size_t	i;
+	size_t	index;
+	int		fds[2];
 
-	i = 0;
-	while (i < n_pipes)
-	{
-		pipes[i] = malloc(sizeof(int) * 2);
-		if (!pipes[i])
-		{
-			perror("Error allocating pipe");
-			clean_pipes(pipes);
-			return (1);
-		}
-		if (pipe(pipes[i]) == -1)
-		{
-			perror("Error creating pipe");
-			clean_pipes(pipes);
-			return (1);
-		}
-		++i;
-	}
+	index = pinfo->i - pinfo->first;
+	if (index + 1 >= pinfo->n_stages
+		|| (pinfo->stages[index].builtin && pinfo->stages[index + 1].builtin))
+		return (0);
+	if (pipe2(fds, O_CLOEXEC) == -1)
+		return (perror("Error creating pipe"), 1);
+	pinfo->pipes[1] = fds[1];
+	pinfo->pipes[2] = fds[0];
+	if (pinfo->n_links > 0)
+		open_link(pinfo, index, pinfo->pipes[2]);
+	if (pinfo->opts.instrument
+		&& probe_link(pinfo, index, &pinfo->pipes[2]))
+		return (1);
 	return (0);
 }
 
-int	wait_childs(pid_t last_pid, t_pinfo *pinfo)
+void	roll_pipes(t_pinfo *pinfo)
 {
-	pid_t	pid;
-	int		status;
-	int		exit_status;
+	if (pinfo->pipes[0] != -1 && close(pinfo->pipes[0]) == -1)
+		perror("Error closing pipe");
+	if (pinfo->pipes[1] != -1 && close(pinfo->pipes[1]) == -1)
+		perror("Error closing pipe");
+	pinfo->pipes[0] = pinfo->pipes[2];
+	pinfo->pipes[1] = -1;
+	pinfo->pipes[2] = -1;
+}
 
-	clean_pipes(pinfo->pipes);
-	pinfo->pipes = NULL;
-	exit_status = 0;
-	pid = waitpid(-1, &status, 0);
-	while (pid > 0)
-	{
-		if (pid == last_pid)
-		{
-			if (WIFEXITED(status))
-				exit_status = WEXITSTATUS(status);
-			else if (WIFSIGNALED(status))
-				exit_status = WEXITSTATUS(status);
-		}
-		pid = waitpid(-1, &status, 0);
-	}
-	if (pid == -1 && errno != ECHILD)
-		perror("Error al esperar a los procesos hijos");
-	if (pinfo->heredoc_tmp_file)
-		remove_heredoc_tmp_file(pinfo->heredoc_tmp_file);
-	clean_pinfo(pinfo);
-	return (exit_status);
+void	set_stage_status(t_pinfo *pinfo, size_t index, int status,
+		struct rusage *usage)
+{
+	t_stage	*stage;
+
+	stage = &pinfo->stages[index];
+	stage->usage = *usage;
+	if (WIFEXITED(status))
+		stage->status = WEXITSTATUS(status);
+	else if (WIFSIGNALED(status))
+		stage->status = 128 + WTERMSIG(status);
+	stage->reaped = 1;
+	stage->deadline_ns = 0;
+	if (stage->pidfd != -1)
+		close(stage->pidfd);
+	stage->pidfd = -1;
+	if (index > 0 && index <= pinfo->n_links)
+		close_link(&pinfo->links[index - 1]);
+	check_pipefail(pinfo, index);
 }
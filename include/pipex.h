@@ -6,96 +6,1239 @@
 /*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/03/21 13:33:49 by pablo             #+#    #+#             */
-/*   Updated: 2025/05/26 19:28:59 by pabmart2         ###   ########.fr       */
+/*   Updated: 2026/10/17 10:58:08 by pabmart2         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #ifndef PIPEX_H
 # define PIPEX_H
+# ifndef _GNU_SOURCE
+#  define _GNU_SOURCE
+# endif
 # include "libft.h"
 # include <fcntl.h>
+# include <limits.h>
+# include <poll.h>
+# include <signal.h>
+# include <spawn.h>
+# include <stddef.h>
+# include <sys/epoll.h>
+# include <sys/file.h>
+# include <sys/ioctl.h>
+# include <sys/mman.h>
+# include <sys/resource.h>
+# include <sys/stat.h>
+# include <sys/syscall.h>
 # include <sys/types.h>
 # include <sys/wait.h>
+# include <time.h>
 # include <unistd.h>
 
+# define LAUNCH_FORK 0
+# define LAUNCH_SPAWN 1
+# define RELAY_CHUNK 65536
+# define PIPE_MAX_FILE "/proc/sys/fs/pipe-max-size"
+# define PIPE_MAX_DEFAULT 1048576
+# define PIPE_TUNE_MS 1
+# define PIPE_TUNE_STREAK 4
+# define RELAY_SAMPLE_MS 1
+# define TIMEOUT_GRACE_MS 2000
+# define SUPERVISE_POLL_MS 10
+# define CMD_CACHE_FILE "/dev/shm/pipex-cmd-cache-%u"
+# define CMD_CACHE_MAGIC 0x50584301
+# define CMD_CACHE_SLOTS 256
+# define CMD_CACHE_NAME 64
+# define CMD_CACHE_PATH 256
+# define CMD_CACHE_DIRS 32
+# define CMD_CACHE_FNV 14695981039346656037UL
+# define PATH_INDEX_STAGES 64
+# define PATH_INDEX_SLOTS 1024
+# define PATH_INDEX_POOL 16384
+# define PATH_INDEX_DIRENT 32768
+# define REPORT_BUF 8192
+
+/**
+ * @struct s_pipex_opts
+ * @brief Runtime options read from the environment at startup.
+ *
+ * @param launch
+ * Backend used to start each stage: LAUNCH_FORK (default) or LAUNCH_SPAWN,
+ * selected with PIPEX_LAUNCH=fork|spawn.
+ *
+ * @param stats
+ * Non-zero when PIPEX_STATS is set (and not "0"). A JSON report is written
+ * to stderr at exit.
+ *
+ * @param splice
+ * Non-zero when PIPEX_SPLICE is set (and not "0"). The parent owns the
+ * infile and outfile and moves their data with splice(2), see t_relay.
+ *
+ * @param instrument
+ * Non-zero when PIPEX_INSTRUMENT is set (and not "0"). Every link between
+ * stages is pumped by the parent so its traffic can be measured, see
+ * t_relay.
+ *
+ * @param pipefail
+ * Non-zero when PIPEX_PIPEFAIL is set (and not "0"). The first stage to
+ * fail tears down every stage upstream of it and gives the exit status, see
+ * check_pipefail().
+ *
+ * @param pipe_size
+ * Value of PIPEX_PIPE_SIZE, or NULL if unset. It is a comma separated list of
+ * capacities, one per link, see pipe_size_opt().
+ *
+ * @param timeout_ms
+ * Wall-clock limit of the whole pipeline from PIPEX_TIMEOUT, in
+ * milliseconds, or 0 if unset. See duration_opt().
+ *
+ * @param stage_timeout
+ * Value of PIPEX_STAGE_TIMEOUT, or NULL if unset. It is a comma separated
+ * list of wall-clock limits, one per stage, see duration_opt().
+ *
+ * @param path_index
+ * Minimum number of stages for which the PATH index is built, from
+ * PIPEX_PATH_INDEX, or PATH_INDEX_STAGES if unset. 0 never builds it. See
+ * path_index_build().
+ */
+typedef struct s_pipex_opts
+{
+	char	launch;
+	char	stats;
+	char	splice;
+	char	instrument;
+	char	pipefail;
+	char	*pipe_size;
+	long	timeout_ms;
+	char	*stage_timeout;
+	int		path_index;
+}			t_popts;
+
+/**
+ * @struct s_relay
+ * @brief A data path between two descriptors pumped by the parent.
+ *
+ * @param in
+ * Descriptor data is read from, or -1 once the relay is finished.
+ *
+ * @param out
+ * Descriptor data is written to, or -1 once the relay is finished.
+ *
+ * @param poll_in
+ * Non-zero if in is a pipe that must be polled for POLLIN.
+ *
+ * @param poll_out
+ * Non-zero if out is a pipe that must be polled for POLLOUT.
+ *
+ * @param use_rw
+ * Set when splice(2) is not supported by one of the ends, so data is copied
+ * with read(2)/write(2) instead.
+ *
+ * @param slot
+ * Indexes of in and out in the current poll set, or -1.
+ *
+ * @param bytes
+ * Bytes moved so far.
+ *
+ * @param reads
+ * Successful reads from in so far. A splice(2) counts as a read and a write.
+ *
+ * @param writes
+ * Successful writes to out so far.
+ *
+ * @param blocked
+ * Non-zero if in was a full pipe at the last sample, meaning its writer is
+ * blocked.
+ *
+ * @param waiting
+ * Non-zero if out was an empty pipe at the last sample, meaning its reader
+ * is waiting for data.
+ *
+ * @param blocked_ns
+ * Time in was found full, in nanoseconds. Only sampled with PIPEX_INSTRUMENT.
+ *
+ * @param wait_ns
+ * Time out was found empty, in nanoseconds. Only sampled with
+ * PIPEX_INSTRUMENT.
+ */
+typedef struct s_relay
+{
+	int		in;
+	int		out;
+	char	poll_in;
+	char	poll_out;
+	char	use_rw;
+	int		slot[2];
+	size_t	bytes;
+	size_t	reads;
+	size_t	writes;
+	char	blocked;
+	char	waiting;
+	long	blocked_ns;
+	long	wait_ns;
+}			t_relay;
+
+/**
+ * @struct s_link
+ * @brief Capacity bookkeeping of a pipe between two stages.
+ *
+ * @param rd
+ * Parent copy of the read end, kept while the link is auto-tuned so its fill
+ * level can be sampled. It is -1 otherwise, and is closed as soon as the
+ * reading stage has exited so the writer still gets SIGPIPE.
+ *
+ * @param size
+ * Current capacity of the pipe in bytes.
+ *
+ * @param max
+ * Largest capacity the link may be given, from PIPE_MAX_FILE.
+ *
+ * @param autosize
+ * Non-zero if the capacity is auto-tuned.
+ *
+ * @param streak
+ * Consecutive samples that found the pipe full.
+ *
+ * @param grows
+ * Times the capacity has been doubled by the auto mode.
+ */
+typedef struct s_link
+{
+	int		rd;
+	int		size;
+	int		max;
+	char	autosize;
+	int		streak;
+	int		grows;
+}			t_link;
+
+/**
+ * @struct s_stage
+ * @brief Per-stage bookkeeping kept by the parent.
+ *
+ * @param pid
+ * PID of the stage, or -1 if it could not be launched.
+ *
+ * @param status
+ * Exit status of the stage once it has been waited for, 128 plus the signal
+ * number if it was killed, or the status it would have exited with if it
+ * could not be launched.
+ *
+ * @param launch_ns
+ * Wall-clock time the parent spent inside fork() or posix_spawn() for this
+ * stage, in nanoseconds.
+ *
+ * @param usage
+ * Resources used by the stage, as returned by wait4() when it was reaped.
+ * It is all zeros if the stage could not be launched.
+ *
+ * @param pidfd
+ * Process file descriptor of the stage from pidfd_open(2), watched by
+ * wait_childs(). It is -1 once the stage is reaped, or if the kernel does
+ * not support it.
+ *
+ * @param deadline_ns
+ * CLOCK_MONOTONIC time, in nanoseconds, at which the stage is signalled
+ * next, or 0 if it has no deadline. See check_deadlines().
+ *
+ * @param signals
+ * Number of signals sent because of a deadline or a pipefail teardown: 1
+ * after SIGTERM, 2 after SIGKILL. See signal_stage().
+ *
+ * @param reaped
+ * Non-zero once the stage has been waited for.
+ *
+ * @param path
+ * Executable of the stage, resolved by plan_stages() before any stage is
+ * launched.
+ *
+ * @param args
+ * NULL-terminated argument vector of the stage, split by plan_stages() with
+ * split_args(). Both live in the run arena, see t_pinfo.
+ */
+typedef struct s_stage
+{
+	pid_t			pid;
+	int				status;
+	long			launch_ns;
+	struct rusage	usage;
+	int				pidfd;
+	long			deadline_ns;
+	char			signals;
+	char			reaped;
+	char			*path;
+	char			**args;
+}					t_stage;
+
+/**
+ * @struct s_cmd_entry
+ * @brief A command resolved through PATH, as stored in the command cache.
+ *
+ * @param seq
+ * Seqlock of the entry. It is odd while a writer is updating it.
+ *
+ * @param path_hash
+ * Hash of the PATH string the command was resolved with.
+ *
+ * @param name
+ * Name of the command with a leading '/', as joined to the PATH entries.
+ *
+ * @param path
+ * Absolute path the command was resolved to.
+ *
+ * @param dir
+ * Index of the PATH directory holding the command.
+ *
+ * @param mtimes
+ * Modification time of every PATH directory up to dir, taken before they
+ * were searched.
+ */
+typedef struct s_cmd_entry
+{
+	unsigned int	seq;
+	unsigned long	path_hash;
+	char			name[CMD_CACHE_NAME];
+	char			path[CMD_CACHE_PATH];
+	int				dir;
+	struct timespec	mtimes[CMD_CACHE_DIRS];
+}					t_cmd_entry;
+
+/**
+ * @struct s_cmd_file
+ * @brief Layout of the command cache file.
+ *
+ * @param magic
+ * CMD_CACHE_MAGIC once the file has been laid out.
+ *
+ * @param entries
+ * Direct-mapped table of entries, indexed by the hash of the command name
+ * and PATH.
+ */
+typedef struct s_cmd_file
+{
+	unsigned int	magic;
+	t_cmd_entry		entries[CMD_CACHE_SLOTS];
+}					t_cmd_file;
+
+/**
+ * @struct s_cmd_cache
+ * @brief Handle of the command cache of a pipex instance.
+ *
+ * @param map
+ * Shared mapping of the cache file.
+ *
+ * @param fd
+ * The cache file, locked with flock(2) while an entry is written.
+ *
+ * @param state
+ * 0 until the cache is opened, 1 once mapped, -1 if it is disabled.
+ */
+typedef struct s_cmd_cache
+{
+	t_cmd_file	*map;
+	int			fd;
+	char		state;
+}				t_cmd_cache;
+
+/**
+ * @struct s_dirent64
+ * @brief Directory entry as returned by getdents64(2).
+ *
+ * @param d_ino
+ * Inode number.
+ *
+ * @param d_off
+ * Offset of the next entry, opaque.
+ *
+ * @param d_reclen
+ * Size of this entry, including its name and padding.
+ *
+ * @param d_type
+ * File type, DT_UNKNOWN on filesystems that do not report it.
+ *
+ * @param d_name
+ * NUL-terminated name of the entry.
+ */
+typedef struct s_dirent64
+{
+	unsigned long	d_ino;
+	long			d_off;
+	unsigned short	d_reclen;
+	unsigned char	d_type;
+	char			d_name[];
+}					t_dirent64;
+
+/**
+ * @struct s_path_slot
+ * @brief A name of the PATH index.
+ *
+ * @param hash
+ * Hash of the name, see fnv_hash().
+ *
+ * @param name
+ * Offset of the name in the string pool plus one, or 0 if the slot is free.
+ *
+ * @param dir
+ * Index in PATH of the first directory that has an entry with this name.
+ */
+typedef struct s_path_slot
+{
+	unsigned long	hash;
+	size_t			name;
+	size_t			dir;
+}					t_path_slot;
+
 /**
- * @brief Closes both ends of a pipe and frees the associated memory
+ * @struct s_path_index
+ * @brief In-memory index of every name found in the PATH directories.
+ *
+ * @param slots
+ * Open addressing hash table, kept at most half full.
+ *
+ * @param mask
+ * Number of slots minus one. The number of slots is a power of two.
+ *
+ * @param used
+ * Number of names in the table.
+ *
+ * @param pool
+ * Every name, NUL-terminated, one after the other.
+ *
+ * @param pool_len
+ * Bytes of the pool in use.
  *
- * This function closes both file descriptors in a pipe array and then frees
- * the memory allocated for the pipe. If any close operation fails, an error
+ * @param pool_cap
+ * Bytes allocated for the pool.
+ *
+ * @param n_dirs
+ * Number of PATH directories indexed.
+ *
+ * @param state
+ * 1 once every directory is indexed, 0 otherwise.
+ *
+ * @param arena
+ * Scratch arena holding the table and the pool. Growing either leaves the
+ * old copy in it until path_index_clean().
+ */
+typedef struct s_path_index
+{
+	t_path_slot		*slots;
+	size_t			mask;
+	size_t			used;
+	char			*pool;
+	size_t			pool_len;
+	size_t			pool_cap;
+	size_t			n_dirs;
+	char			state;
+	t_arena			arena;
+}					t_path_index;
+
+/**
+ * @struct s_pipex_info
+ * @brief Structure to store information required for pipex execution.
+ *
+ * @param i
+ * Index in argv of the command being launched.
+ *
+ * @param pipe_fds
+ * File descriptors of the pipe between both commands.
+ *
+ * @param paths
+ * Array of strings containing possible executable paths.
+ *
+ * @param arena
+ * Arena every allocation of the run is taken from, including this
+ * structure. It is destroyed by clean_pinfo().
+ *
+ * @param opts
+ * Runtime options, see t_popts.
+ *
+ * @param cmd_cache
+ * The command cache, see cmd_cache_open().
+ *
+ * @param stages
+ * Bookkeeping of both stages, indexed from 0.
+ *
+ * @param relays
+ * With PIPEX_SPLICE, relays[0] pumps the infile into the first command and
+ * relays[1] pumps the last command into the outfile. With PIPEX_INSTRUMENT,
+ * relays[2] pumps the pipe between both commands.
+ *
+ * @param relay_ends
+ * Pipe ends handed to the commands by the relays: [0] becomes the standard
+ * input of the first command and [1] the standard output of the last one.
+ * They are -1 when unused.
+ *
+ * @param links
+ * Capacity bookkeeping of the pipe between both commands.
+ *
+ * @param tuned_at
+ * Time of the last auto-tuning sample.
+ *
+ * @param sampled_at
+ * Time of the last PIPEX_INSTRUMENT sample of the relays.
+ *
+ * @param deadline_ns
+ * CLOCK_MONOTONIC time, in nanoseconds, at which PIPEX_TIMEOUT expires, or 0
+ * if unset.
+ *
+ * @param failed
+ * With PIPEX_PIPEFAIL, index of the stage blamed for the failure, see
+ * check_pipefail(). Only valid if failed_at is set.
+ *
+ * @param failed_at
+ * CLOCK_MONOTONIC time, in nanoseconds, at which that stage was found
+ * failed, or 0 if none has failed.
+ *
+ * @param teardown_ns
+ * Time from failed_at until the last stage upstream of the failed one was
+ * reaped, in nanoseconds.
+ */
+typedef struct s_pipex_info
+{
+	int				i;
+	int				*pipe_fds;
+	char			**paths;
+	t_arena			*arena;
+	t_popts			opts;
+	t_cmd_cache		cmd_cache;
+	t_stage			stages[2];
+	t_relay			relays[3];
+	int				relay_ends[2];
+	t_link			links[1];
+	struct timespec	tuned_at;
+	struct timespec	sampled_at;
+	long				deadline_ns;
+	size_t			failed;
+	long				failed_at;
+	long				teardown_ns;
+}					t_pinfo;
+
+/**
+ * @brief Closes every descriptor held by a pinfo structure.
+ *
+ * Closes the pipe, the relays, the link and the command cache if they are
+ * still set. Memory is left alone, so a child can still execve() the
+ * argument vector planned for it.
+ *
+ * @param pinfo The structure to close.
+ */
+void	close_pinfo(t_pinfo *pinfo);
+
+/**
+ * @brief Closes every descriptor held by a pinfo structure, see
+ *        close_pinfo(), and destroys the arena of the run, which releases
+ *        the structure itself.
+ *
+ * @param pinfo The structure to clean. It must not be used afterwards.
+ */
+void	clean_pinfo(t_pinfo *pinfo);
+
+/**
+ * @brief Creates and initializes a pinfo structure
+ *
+ * Splits the PATH environment variable, reads the runtime options and stores
+ * them in a t_pinfo structure taken from the arena along with the pipe. An
+ * unset PATH is treated as empty. Every stage starts as not launched.
+ *
+ * @param arena The arena of the run.
+ * @param pipe_fds The pipe shared by both commands.
+ * @return A pointer to the initialized t_pinfo structure, or NULL if memory
+ *         allocation fails.
+ */
+t_pinfo	*set_pinfo(t_arena *arena, int *pipe_fds);
+
+/**
+ * @brief Reads the runtime options from the environment.
+ *
+ * Recognised variables:
+ *
+ * - PIPEX_LAUNCH: "spawn" launches stages with posix_spawn(), anything else
+ *   keeps the fork() path.
+ *
+ * - PIPEX_STATS: any value other than "0" enables the exit report.
+ *
+ * - PIPEX_SPLICE: any value other than "0" makes the parent pump the infile
+ *   and outfile with splice(2).
+ *
+ * - PIPEX_INSTRUMENT: any value other than "0" makes the parent pump every
+ *   link between stages and report its traffic.
+ *
+ * - PIPEX_PIPE_SIZE: capacity of the pipes between stages, see
+ *   pipe_size_opt().
+ *
+ * - PIPEX_TIMEOUT: wall-clock limit of the whole pipeline, see
+ *   duration_opt().
+ *
+ * - PIPEX_STAGE_TIMEOUT: wall-clock limit of each stage, see duration_opt().
+ *
+ * - PIPEX_PIPEFAIL: any value other than "0" enables the pipefail mode, see
+ *   check_pipefail().
+ *
+ * - PIPEX_PATH_INDEX: minimum number of stages for which the PATH index is
+ *   built, "0" to never build it, see path_index_build().
+ *
+ * @param opts The structure to fill.
+ */
+void	set_popts(t_popts *opts);
+
+/**
+ * @brief Reads the capacity requested for a link in PIPEX_PIPE_SIZE.
+ *
+ * The option is a comma separated list with one entry per link, the last
+ * entry applying to every remaining link. An entry is either a size in bytes
+ * with an optional K or M suffix, or "auto".
+ *
+ * @param spec The option value, or NULL.
+ * @param link Index of the link, from 0.
+ * @return The size in bytes, -1 for "auto" or 0 to keep the default.
+ */
+long	pipe_size_opt(const char *spec, size_t link);
+
+/**
+ * @brief Reads the wall-clock limit requested for an entry of a duration
+ *        list, as used by PIPEX_TIMEOUT and PIPEX_STAGE_TIMEOUT.
+ *
+ * The option is a comma separated list, the last entry applying to every
+ * remaining index. An entry is a number with an optional unit: "ms", "s" or
+ * "m". A bare number is taken as seconds.
+ *
+ * @param spec The option value, or NULL.
+ * @param index Index of the entry, from 0.
+ * @return The limit in milliseconds, or 0 for no limit.
+ */
+long	duration_opt(const char *spec, size_t index);
+
+/**
+ * @brief Applies PIPEX_PIPE_SIZE to the pipe between both commands.
+ *
+ * Sizes are clamped to PIPE_MAX_FILE. An auto link starts with the default
+ * capacity and keeps a copy of its read end so tune_links() can sample it.
+ * It runs before set_link_relays(), so with PIPEX_INSTRUMENT it is still the
+ * pipe the first command writes to that is sized and sampled.
+ *
+ * @param pinfo Pipeline information.
+ */
+void	set_links(t_pinfo *pinfo);
+
+/**
+ * @brief Sets the capacity of a link, clamped to its maximum.
+ *
+ * If the kernel refuses the new size the link maximum is lowered to the
+ * current capacity, so the auto mode does not try again.
+ *
+ * @param link The link to resize.
+ * @param fd Any end of the pipe.
+ * @param size Requested capacity in bytes.
+ */
+void	resize_link(t_link *link, int fd, long size);
+
+/**
+ * @brief Samples every auto-tuned link and doubles the capacity of those
+ *        found full for PIPE_TUNE_STREAK samples in a row.
+ *
+ * A full pipe means its writer is blocked waiting for the reader. Samples
+ * are taken at most once every PIPE_TUNE_MS, so the function can be called
+ * as often as needed. Links whose reader has exited, or was never launched,
+ * are closed without reaping the reader, so the writer gets SIGPIPE even
+ * while the parent is busy pumping relays.
+ *
+ * @param pinfo Pipeline information.
+ * @return Number of links still being tuned.
+ */
+int		tune_links(t_pinfo *pinfo);
+
+/**
+ * @brief Stops tuning a link, closing the parent copy of its read end.
+ *
+ * @param link The link to close.
+ */
+void	close_link(t_link *link);
+
+/**
+ * @brief Closes both ends of a pipe
+ *
+ * This function closes both file descriptors in a pipe array. Its memory
+ * belongs to the arena of the run. If any close operation fails, an error
  * message is displayed.
  *
  * @param pipe_fds Pointer to an array containing pipe file descriptors
  *                 [0] is the read end and [1] is the write end
  *
  * @note The function will attempt to close both pipe ends even if one fails
- * @note The pipe_fds memory is freed regardless of close operation status
  */
 void	clean_pipe(int *pipe_fds);
 
 /**
  * @brief Creates a new pipe and allocates memory for its file descriptors
  *
- * This function allocates memory for two integers to store the read and write
- * file descriptors of a pipe, then initializes the pipe using the system
- * pipe() call.
+ * This function takes two integers from the arena to store the read and
+ * write file descriptors of a pipe, then initializes the pipe using the
+ * system pipe() call.
  *
+ * @param arena The arena of the run.
  * @return A pointer to an array of two integers containing the pipe file
  *         descriptors [0] for reading, [1] for writing, or NULL if an error
  *         occurred
- * @note The caller is responsible for freeing the returned memory when no
- *       longer needed
  * @note In case of failure, appropriate error messages are printed to stderr
  */
-int		*create_pipe(void);
+int		*create_pipe(t_arena *arena);
 
 /**
  * @brief Executes either the first or last command in a pipeline
  *
- * This function determines which command execution function to call based on
- * the value of i. If i is 2, it executes the first command in the pipeline.
- * Otherwise, it executes the last command.
+ * Runs in the forked child. If pinfo->i is 2, the standard input is
+ * redirected to the infile and the standard output to the pipe. Otherwise
+ * the standard input is redirected to the pipe and the standard output to
+ * the outfile. The stage is then replaced by the command planned for it by
+ * plan_stages(), without allocating anything.
+ *
+ * @param pinfo Pipeline information. pinfo->i is the argv index of the
+ *              command to execute.
+ * @param argv Array of command line arguments
+ */
+void	execute_cmd(t_pinfo *pinfo, char *argv[]);
+
+/**
+ * @brief Launches the command at argv[pinfo->i] with posix_spawn().
+ *
+ * Everything the forked child does before execve() is done here in the
+ * parent instead: the endpoint file is opened and the dup2()/close() wiring
+ * is expressed as spawn file actions. The command was already planned by
+ * plan_stages().
+ * glibc implements posix_spawn() with clone(CLONE_VM | CLONE_VFORK), so the
+ * parent page tables are never copied.
  *
+ * @param pinfo Pipeline information. pinfo->i is the argv index of the
+ *              command to launch.
  * @param argv Array of command line arguments
- * @param paths Array of possible paths to search for executables
- * @param pipe_fds Array of pipe file descriptors for input/output redirection
- * @param i Index determining which command to execute (2 for first, other for
- *          last)
+ *
+ * @return The PID of the new process, or -1 if it could not be launched. In
+ *         that case the stage status is set to 1, what the forked child
+ *         would have exited with.
  */
-void	execute_cmd(char *argv[], char **paths, int *pipe_fds, int i);
+pid_t	handle_spawn(t_pinfo *pinfo, char *argv[]);
+
+/**
+ * @brief Sets a relay between two descriptors.
+ *
+ * If either descriptor is -1 the other one is closed and the relay is left
+ * finished, with both ends set to -1.
+ *
+ * @param relay The relay to initialize.
+ * @param in Descriptor data is read from.
+ * @param out Descriptor data is written to.
+ */
+void	init_relay(t_relay *relay, int in, int out);
+
+/**
+ * @brief Closes both ends of a relay and marks it as finished.
+ *
+ * Closing the write end lets the reading command see EOF, and closing the
+ * read end lets the writing command get SIGPIPE, exactly as if they were
+ * connected directly.
+ *
+ * @param relay The relay to close.
+ */
+void	close_relay(t_relay *relay);
+
+/**
+ * @brief Opens the infile and outfile in the parent and creates the pipes
+ *        the relays hand to the first and last command.
+ *
+ * The pipes are created with O_CLOEXEC, so the commands only keep the end
+ * duplicated onto their standard input or output. If an endpoint file cannot
+ * be opened its relay is left finished, and the command that needs it is
+ * not launched, just like a forked child would give up before execve().
+ *
+ * @param pinfo Pipeline information.
+ * @param argv Array of command line arguments
+ * @return 0 on success, 1 if the pipes could not be created.
+ */
+int		set_relays(t_pinfo *pinfo, char *argv[]);
+
+/**
+ * @brief Makes the parent pump the pipe between both commands.
+ *
+ * The first command keeps writing to the pipe, whose read end becomes the
+ * input of relays[2]. A new O_CLOEXEC pipe is created for the output of the
+ * relay and its read end replaces the old one in pipe_fds, so the second
+ * command reads from it without knowing about the relay.
+ *
+ * @param pinfo Pipeline information.
+ * @return 0 on success, 1 on failure.
+ */
+int		set_link_relays(t_pinfo *pinfo);
+
+/**
+ * @brief Runs the periodic work of the relay pump and tells how long it may
+ *        sleep in poll(2).
+ *
+ * Auto-tuned links are sampled, see tune_links(), and with PIPEX_INSTRUMENT
+ * the fill level of every relay pipe is sampled once every RELAY_SAMPLE_MS.
+ * The time since the previous sample is added to blocked_ns if in was full
+ * then, and to wait_ns if out was empty. Stages past their deadline are
+ * signalled, see check_deadlines().
+ *
+ * @param pinfo Pipeline information.
+ * @return The poll(2) timeout in milliseconds, -1 if there is nothing to
+ *         sample and no deadline.
+ */
+int		relay_tick(t_pinfo *pinfo);
+
+/**
+ * @brief Closes the parent copy of the pipe ends handed to the commands.
+ *
+ * Must be called once every command has been launched.
+ *
+ * @param pinfo Pipeline information.
+ */
+void	close_relay_ends(t_pinfo *pinfo);
+
+/**
+ * @brief Moves one chunk of a relay through user space, for ends that do not
+ *        support splice(2).
+ *
+ * @param relay The relay to pump.
+ * @return Bytes moved, 0 at EOF or -1 on error, like splice(2).
+ */
+ssize_t	relay_rw(t_relay *relay);
+
+/**
+ * @brief Pumps every relay until all of them are finished.
+ *
+ * Pipe ends are polled and data is moved with splice(2), so it never goes
+ * through user space, falling back to read(2)/write(2) for ends that do not
+ * support it. A relay finishes at EOF, when its reader goes away (EPIPE) or
+ * on error.
+ *
+ * Auto-tuned links keep being sampled and deadlines keep being enforced
+ * while the relays are pumped.
+ *
+ * @param pinfo Pipeline information holding the relays.
+ *
+ * @note SIGPIPE must be ignored by the caller.
+ */
+void	run_relays(t_pinfo *pinfo);
+
+/**
+ * @brief Returns the nanoseconds elapsed since start on CLOCK_MONOTONIC.
+ *
+ * @param start A time previously taken with clock_gettime(CLOCK_MONOTONIC).
+ * @return Elapsed time in nanoseconds.
+ */
+long	elapsed_ns(struct timespec *start);
+
+/**
+ * @brief Returns the current CLOCK_MONOTONIC time in nanoseconds.
+ *
+ * @return The current time in nanoseconds.
+ */
+long	now_ns(void);
+
+/**
+ * @brief Starts supervising a stage that has just been launched.
+ *
+ * A pidfd is opened for the stage, and its deadline is set from
+ * PIPEX_STAGE_TIMEOUT and the pipeline deadline, whichever comes first. The
+ * pipeline deadline itself is set when the first stage is armed.
+ *
+ * @param pinfo Pipeline information.
+ * @param index Index of the stage, from 0.
+ */
+void	arm_stage(t_pinfo *pinfo, size_t index);
+
+/**
+ * @brief Signals every running stage whose deadline has passed.
+ *
+ * A stage past its deadline gets SIGTERM and a new deadline
+ * TIMEOUT_GRACE_MS later. If it is still running then, it gets SIGKILL.
+ *
+ * @param pinfo Pipeline information.
+ * @return Milliseconds until the next deadline, or -1 if there is none.
+ */
+int		check_deadlines(t_pinfo *pinfo);
+
+/**
+ * @brief Sends the next signal of the escalation to a stage.
+ *
+ * The first call sends SIGTERM and sets the deadline of the stage
+ * TIMEOUT_GRACE_MS later, so check_deadlines() sends SIGKILL if the stage is
+ * still running then. The second call sends SIGKILL.
+ *
+ * @param stage The stage to signal.
+ * @param now Current time in nanoseconds, see now_ns().
+ */
+void	signal_stage(t_stage *stage, long now);
+
+/**
+ * @brief Returns the shortest of two poll(2) timeouts.
+ *
+ * @param timeout A timeout in milliseconds, or -1 for none.
+ * @param ms Another timeout in milliseconds. It must not be -1.
+ * @return The shortest of both.
+ */
+int		sooner(int timeout, int ms);
+
+/**
+ * @brief Reaps every stage that has exited, without blocking.
+ *
+ * Stages are reaped from the last one, so a downstream stage is seen before
+ * the upstream stages it breaks, see check_pipefail().
+ *
+ * @param pinfo Pipeline information.
+ * @return Number of stages still running.
+ */
+size_t	reap_stages(t_pinfo *pinfo);
+
+/**
+ * @brief Applies PIPEX_PIPEFAIL once a stage has finished.
+ *
+ * The first stage found with a non-zero status fails the pipeline: every
+ * stage upstream of it gets SIGTERM, escalated to SIGKILL after
+ * TIMEOUT_GRACE_MS, and the parent closes the relays and link ends feeding
+ * them, so they stop at once instead of running until they hit SIGPIPE.
+ * Upstream stages reaped afterwards update teardown_ns.
+ *
+ * A stage killed by SIGPIPE was usually broken by a downstream stage that
+ * exited first, so a downstream stage found failed later takes the blame
+ * from it. Stages are reaped from the last one for the same reason.
+ *
+ * It does nothing unless PIPEX_PIPEFAIL is set.
+ *
+ * @param pinfo Pipeline information.
+ * @param index Index of the stage that has finished, from 0. Its status
+ *              must be set.
+ */
+void	check_pipefail(t_pinfo *pinfo, size_t index);
+
+/**
+ * @brief Returns the exit status of the pipeline.
+ *
+ * @param pinfo Pipeline information after every stage has been waited for.
+ * @return The status of the failed stage with PIPEX_PIPEFAIL, or the
+ *         status of the last stage otherwise.
+ */
+int		pipeline_status(t_pinfo *pinfo);
+
+/**
+ * @brief Writes the `"pipefail":{...}` member of the JSON run report, with
+ *        the failed stage, its status and teardown_ns.
+ *
+ * Nothing is written unless a stage has failed with PIPEX_PIPEFAIL.
+ *
+ * @param out Output buffer of the report.
+ * @param pinfo Pipeline information.
+ */
+void	report_pipefail(t_outbuf *out, t_pinfo *pinfo);
+
+/**
+ * @brief Tokenizes and resolves the command of every stage, once, before any
+ *        process is created.
+ *
+ * Every command that cannot be found is reported, so nothing is launched
+ * and no endpoint file is touched for a pipeline that cannot run. Forked
+ * children then only wire their descriptors and call execve().
+ *
+ * @param pinfo Pipeline information with the stages allocated.
+ * @param argv Array of command line arguments
+ * @return 0 on success, 127 if a command is empty or was not found, 2 if
+ *         it leaves a quote open, or 1 if memory could not be allocated.
+ */
+int		plan_stages(t_pinfo *pinfo, char *argv[]);
+
+/**
+ * @brief Splits a stage command into its argument vector.
+ *
+ * Arguments are separated by whitespace. Single quotes keep everything up
+ * to the closing quote literally. Double quotes keep whitespace, and a
+ * backslash inside them only escapes '"' and '\\'. Outside quotes a
+ * backslash escapes any character. Quotes may be glued to other text, as in
+ * a shell, and '' is an empty argument.
+ *
+ * The pointer array and the bytes of every argument share a single block
+ * taken from the arena, which is released along with the whole run.
+ *
+ * @param arena The arena the vector is allocated from.
+ * @param cmd The command.
+ * @return The NULL-terminated argument vector, or NULL with errno set to
+ *         EINVAL if a quote is left open, or to ENOMEM.
+ */
+char	**split_args(t_arena *arena, const char *cmd);
+
+/**
+ * @brief Stores the exit status and resource usage of a reaped stage.
+ *
+ * A stage killed by a signal gets 128 plus the signal number, like in a
+ * shell. The pidfd of the stage is closed, and so is the link it reads from,
+ * see close_link().
+ *
+ * @param pinfo Pipeline information.
+ * @param index Index of the stage, from 0.
+ * @param status Raw status returned by wait4().
+ * @param usage Resource usage returned by wait4().
+ */
+void	set_stage_status(t_pinfo *pinfo, size_t index, int status,
+		struct rusage *usage);
+
+/**
+ * @brief Writes a string as-is to a file descriptor.
+ *
+ * @param out Output buffer of the report.
+ * @param raw The string to write.
+ */
+void	json_put(t_outbuf *out, const char *raw);
+
+/**
+ * @brief Writes a `"key":"value"` JSON member, escaping the value.
+ *
+ * @param out Output buffer of the report.
+ * @param key Member name. It is written without escaping.
+ * @param value Member value. Quotes, backslashes and control characters are
+ *              escaped.
+ */
+void	json_key_str(t_outbuf *out, const char *key, const char *value);
+
+/**
+ * @brief Writes a `"key":value` JSON member with an integer value.
+ *
+ * @param out Output buffer of the report.
+ * @param key Member name. It is written without escaping.
+ * @param value Member value.
+ */
+void	json_key_num(t_outbuf *out, const char *key, long value);
+
+/**
+ * @brief Writes a `"rusage":{...}` JSON member with the resources used by a
+ *        stage.
+ *
+ * CPU times are given in microseconds and the maximum resident set size in
+ * kilobytes, as reported by the kernel.
+ *
+ * @param out Output buffer of the report.
+ * @param usage Resources used by the stage.
+ */
+void	json_key_rusage(t_outbuf *out, struct rusage *usage);
+
+/**
+ * @brief Writes an `"arena":{...}` JSON member with the high-water mark of
+ *        an arena.
+ *
+ * @param out Output buffer of the report.
+ * @param arena The arena, see t_arena.
+ */
+void	json_key_arena(t_outbuf *out, t_arena *arena);
+
+/**
+ * @brief Writes the JSON members describing the traffic of a relay: bytes,
+ *        reads, writes, blocked_ns, wait_ns and whether it spliced.
+ *
+ * @param out Output buffer of the report.
+ * @param relay The relay to report.
+ */
+void	json_relay_traffic(t_outbuf *out, t_relay *relay);
+
+/**
+ * @brief Writes the JSON run report to stderr.
+ *
+ * The report is formatted into a REPORT_BUF stack buffer and written with a
+ * single write(2) when it fits, so reports of concurrent runs sharing stderr
+ * do not interleave.
+ *
+ * The report contains the launch backend and, for every stage, its command,
+ * PID, exit status, launch latency, signals sent and resource usage. With
+ * PIPEX_SPLICE it also contains the traffic of each relay, and with
+ * PIPEX_PIPE_SIZE or PIPEX_INSTRUMENT the final capacity of the link, along
+ * with its traffic if instrumented.
+ * With PIPEX_PIPEFAIL it also tells which stage failed first, see
+ * report_pipefail(). The high-water mark of the run arena is always given,
+ * see json_key_arena().
+ *
+ * @param pinfo Pipeline information after every stage has been waited for.
+ * @param argv Array of command line arguments
+ */
+void	report_stats(t_pinfo *pinfo, char *argv[]);
 
 /**
  * @brief Resolves the full path of a command by searching in the given paths.
  *
- * This function takes a command string, which may include arguments, and an
- * array of directory paths to search for the command. It splits the command
- * into its arguments, extracts the command name, and appends a '/' to it. The
- * function then iterates through the provided paths to locate the command. If
- * the command is found, its full path is returned. If an error occurs (e.g.,
- * memory allocation failure or empty command), appropriate error handling is
- * performed.
+ * A name containing a '/' is used as is if it is executable. Otherwise a '/'
+ * is prepended to it and the provided paths are searched in order for an
+ * executable file with that name.
+ *
+ * @param name The command name, the first word of the command. NULL for an
+ *             empty command.
+ * Candidates are built in a stack buffer, so only the path found is
+ * copied to the arena.
+ *
+ * @param pinfo Pipeline information holding the PATH directories, the
+ *              command cache, whose hits are validated and misses stored,
+ *              see cmd_cache_lookup(), and the arena.
+ * @param index The PATH index. Once built, it is used instead of the cache,
+ *              see path_index_find().
+ *
+ * @return The full path of the command, allocated from the arena, or NULL
+ *         if it is not found.
+ */
+char	*get_cmd_path(t_pinfo *pinfo, char *name, t_path_index *index);
+
+/**
+ * @brief Joins a directory and a command name into a path buffer.
+ *
+ * @param buf Destination buffer of PATH_MAX bytes.
+ * @param dir The directory.
+ * @param cmd The command name with a leading '/'.
+ * @return 0 on success, 1 with errno set to ENAMETOOLONG if the path does
+ *         not fit.
+ */
+int		join_path(char *buf, const char *dir, const char *cmd);
+
+/**
+ * @brief Opens and maps the command cache shared by every pipex instance.
+ *
+ * The cache is enabled by PIPEX_CMD_CACHE: a value starting with '/' is the
+ * path of the cache file, and any other value other than "0" selects
+ * CMD_CACHE_FILE, which lives in tmpfs and is suffixed with the effective
+ * uid, so each user gets their own. The file is created with mode 0600 and
+ * opened with O_NOFOLLOW, and it is only used if it is a regular file owned
+ * by the effective user that neither the group nor others can write to.
+ * Any failure leaves the cache disabled, and commands are then searched
+ * through PATH as usual.
+ *
+ * It is opened lazily by the parent the first time a command is resolved,
+ * see plan_stages().
  *
- * @param command A string containing the command to resolve. It may include
- *                arguments.
- * @param paths An array of strings representing the directories to search for
- *              the command.
+ * @param cache The handle to open.
+ * @return 0 if the cache is usable, 1 otherwise.
+ */
+int		cmd_cache_open(t_cmd_cache *cache);
+
+/**
+ * @brief Unmaps and closes the command cache.
  *
- * @return A string containing the full path of the command if found, or NULL
- *         if an error occurs. The returned string must be freed by the caller.
+ * @param cache The handle to close.
  */
-char	*get_cmd_path(char command[], char **paths);
+void	cmd_cache_close(t_cmd_cache *cache);
+
+/**
+ * @brief Finds the cache entry a command maps to, opening the cache first
+ *        if needed.
+ *
+ * @param cache The command cache.
+ * @param cmd Name of the command with a leading '/'.
+ * @param path_hash Filled with the hash of the current PATH string.
+ * @return The shared entry, or NULL if the cache is disabled, PATH is unset
+ *         or the name is too long.
+ */
+t_cmd_entry	*cmd_cache_slot(t_cmd_cache *cache, const char *cmd,
+		unsigned long *path_hash);
+
+/**
+ * @brief Looks a command up in the command cache.
+ *
+ * A hit is only used if it was stored with the same PATH string, the
+ * modification time of every PATH directory up to the one holding it is
+ * unchanged, so no earlier directory has gained the command, and the
+ * command is still executable. Anything else is a miss, and the caller
+ * falls back to the normal search. Entries are read under their seqlock,
+ * without locking the file.
+ *
+ * @param cache The command cache.
+ * @param cmd Name of the command with a leading '/'.
+ * @param paths The PATH directories.
+ * @param cmd_path Buffer of PATH_MAX bytes filled with the absolute path of
+ *                 the command on a hit.
+ * @return 0 on a hit, 1 on a miss.
+ */
+int		cmd_cache_lookup(t_cmd_cache *cache, char *cmd, char **paths,
+		char *cmd_path);
+
+/**
+ * @brief Stores a command found by the PATH search in the command cache.
+ *
+ * Commands found in a relative PATH directory, and names or paths too long
+ * for an entry, are not stored. Writers take an exclusive flock(2) on the
+ * cache file and bump the seqlock of the entry around the update.
+ *
+ * @param cache The command cache.
+ * @param paths The PATH directories.
+ * @param dir Index of the directory the command was found in.
+ * @param cmd_path Absolute path of the command, paths[dir] followed by the
+ *                 command name.
+ */
+void	cmd_cache_store(t_cmd_cache *cache, char **paths, size_t dir,
+		char *cmd_path);
+
+/**
+ * @brief Hashes a string with 64-bit FNV-1a.
+ *
+ * @param str The string to hash.
+ * @param hash Initial value, CMD_CACHE_FNV or a previous hash to chain.
+ * @return The hash.
+ */
+unsigned long	fnv_hash(const char *str, unsigned long hash);
+
+/**
+ * @brief Builds the PATH index, reading every directory once with
+ *        getdents64(2).
+ *
+ * Each name is mapped to the first directory that has it, so resolving a
+ * command costs a hash table lookup and a single access(2) instead of one
+ * access(2) per directory. Building it reads every entry of every
+ * directory, so plan_stages() only does it for pipelines of at least
+ * PIPEX_PATH_INDEX stages.
+ *
+ * @param index The index to build.
+ * @param paths The PATH directories.
+ * @return 0 on success. 1 if a directory could not be read or memory could
+ *         not be allocated, in which case the index is left empty and the
+ *         commands are searched as usual.
+ */
+int		path_index_build(t_path_index *index, char **paths);
+
+/**
+ * @brief Adds a name to the PATH index, unless an earlier directory already
+ *        has it.
+ *
+ * @param index The index.
+ * @param name The name.
+ * @param dir Index in PATH of the directory the name was found in.
+ * @return 0 on success, 1 if memory could not be allocated.
+ */
+int		path_index_add(t_path_index *index, const char *name, size_t dir);
+
+/**
+ * @brief Finds a name in the PATH index.
+ *
+ * @param index The index.
+ * @param name The name, without a leading '/'.
+ * @return The slot of the name, or NULL if no PATH directory has it.
+ */
+t_path_slot	*path_index_find(t_path_index *index, const char *name);
+
+/**
+ * @brief Destroys the arena of the PATH index and leaves it empty.
+ *
+ * @param index The index.
+ */
+void	path_index_clean(t_path_index *index);
 
 /**
  * @brief Creates and manages child processes to execute commands in a pipeline
  *
  * This function iterates through the command arguments, creating a child
  * process for each command using handle_fork(). It first extracts and splits
- * the PATH environment variable to locate executables. After creating all
+ * the PATH environment variable and resolves every command with
+ * plan_stages(), returning 127 before anything is launched if one of them
+ * cannot be found. After creating all
  * needed child processes, it cleans up resources and waits for all child
  * processes to complete.
  *
+ * Each launch is timed, and the report is written once every child has
+ * exited if PIPEX_STATS is set.
+ *
  * @param argc Number of command-line arguments
  * @param argv Array of command-line arguments where commands start at index 2
+ * @param arena The arena of the run. It is destroyed before returning.
  * @param pipe_fds Array of pipe file descriptors for inter-process
  *                 communication
  *
@@ -104,7 +1247,7 @@ char	*get_cmd_path(char command[], char **paths);
  * @note The function assumes commands start at argv[2] and continue until
  *       argv[argc-2]
  */
-int		fork_loop(int argc, char *argv[], int *pipe_fds);
+int		fork_loop(int argc, char *argv[], t_arena *arena, int *pipe_fds);
 
 /**
  * @brief Sets the specified file as the standard input (stdin) for the process.
@@ -123,6 +1266,30 @@ int		fork_loop(int argc, char *argv[], int *pipe_fds);
  */
 int		set_infile(char file[]);
 
+/**
+ * @brief Opens the input file of the pipeline.
+ *
+ * The descriptor is opened with O_CLOEXEC so it never leaks into a command
+ * unless it is explicitly duplicated.
+ *
+ * @param file Path to the input file.
+ * @return The new file descriptor, or -1 with an error message printed to
+ *         stderr.
+ */
+int		open_infile(char file[]);
+
+/**
+ * @brief Opens (creating or truncating) the output file of the pipeline.
+ *
+ * The descriptor is opened with O_CLOEXEC so it never leaks into a command
+ * unless it is explicitly duplicated.
+ *
+ * @param file Path to the output file.
+ * @return The new file descriptor, or -1 with an error message printed to
+ *         stderr.
+ */
+int		open_outfile(char file[]);
+
 /**
  * @brief Sets up a file as the standard output
  *
@@ -137,23 +1304,28 @@ int		set_outfile(char file[]);
 
 /**
  * @brief Waits for all child processes to terminate and collects the exit
- *        status of a specific child process.
+ *        status and resource usage of every stage.
+ *
+ * Every stage is watched through its pidfd in an epoll instance, so the
+ * parent sleeps until a stage exits, a deadline expires or an auto-tuned
+ * link must be sampled, see check_deadlines() and tune_links(). Each stage
+ * is reaped with wait4(), storing its exit status and struct rusage, but
+ * only the exit status of the last stage is returned. If the process
+ * terminated normally, its exit code is returned. If it terminated due to a
+ * signal, 128 plus the signal number is returned. With PIPEX_PIPEFAIL, the
+ * status of the first failed stage is returned instead, see
+ * check_pipefail(). If the last stage could
+ * not be launched, its preset status is returned.
  *
- * This function waits for all child processes to finish their execution,
- * but only returns the exit status of the child process identified by
- * last_pid. If the specified process terminated normally, its exit code
- * is returned. If it terminated due to a signal, the signal value is
- * returned.
+ * If pidfds or epoll are not available, the stages are polled every
+ * SUPERVISE_POLL_MS instead.
  *
- * @param last_pid The PID of the child process whose exit status should be
- *                 returned
+ * @param pinfo Pipeline information with the PID of every stage.
  *
- * @return The exit status of the child process specified by last_pid,
- *         or 0 if the specified process was not found
+ * @return The exit status of the last stage.
  *
- * @note Prints an error message if waitpid fails for any reason other
- *       than having no more children to wait for (ECHILD).
+ * @note Prints an error message if wait4() or epoll_wait() fail.
  */
-int		wait_childs(pid_t last_pid);
+int		wait_childs(t_pinfo *pinfo);
 
 #endif
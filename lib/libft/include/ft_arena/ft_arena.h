@@ -0,0 +1,197 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_arena.h                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 08:35:56 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 10:24:15 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef FT_ARENA_H
+# define FT_ARENA_H
+
+# include <stddef.h>
+
+# define FT_ARENA_CHUNK 65536
+# define FT_ARENA_ALIGN 16
+
+/**
+ * @struct s_arena_chunk
+ * @brief A block of memory handed out by an arena.
+ *
+ * The header is a multiple of FT_ARENA_ALIGN bytes, so data keeps the
+ * alignment of malloc().
+ *
+ * @param prev
+ * The chunk allocated before this one, or NULL.
+ *
+ * @param size
+ * Capacity of data, in bytes.
+ *
+ * @param used
+ * Bytes of data handed out.
+ *
+ * @param pad
+ * Unused, keeps data aligned.
+ *
+ * @param data
+ * The memory handed out.
+ */
+typedef struct s_arena_chunk
+{
+	struct s_arena_chunk	*prev;
+	size_t					size;
+	size_t					used;
+	size_t					pad;
+	char					data[];
+}							t_arena_chunk;
+
+/**
+ * @struct s_arena
+ * @brief A bump allocator. Memory is handed out from chunks allocated with
+ *        malloc() and only given back all at once.
+ *
+ * @param chunk
+ * The chunk memory is handed out from, or NULL before the first allocation.
+ *
+ * @param used
+ * Bytes handed out and not reset, across every chunk.
+ *
+ * @param peak
+ * High-water mark of used.
+ *
+ * @param reserved
+ * Bytes currently allocated with malloc() for the chunks, headers included.
+ *
+ * @param chunks
+ * Number of chunks currently allocated.
+ */
+typedef struct s_arena
+{
+	t_arena_chunk	*chunk;
+	size_t			used;
+	size_t			peak;
+	size_t			reserved;
+	size_t			chunks;
+}					t_arena;
+
+/**
+ * @struct s_arena_mark
+ * @brief A position of an arena, see ft_arena_mark().
+ *
+ * @param chunk
+ * The chunk in use when the mark was taken.
+ *
+ * @param chunk_used
+ * Bytes of that chunk handed out when the mark was taken.
+ *
+ * @param used
+ * Bytes handed out by the arena when the mark was taken.
+ */
+typedef struct s_arena_mark
+{
+	t_arena_chunk	*chunk;
+	size_t			chunk_used;
+	size_t			used;
+}					t_arena_mark;
+
+/**
+ * @brief Initializes an empty arena. Nothing is allocated until the first
+ *        ft_arena_alloc().
+ *
+ * @param arena The arena.
+ */
+void			ft_arena_init(t_arena *arena);
+
+/**
+ * @brief Hands out memory from an arena.
+ *
+ * The size is rounded up to FT_ARENA_ALIGN. When the current chunk is full a
+ * new one of FT_ARENA_CHUNK bytes, or of the requested size if it is larger,
+ * is allocated. The rest of the full chunk is not used again.
+ *
+ * @param arena The arena.
+ * @param size Number of bytes.
+ * @return Memory aligned like malloc(), uninitialized, or NULL with errno
+ *         set to ENOMEM.
+ */
+void			*ft_arena_alloc(t_arena *arena, size_t size);
+
+/**
+ * @brief Hands out zeroed memory for an array from an arena.
+ *
+ * @param arena The arena.
+ * @param nmemb Number of elements.
+ * @param size Size of each element.
+ * @return The zeroed memory, or NULL with errno set to ENOMEM if it could
+ *         not be allocated or nmemb * size overflows.
+ */
+void			*ft_arena_calloc(t_arena *arena, size_t nmemb, size_t size);
+
+/**
+ * @brief Frees every chunk of an arena at once and leaves it empty.
+ *
+ * The cost depends on the number of chunks, not on the number of
+ * allocations. peak is kept, so it can still be reported.
+ *
+ * @param arena The arena.
+ */
+void			ft_arena_destroy(t_arena *arena);
+
+/**
+ * @brief Takes the current position of an arena.
+ *
+ * @param arena The arena.
+ * @return The mark, to be given to ft_arena_reset().
+ */
+t_arena_mark	ft_arena_mark(t_arena *arena);
+
+/**
+ * @brief Gives back everything handed out since a mark was taken.
+ *
+ * Chunks allocated since then are freed. Marks taken after this one must not
+ * be used any more.
+ *
+ * @param arena The arena.
+ * @param mark A mark of this arena, see ft_arena_mark().
+ */
+void			ft_arena_reset(t_arena *arena, t_arena_mark mark);
+
+/**
+ * @brief Duplicates a string into an arena.
+ *
+ * @param arena The arena.
+ * @param s The string.
+ * @return The copy, or NULL if memory could not be allocated.
+ */
+char			*ft_arena_strdup(t_arena *arena, const char *s);
+
+/**
+ * @brief Duplicates at most n characters of a string into an arena, as
+ *        strndup(3) does.
+ *
+ * @param arena The arena.
+ * @param s The string.
+ * @param n Maximum number of characters to copy. With 0 the copy is empty.
+ * @return The NUL-terminated copy, or NULL if memory could not be allocated.
+ */
+char			*ft_arena_strndup(t_arena *arena, const char *s, size_t n);
+
+/**
+ * @brief Splits a string by a delimiter into an arena.
+ *
+ * Empty fields are skipped, as with ft_split(). The pointer array and the
+ * fields share a single allocation.
+ *
+ * @param arena The arena.
+ * @param s The string.
+ * @param c The delimiter.
+ * @return The NULL-terminated array of fields, or NULL if memory could not
+ *         be allocated.
+ */
+char			**ft_arena_split(t_arena *arena, const char *s, char c);
+
+#endif
@@ -6,7 +6,7 @@
 /*   By: pablo <pablo@student.42.fr>                +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/09/26 13:46:34 by pabmart2          #+#    #+#             */
-/*   Updated: 2025/03/29 14:18:42 by pablo            ###   ########.fr       */
+/*   Updated: 2026/10/17 09:00:23 by pabmart2         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -17,21 +17,111 @@
 #  define BUFFER_SIZE 50
 # endif
 
+# ifndef GNL_MAX_FD
+#  define GNL_MAX_FD 1024
+# endif
+
 # include "libft.h"
+# include <pthread.h>
 # include <stdlib.h>
+# include <sys/types.h>
 # include <unistd.h>
 
+/**
+ * @struct s_gnl
+ * @brief A line reader bound to one file descriptor.
+ *
+ * Unread data is kept in a ring buffer that doubles when a line does not
+ * fit in it. Newlines are searched with ft_memchr() and never twice over
+ * the same bytes, so reading a line is linear in its length.
+ *
+ * @param fd
+ * The file descriptor lines are read from.
+ *
+ * @param buf
+ * The ring buffer.
+ *
+ * @param cap
+ * Capacity of buf, in bytes.
+ *
+ * @param head
+ * Offset in buf of the first unread byte.
+ *
+ * @param len
+ * Unread bytes, starting at head and wrapping at cap.
+ *
+ * @param scanned
+ * Unread bytes already known to hold no newline.
+ *
+ * @param lock
+ * Recursive mutex held by every call on the reader.
+ */
+typedef struct s_gnl
+{
+	int				fd;
+	char			*buf;
+	size_t			cap;
+	size_t			head;
+	size_t			len;
+	size_t			scanned;
+	pthread_mutex_t	lock;
+}					t_gnl;
+
+/**
+ * @brief Initializes a line reader.
+ *
+ * @param reader The reader.
+ * @param fd The file descriptor to read lines from.
+ * @param size Initial capacity of the buffer, and so the largest read(2),
+ *             or 0 for BUFFER_SIZE.
+ * @return 0 on success, -1 if the buffer or the lock could not be created.
+ */
+int		ft_gnl_init(t_gnl *reader, int fd, size_t size);
+
+/**
+ * @brief Frees the buffer and the lock of a line reader. The file descriptor
+ *        is not closed.
+ *
+ * @param reader The reader.
+ */
+void	ft_gnl_destroy(t_gnl *reader);
+
+/**
+ * @brief Hands out the next line without copying it.
+ *
+ * The line is left in the buffer of the reader, in one piece. It is not
+ * NUL-terminated and includes its newline, if it has one.
+ *
+ * @param reader The reader.
+ * @param line Set to the start of the line. It is valid until the next call
+ *             on the reader, from any thread.
+ * @return Length of the line, 0 at end of file or -1 on error with errno
+ *         set. A last line without newline is handed out at end of file,
+ *         and the call after returning 0 reads again.
+ */
+ssize_t	ft_gnl_view(t_gnl *reader, const char **line);
+
+/**
+ * @brief Hands out a copy of the next line.
+ *
+ * Safe to call from several threads sharing the reader: each line goes to
+ * exactly one of them.
+ *
+ * @param reader The reader.
+ * @return The NUL-terminated line, with its newline if it has one, to be
+ *         freed by the caller, or NULL at end of file or on error.
+ */
+char	*ft_gnl_next(t_gnl *reader);
+
 /**
  * @brief Reads a line from a file descriptor.
  *
- * This function reads a line from the given file descriptor and returns it
- * as a dynamically allocated string. It uses a static buffer to store
- * leftover data between calls. If a newline character is found in the
- * static buffer, it returns the line up to and including the newline.
- * Otherwise, it reads more data from the file descriptor until a newline
- * is found or the end of the file is reached.
+ * Wrapper around ft_gnl_next() keeping one reader of BUFFER_SIZE bytes per
+ * file descriptor below GNL_MAX_FD, so several descriptors can be read in
+ * turn and from several threads.
  *
- * @param fd: The file descriptor to read from.
+ * @param fd: The file descriptor to read from, or -1 to free every reader.
+ *            Freeing must not race with other calls.
  *
  * @return A pointer to the line read from the file descriptor, or NULL if
  *         there is no more data to read or an error occurs.
@@ -6,32 +6,64 @@
 /*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/09/23 18:26:58 by pabmart2          #+#    #+#             */
-/*   Updated: 2025/03/31 22:04:10 by pabmart2         ###   ########.fr       */
+/*   Updated: 2026/10/17 09:18:48 by pabmart2         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #ifndef FT_PRINTF_H
 # define FT_PRINTF_H
 
+# include <errno.h>
+# include <limits.h>
 # include <stdarg.h>
 # include <stddef.h>
+# include <sys/uio.h>
+# include <unistd.h>
 # include "libft.h"
 
+/**
+ * @brief Size of the stack buffer used by ft_printf() and ft_dprintf(). A
+ *        call whose output fits in it issues a single write(2).
+ */
+# define FT_PRINTF_BUF 4096
+
+/**
+ * @struct s_outbuf
+ * @brief Output buffer the printers format into.
+ *
+ * Bound to a file descriptor, the buffer is written out with writev(2) when
+ * it fills up and on ft_outbuf_flush(). With fd -1 it is a string: the
+ * output is truncated to size - 1 bytes and NUL-terminated on flush.
+ *
+ * @param fd Destination descriptor, or -1 for a string.
+ * @param buf Storage of the buffer, provided by the caller.
+ * @param size Capacity of buf.
+ * @param len Number of bytes held in buf.
+ * @param total Number of bytes formatted so far, truncated or not.
+ * @param error Set once a write fails. Later output is discarded.
+ */
+typedef struct s_outbuf
+{
+	int			fd;
+	char		*buf;
+	size_t		size;
+	size_t		len;
+	size_t		total;
+	int			error;
+}				t_outbuf;
+
 /**
  * @typedef t_printer
- * @brief A function pointer type for functions that take a va_list argument
- *        and return an int.
+ * @brief A function that formats the next argument of a variadic list into
+ *        an output buffer.
  *
- * This typedef defines a function pointer type named t_printer. Functions of
- * this type are expected to take a single argument of type va_list and return
- * an int. This is typically used for functions that perform some kind of
- * formatted output or processing based on a variable argument list.
+ * The list is passed by address so every conversion consumes its argument
+ * from the same list.
  *
- * @param va_list A variable argument list.
- * @return An integer result, typically indicating the number of characters
- *         printed or a status code.
+ * @param out The output buffer.
+ * @param args The variadic argument list.
  */
-typedef int		(*t_printer)(va_list);
+typedef void	(*t_printer)(t_outbuf *out, va_list *args);
 
 /**
  * @struct s_printers_list
@@ -55,20 +87,84 @@ typedef struct s_printers_list
  * @file ft_printf.c
  * @brief Custom implementation of the printf function.
  *
- * This function mimics the behavior of the standard printf function, allowing
- * formatted output to the standard output.
+ * The output is formatted into a stack buffer of FT_PRINTF_BUF bytes, so a
+ * short call issues a single write(2).
+ *
+ * @param str The format string. Supports %c, %s, %p, %d, %i, %u, %x, %X and
+ *            %%. Any other conversion is printed as is.
+ * @param ... The arguments of the conversions.
+ *
+ * @return The number of characters written, or -1 on a write error.
+ */
+int				ft_printf(char const *str, ...)
+				__attribute__((format(printf, 1, 2)));
+
+/**
+ * @brief Like ft_printf(), writing to the given file descriptor.
  *
- * @param str The format string containing the text to be written to stdout.
- *            It can optionally contain embedded format specifiers that will
- *            be replaced by the values specified in subsequent arguments.
- * @param ... The variable arguments to be formatted and printed according to
- *            the format specifiers in the format string.
+ * @param fd The destination file descriptor.
+ * @param str The format string.
+ * @param ... The arguments of the conversions.
+ * @return The number of characters written, or -1 on a write error.
+ */
+int				ft_dprintf(int fd, char const *str, ...)
+				__attribute__((format(printf, 2, 3)));
+
+/**
+ * @brief Like ft_dprintf(), taking a va_list.
  *
- * @return The total number of characters written to the standard output.
+ * @param fd The destination file descriptor.
+ * @param str The format string.
+ * @param args The arguments of the conversions.
+ * @return The number of characters written, or -1 on a write error.
+ */
+int				ft_vdprintf(int fd, char const *str, va_list args);
+
+/**
+ * @brief Formats into a string, writing at most size bytes including the
+ *        terminating NUL.
+ *
+ * @param dst The destination string. May be NULL if size is 0.
+ * @param size The size of dst.
+ * @param str The format string.
+ * @param ... The arguments of the conversions.
+ * @return The length the whole output would have, so a result >= size means
+ *         it was truncated.
+ */
+int				ft_snprintf(char *dst, size_t size, char const *str, ...)
+				__attribute__((format(printf, 3, 4)));
+
+/**
+ * @brief Like ft_snprintf(), taking a va_list.
  *
+ * @param dst The destination string. May be NULL if size is 0.
+ * @param size The size of dst.
+ * @param str The format string.
+ * @param args The arguments of the conversions.
+ * @return The length the whole output would have.
  */
-int				ft_printf(char const *str, ...) __attribute__((format(printf, 1,
-							2)));
+int				ft_vsnprintf(char *dst, size_t size, char const *str,
+					va_list args);
+
+/**
+ * @brief Formats into an output buffer without flushing it, so several calls
+ *        can be gathered into a single write.
+ *
+ * @param out The output buffer.
+ * @param str The format string.
+ * @param ... The arguments of the conversions.
+ */
+void			ft_bprintf(t_outbuf *out, char const *str, ...)
+				__attribute__((format(printf, 2, 3)));
+
+/**
+ * @brief Like ft_bprintf(), taking a va_list.
+ *
+ * @param out The output buffer.
+ * @param str The format string.
+ * @param args The arguments of the conversions. Left untouched.
+ */
+void			ft_vbprintf(t_outbuf *out, char const *str, va_list args);
 
 /**
  * @brief Checks and returns the appropriate printer function for a given
@@ -83,102 +179,113 @@ int				ft_printf(char const *str, ...) __attribute__((format(printf, 1,
  */
 t_printer		check_printer(const char c);
 
-/****************************** PRINTERS **************************************/
+/****************************** OUTBUF ****************************************/
 
 /**
- * @brief Prints a character from a variadic argument list.
+ * @brief Binds an output buffer to a descriptor, or to a string if fd is -1.
  *
- * This function retrieves a character from the provided variadic argument
- * list, prints it to the standard output using ft_putchar_fd, and returns 1.
- *
- * @param arg The variadic argument list containing the character to print.
- * @return Always returns 1.
+ * @param out The buffer to initialise.
+ * @param fd The destination descriptor, or -1.
+ * @param buf Storage of the buffer, or the destination string.
+ * @param size The size of buf.
  */
-int				c_printer(va_list arg);
+void			ft_outbuf_init(t_outbuf *out, int fd, char *buf, size_t size);
 
 /**
- * @brief Prints a string from a variadic argument list.
- * @param arg The variadic argument list containing the string to print.
- *
- * This function retrieves a string from the provided variadic argument list,
- * prints it to the standard output using ft_putstr_fd, and returns the length
- * of the string.
+ * @brief Appends bytes to an output buffer. When they do not fit, the
+ *        buffered bytes and mem are written together with one writev(2).
  *
- * @return The length of the printed string.
+ * @param out The output buffer.
+ * @param mem The bytes to append.
+ * @param len The number of bytes.
  */
-int				s_printer(va_list arg);
+void			ft_outbuf_put(t_outbuf *out, const char *mem, size_t len);
 
 /**
- * @brief Prints a pointer address in hexadecimal format.
- *
- * This function retrieves a pointer from the provided va_list, converts it
- * to a hexadecimal string representation, and prints it prefixed with "0x".
- * It returns the total number of characters printed, including the "0x" prefix.
+ * @brief Appends an unsigned number written in the given base, without
+ *        allocating.
  *
- * @param arg A va_list containing the pointer to be printed.
- * Return: The number of characters printed.
+ * @param out The output buffer.
+ * @param n The number.
+ * @param base The digits of the base, at least two.
  */
-int				p_printer(va_list arg);
+void			ft_outbuf_num(t_outbuf *out, unsigned long n,
+					const char *base);
 
 /**
- * @brief Prints an integer argument as a string.
+ * @brief Writes out the buffered bytes, or NUL-terminates a string buffer.
  *
- * This function retrieves an integer from the provided va_list,
- * converts it to a string using ft_itoa, and prints it to the
- * standard output using ft_putstr_fd. It returns the length of
- * the printed string.
+ * @param out The output buffer.
+ * @return 0 on success, -1 if any write failed.
+ */
+int				ft_outbuf_flush(t_outbuf *out);
+
+/****************************** PRINTERS **************************************/
+
+/**
+ * @brief Prints a character.
  *
- * @param arg A va_list containing the integer to be printed.
- * Return: The length of the printed string.
+ * @param out The output buffer.
+ * @param args The argument list, holding the character as an int.
  */
-int				di_printer(va_list arg);
+void			c_printer(t_outbuf *out, va_list *args);
 
 /**
- * @brief Prints an unsigned integer from a variable argument list.
+ * @brief Prints a string, or "(null)" for a NULL pointer.
  *
- * This function retrieves an unsigned integer from the provided variable
- * argument list, converts it to a string using ft_uitoa, and prints it to
- * the standard output using ft_putstr_fd. It returns the length of the
- * printed string.
+ * @param out The output buffer.
+ * @param args The argument list, holding the string.
+ */
+void			s_printer(t_outbuf *out, va_list *args);
+
+/**
+ * @brief Prints a pointer in hexadecimal prefixed with "0x", or "(nil)" for
+ *        a NULL pointer.
  *
- * @param arg The variable argument list containing the unsigned integer
- *            to print.
- * @return The length of the printed string.
+ * @param out The output buffer.
+ * @param args The argument list, holding the pointer.
  */
-int				u_printer(va_list arg);
+void			p_printer(t_outbuf *out, va_list *args);
 
 /**
- * @brief Prints an unsigned integer in lowercase hexadecimal format.
+ * @brief Prints a signed integer in decimal.
  *
- * This function retrieves an unsigned integer from the provided va_list,
- * converts it to a string in lowercase hexadecimal format, and prints it
- * to the standard output. It returns the length of the printed string.
+ * @param out The output buffer.
+ * @param args The argument list, holding the int.
+ */
+void			di_printer(t_outbuf *out, va_list *args);
+
+/**
+ * @brief Prints an unsigned integer in decimal.
  *
- * @param arg A va_list containing the unsigned integer to be printed.
- * @return The length of the printed string.
+ * @param out The output buffer.
+ * @param args The argument list, holding the unsigned int.
  */
-int				x_low_printer(va_list arg);
+void			u_printer(t_outbuf *out, va_list *args);
 
 /**
- * @brief Prints an unsigned integer in uppercase hexadecimal format.
+ * @brief Prints an unsigned integer in lowercase hexadecimal.
  *
- * This function retrieves an unsigned integer from the provided va_list,
- * converts it to a string in uppercase hexadecimal format, and prints it
- * to the standard output. It returns the length of the printed string.
+ * @param out The output buffer.
+ * @param args The argument list, holding the unsigned int.
+ */
+void			x_low_printer(t_outbuf *out, va_list *args);
+
+/**
+ * @brief Prints an unsigned integer in uppercase hexadecimal.
  *
- * @param arg A va_list containing the unsigned integer to be printed.
- * @return The length of the printed string.
+ * @param out The output buffer.
+ * @param args The argument list, holding the unsigned int.
  */
-int				x_up_printer(va_list arg);
+void			x_up_printer(t_outbuf *out, va_list *args);
 
 /**
- * @brief - Prints a percent sign.
+ * @brief Prints a percent sign.
  *
- * This function prints a percent sign '%' to the standard output.
- * @param arg: A va_list of arguments (unused in this function).
- * @return Always returns 1
+ * @param out The output buffer.
+ * @param args The argument list, unused.
  */
-int				prct_printer(va_list arg);
+void			prct_printer(t_outbuf *out, va_list *args);
 
 /*******************************LIBFT******************************************/
 
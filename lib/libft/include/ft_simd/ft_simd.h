@@ -0,0 +1,111 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_simd.h                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 09:06:18 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 10:11:34 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef FT_SIMD_H
+# define FT_SIMD_H
+
+# include <stddef.h>
+# include <stdint.h>
+
+# define FT_SIMD_WORD 1
+# define FT_SIMD_SSE2 2
+# define FT_SIMD_AVX2 3
+# define FT_SIMD_PAGE 4096
+# define FT_WORD_ONES (~0UL / 0xFF)
+# define FT_WORD_HIGHS (FT_WORD_ONES << 7)
+
+# if defined(__SSE2__) && defined(__GNUC__) && defined(__x86_64__)
+#  define FT_SIMD_X86 1
+#  include <immintrin.h>
+#  define FT_AVX2 __attribute__((target("avx2")))
+# endif
+
+/**
+ * @brief A machine word that may alias any object, so buffers can be scanned
+ *        a word at a time.
+ */
+typedef unsigned long __attribute__((__may_alias__))	t_word;
+
+/**
+ * @struct s_simd
+ * @brief The implementations of the string and memory core picked for this
+ *        CPU, see ft_simd().
+ *
+ * Every member has the contract of the ft_ function of the same name,
+ * except that NULL arguments are not accepted.
+ *
+ * @param level
+ * FT_SIMD_WORD, FT_SIMD_SSE2 or FT_SIMD_AVX2, or 0 before the table is set.
+ */
+typedef struct s_simd
+{
+	size_t	(*strlen)(const char *s);
+	void	*(*memchr)(const void *s, int c, size_t n);
+	char	*(*strchr)(const char *s, int c);
+	int		(*strncmp)(const char *s1, const char *s2, size_t n);
+	int		(*memcmp)(const void *s1, const void *s2, size_t n);
+	void	*(*memcpy)(void *dest, const void *src, size_t n);
+	void	*(*memset)(void *s, int c, size_t n);
+	size_t	(*memcount)(const void *s, int c, size_t n);
+	int		level;
+}			t_simd;
+
+/**
+ * @brief Returns the implementations to use, picking them on first use.
+ *
+ * AVX2 is used if CPUID reports it, SSE2 on any other x86-64 CPU and the
+ * word-at-a-time versions elsewhere. The FT_SIMD environment variable can
+ * lower the level to "sse2" or "word", to compare or test them. The table
+ * is set at startup by a constructor, before any thread can race on it.
+ *
+ * @return The table, never NULL.
+ */
+const t_simd	*ft_simd(void);
+
+/*
+ * Word-at-a-time versions. Aligned words never cross a page, so reading a
+ * whole word past the terminator is safe.
+ */
+size_t			ft_strlen_word(const char *s);
+void			*ft_memchr_word(const void *s, int c, size_t n);
+char			*ft_strchr_word(const char *s, int c);
+int				ft_strncmp_word(const char *s1, const char *s2, size_t n);
+int				ft_memcmp_word(const void *s1, const void *s2, size_t n);
+void			*ft_memcpy_word(void *dest, const void *src, size_t n);
+void			*ft_memset_word(void *s, int c, size_t n);
+size_t			ft_memcount_word(const void *s, int c, size_t n);
+
+# ifdef FT_SIMD_X86
+
+/*
+ * SSE2 and AVX2 versions. Strings are scanned with aligned loads, and
+ * unaligned ones are only used within n bytes or within the current page.
+ */
+size_t			ft_strlen_sse2(const char *s);
+void			*ft_memchr_sse2(const void *s, int c, size_t n);
+char			*ft_strchr_sse2(const char *s, int c);
+int				ft_strncmp_sse2(const char *s1, const char *s2, size_t n);
+int				ft_memcmp_sse2(const void *s1, const void *s2, size_t n);
+void			*ft_memcpy_sse2(void *dest, const void *src, size_t n);
+void			*ft_memset_sse2(void *s, int c, size_t n);
+size_t			ft_memcount_sse2(const void *s, int c, size_t n);
+FT_AVX2 size_t	ft_strlen_avx2(const char *s);
+FT_AVX2 void	*ft_memchr_avx2(const void *s, int c, size_t n);
+FT_AVX2 char	*ft_strchr_avx2(const char *s, int c);
+FT_AVX2 int		ft_strncmp_avx2(const char *s1, const char *s2, size_t n);
+FT_AVX2 int		ft_memcmp_avx2(const void *s1, const void *s2, size_t n);
+FT_AVX2 void	*ft_memcpy_avx2(void *dest, const void *src, size_t n);
+FT_AVX2 void	*ft_memset_avx2(void *s, int c, size_t n);
+FT_AVX2 size_t	ft_memcount_avx2(const void *s, int c, size_t n);
+# endif
+
+#endif
@@ -6,7 +6,7 @@
 /*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/09/10 18:17:00 by pabmart2          #+#    #+#             */
-/*   Updated: 2025/05/14 20:32:43 by pabmart2         ###   ########.fr       */
+/*   Updated: 2026/10/17 10:11:34 by pabmart2         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -28,8 +28,10 @@
 # include <stdio.h>
 # include <stdlib.h>
 # include <unistd.h>
+# include "ft_arena/ft_arena.h"
 # include "ft_get_next_line/ft_get_next_line.h"
 # include "ft_printf/ft_printf.h"
+# include "ft_simd/ft_simd.h"
 /**
  * @brief A structure representing a node in a linked list.
  *
@@ -394,6 +396,17 @@ double				ft_matrix_mincol(double **array, size_t size, size_t pos);
  */
 void				*ft_memchr(const void *s, int c, size_t n);
 
+/**
+ * @brief Counts the occurrences of a byte in a block of memory.
+ *
+ * @param s Pointer to the block of memory to be scanned.
+ * @param c Value to be counted, treated as an unsigned char.
+ * @param n Number of bytes to be scanned.
+ *
+ * @return Number of bytes of the block equal to c.
+ */
+size_t				ft_memcount(const void *s, int c, size_t n);
+
 /**
  * @brief Compares two memory blocks.
  *
@@ -0,0 +1,94 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_arena.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 08:35:56 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 08:35:56 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "libft.h"
+
+void	ft_arena_init(t_arena *arena)
+{
+	ft_bzero(arena, sizeof(t_arena));
+}
+
+/**
+ * @brief Allocates a new chunk and makes it the current one.
+ *
+ * @param arena The arena.
+ * @param size Minimum capacity of the chunk.
+ * @return 0 on success, 1 if memory could not be allocated.
+ */
+static int	add_chunk(t_arena *arena, size_t size)
+{
+	t_arena_chunk	*chunk;
+
+	if (size < FT_ARENA_CHUNK)
+		size = FT_ARENA_CHUNK;
+	chunk = malloc(sizeof(t_arena_chunk) + size);
+	if (!chunk)
+		return (1);
+	chunk->prev = arena->chunk;
+	chunk->size = size;
+	chunk->used = 0;
+	arena->chunk = chunk;
+	arena->reserved += sizeof(t_arena_chunk) + size;
+	++arena->chunks;
+	return (0);
+}
+
+void	*ft_arena_alloc(t_arena *arena, size_t size)
+{
+	void	*ptr;
+
+	if (size > SIZE_MAX - FT_ARENA_ALIGN - sizeof(t_arena_chunk))
+	{
+		errno = ENOMEM;
+		return (NULL);
+	}
+	size = (size + FT_ARENA_ALIGN - 1) & ~(size_t)(FT_ARENA_ALIGN - 1);
+	if ((!arena->chunk || arena->chunk->size - arena->chunk->used < size)
+		&& add_chunk(arena, size))
+		return (NULL);
+	ptr = arena->chunk->data + arena->chunk->used;
+	arena->chunk->used += size;
+	arena->used += size;
+	if (arena->used > arena->peak)
+		arena->peak = arena->used;
+	return (ptr);
+}
+
+void	*ft_arena_calloc(t_arena *arena, size_t nmemb, size_t size)
+{
+	void	*ptr;
+
+	if (size && nmemb > SIZE_MAX / size)
+	{
+		errno = ENOMEM;
+		return (NULL);
+	}
+	ptr = ft_arena_alloc(arena, nmemb * size);
+	if (ptr)
+		ft_bzero(ptr, nmemb * size);
+	return (ptr);
+}
+
+void	ft_arena_destroy(t_arena *arena)
+{
+	t_arena_chunk	*prev;
+
+	while (arena->chunk)
+	{
+		prev = arena->chunk->prev;
+		free(arena->chunk);
+		arena->chunk = prev;
+	}
+	arena->used = 0;
+	arena->reserved = 0;
+	arena->chunks = 0;
+}
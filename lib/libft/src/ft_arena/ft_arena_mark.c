@@ -0,0 +1,42 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_arena_mark.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 08:35:56 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 08:35:56 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "libft.h"
+
+t_arena_mark	ft_arena_mark(t_arena *arena)
+{
+	t_arena_mark	mark;
+
+	mark.chunk = arena->chunk;
+	mark.chunk_used = 0;
+	if (arena->chunk)
+		mark.chunk_used = arena->chunk->used;
+	mark.used = arena->used;
+	return (mark);
+}
+
+void	ft_arena_reset(t_arena *arena, t_arena_mark mark)
+{
+	t_arena_chunk	*prev;
+
+	while (arena->chunk && arena->chunk != mark.chunk)
+	{
+		prev = arena->chunk->prev;
+		arena->reserved -= sizeof(t_arena_chunk) + arena->chunk->size;
+		--arena->chunks;
+		free(arena->chunk);
+		arena->chunk = prev;
+	}
+	if (arena->chunk)
+		arena->chunk->used = mark.chunk_used;
+	arena->used = mark.used;
+}
@@ -0,0 +1,92 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_arena_str.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 08:35:56 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 10:24:15 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "libft.h"
+
+char	*ft_arena_strdup(t_arena *arena, const char *s)
+{
+	char	*dup;
+	size_t	len;
+
+	len = ft_strlen(s);
+	dup = ft_arena_alloc(arena, len + 1);
+	if (!dup)
+		return (NULL);
+	ft_memcpy(dup, s, len + 1);
+	return (dup);
+}
+
+char	*ft_arena_strndup(t_arena *arena, const char *s, size_t n)
+{
+	char	*dup;
+	size_t	len;
+
+	len = 0;
+	while (len < n && s[len])
+		++len;
+	dup = ft_arena_alloc(arena, len + 1);
+	if (!dup)
+		return (NULL);
+	ft_memcpy(dup, s, len);
+	dup[len] = '\0';
+	return (dup);
+}
+
+/**
+ * @brief Walks the non-empty fields of a string, copying them if asked to.
+ *
+ * @param s The string.
+ * @param c The delimiter.
+ * @param fields Filled with a pointer to each field and a terminating NULL,
+ *               or NULL to only count them.
+ * @param bytes Where the NUL-terminated fields are written, one after the
+ *              other. Unused if fields is NULL.
+ * @return The number of fields.
+ */
+static size_t	walk_fields(const char *s, char c, char **fields, char *bytes)
+{
+	size_t	n;
+	size_t	len;
+
+	n = 0;
+	while (*s)
+	{
+		len = 0;
+		while (s[len] && s[len] != c)
+			++len;
+		if (len && fields)
+		{
+			fields[n] = bytes;
+			ft_memcpy(bytes, s, len);
+			bytes[len] = '\0';
+			bytes += len + 1;
+		}
+		n += (len != 0);
+		s += len + (s[len] == c);
+	}
+	if (fields)
+		fields[n] = NULL;
+	return (n);
+}
+
+char	**ft_arena_split(t_arena *arena, const char *s, char c)
+{
+	char	**fields;
+	size_t	n;
+
+	n = walk_fields(s, c, NULL, NULL);
+	fields = ft_arena_alloc(arena, (n + 1) * sizeof(char *) + ft_strlen(s)
+			+ 1);
+	if (fields)
+		walk_fields(s, c, fields, (char *)(fields + n + 1));
+	return (fields);
+}
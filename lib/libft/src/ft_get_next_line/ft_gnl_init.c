@@ -0,0 +1,65 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_gnl_init.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 08:58:56 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 08:58:56 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "libft.h"
+
+int	ft_gnl_init(t_gnl *reader, int fd, size_t size)
+{
+	pthread_mutexattr_t	attr;
+	int					status;
+
+	if (size == 0)
+		size = BUFFER_SIZE;
+	ft_bzero(reader, sizeof(t_gnl));
+	reader->fd = fd;
+	reader->cap = size;
+	reader->buf = malloc(size);
+	if (!reader->buf)
+		return (-1);
+	status = pthread_mutexattr_init(&attr);
+	if (status == 0)
+	{
+		status = pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+		if (status == 0)
+			status = pthread_mutex_init(&reader->lock, &attr);
+		pthread_mutexattr_destroy(&attr);
+	}
+	if (status != 0)
+		return (ft_free((void **)&reader->buf), -1);
+	return (0);
+}
+
+void	ft_gnl_destroy(t_gnl *reader)
+{
+	ft_free((void **)&reader->buf);
+	pthread_mutex_destroy(&reader->lock);
+}
+
+char	*ft_gnl_next(t_gnl *reader)
+{
+	const char	*view;
+	char		*line;
+	ssize_t		n;
+
+	pthread_mutex_lock(&reader->lock);
+	n = ft_gnl_view(reader, &view);
+	line = NULL;
+	if (n > 0)
+		line = malloc(n + 1);
+	if (line)
+	{
+		ft_memcpy(line, view, n);
+		line[n] = '\0';
+	}
+	pthread_mutex_unlock(&reader->lock);
+	return (line);
+}
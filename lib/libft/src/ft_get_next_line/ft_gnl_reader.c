@@ -0,0 +1,123 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_gnl_reader.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 08:58:56 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 08:58:56 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "libft.h"
+
+/**
+ * @brief Moves the unread data of a reader to the start of a new buffer.
+ *
+ * @param reader The reader.
+ * @param cap Capacity of the new buffer, at least reader->len.
+ * @return 0 on success, -1 if the buffer could not be allocated.
+ */
+static int	gnl_resize(t_gnl *reader, size_t cap)
+{
+	char	*buf;
+	size_t	first;
+
+	buf = malloc(cap);
+	if (!buf)
+		return (-1);
+	first = reader->len;
+	if (reader->head + first > reader->cap)
+		first = reader->cap - reader->head;
+	ft_memcpy(buf, reader->buf + reader->head, first);
+	ft_memcpy(buf + first, reader->buf, reader->len - first);
+	free(reader->buf);
+	reader->buf = buf;
+	reader->cap = cap;
+	reader->head = 0;
+	return (0);
+}
+
+/**
+ * @brief Reads into the free space that follows the unread data, growing the
+ *        buffer first if it is full.
+ *
+ * @param reader The reader.
+ * @return Bytes read, 0 at end of file or -1 on error.
+ */
+static ssize_t	gnl_fill(t_gnl *reader)
+{
+	size_t	tail;
+	size_t	room;
+	ssize_t	n;
+
+	if (reader->len == reader->cap
+		&& gnl_resize(reader, reader->cap * 2) == -1)
+		return (-1);
+	if (reader->len == 0)
+		reader->head = 0;
+	tail = (reader->head + reader->len) % reader->cap;
+	room = reader->cap - tail;
+	if (tail < reader->head)
+		room = reader->head - tail;
+	n = read(reader->fd, reader->buf + tail, room);
+	if (n > 0)
+		reader->len += n;
+	return (n);
+}
+
+/**
+ * @brief Looks for a newline in the unread data not scanned yet.
+ *
+ * @param reader The reader. Its scanned count is advanced.
+ * @return Length of the first line, newline included, or 0 if there is no
+ *         complete line.
+ */
+static size_t	gnl_find(t_gnl *reader)
+{
+	size_t	pos;
+	size_t	seg;
+	char	*nl;
+
+	while (reader->scanned < reader->len)
+	{
+		pos = (reader->head + reader->scanned) % reader->cap;
+		seg = reader->cap - pos;
+		if (seg > reader->len - reader->scanned)
+			seg = reader->len - reader->scanned;
+		nl = ft_memchr(reader->buf + pos, '\n', seg);
+		if (nl)
+			return (reader->scanned + (nl - (reader->buf + pos)) + 1);
+		reader->scanned += seg;
+	}
+	return (0);
+}
+
+ssize_t	ft_gnl_view(t_gnl *reader, const char **line)
+{
+	size_t	n;
+	ssize_t	got;
+
+	pthread_mutex_lock(&reader->lock);
+	n = gnl_find(reader);
+	got = 1;
+	while (n == 0 && got > 0)
+	{
+		got = gnl_fill(reader);
+		n = gnl_find(reader);
+	}
+	if (got == -1)
+		return (pthread_mutex_unlock(&reader->lock), -1);
+	if (n == 0)
+		n = reader->len;
+	if (reader->head + n > reader->cap
+		&& gnl_resize(reader, reader->cap) == -1)
+		return (pthread_mutex_unlock(&reader->lock), -1);
+	*line = reader->buf + reader->head;
+	reader->head = (reader->head + n) % reader->cap;
+	reader->len -= n;
+	reader->scanned = 0;
+	pthread_mutex_unlock(&reader->lock);
+	return (n);
+}
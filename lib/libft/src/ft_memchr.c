@@ -6,7 +6,7 @@
 /*   By: pablo <pablo@student.42.fr>                +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/09/11 13:35:21 by pabmart2          #+#    #+#             */
-/*   Updated: 2025/03/13 20:22:05 by pablo            ###   ########.fr       */
+/*   Updated: 2026/10/17 09:06:18 by pabmart2         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -14,16 +14,5 @@
 
 void	*ft_memchr(const void *s, int c, size_t n)
 {
-	const unsigned char	*temp_s;
-	unsigned char		temp_c;
-
-	temp_s = (const unsigned char *)s;
-	temp_c = (unsigned char)c;
-	while (n--)
-	{
-		if (*temp_s == temp_c)
-			return ((void *)temp_s);
-		++temp_s;
-	}
-	return (NULL);
+	return (ft_simd()->memchr(s, c, n));
 }
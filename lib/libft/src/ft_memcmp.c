@@ -6,7 +6,7 @@
 /*   By: pablo <pablo@student.42.fr>                +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/09/11 13:58:41 by pabmart2          #+#    #+#             */
-/*   Updated: 2025/03/13 20:22:05 by pablo            ###   ########.fr       */
+/*   Updated: 2026/10/17 09:06:18 by pabmart2         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -14,17 +14,5 @@
 
 int	ft_memcmp(const void *s1, const void *s2, size_t n)
 {
-	const unsigned char	*temp_s1;
-	const unsigned char	*temp_s2;
-
-	temp_s1 = (const unsigned char *)s1;
-	temp_s2 = (const unsigned char *)s2;
-	while (n--)
-	{
-		if (*temp_s1 != *temp_s2)
-			return (*temp_s1 - *temp_s2);
-		++temp_s1;
-		++temp_s2;
-	}
-	return (0);
+	return (ft_simd()->memcmp(s1, s2, n));
 }
@@ -6,7 +6,7 @@
 /*   By: pablo <pablo@student.42.fr>                +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/09/10 20:49:48 by pabmart2          #+#    #+#             */
-/*   Updated: 2025/03/13 20:22:05 by pablo            ###   ########.fr       */
+/*   Updated: 2026/10/17 09:06:18 by pabmart2         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -14,14 +14,7 @@
 
 void	*ft_memcpy(void *dest, const void *src, size_t n)
 {
-	char		*temp_dest;
-	const char	*temp_src;
-
 	if (!dest && !src)
 		return (NULL);
-	temp_dest = (char *)dest;
-	temp_src = (const char *)src;
-	while (n--)
-		*(temp_dest++) = *(temp_src++);
-	return (dest);
+	return (ft_simd()->memcpy(dest, src, n));
 }
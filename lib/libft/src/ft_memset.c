@@ -6,7 +6,7 @@
 /*   By: pablo <pablo@student.42.fr>                +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/09/10 20:11:59 by pabmart2          #+#    #+#             */
-/*   Updated: 2025/03/13 20:22:05 by pablo            ###   ########.fr       */
+/*   Updated: 2026/10/17 09:06:18 by pabmart2         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -14,16 +14,5 @@
 
 void	*ft_memset(void *s, int c, size_t n)
 {
-	char	*temp_s;
-	char	byte;
-
-	temp_s = (char *)s;
-	byte = (char)c;
-	while (n > 0)
-	{
-		*temp_s = byte;
-		--n;
-		++temp_s;
-	}
-	return (s);
+	return (ft_simd()->memset(s, c, n));
 }
@@ -6,7 +6,7 @@
 /*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/09/25 15:42:26 by pabmart2          #+#    #+#             */
-/*   Updated: 2025/03/14 16:22:35 by pabmart2         ###   ########.fr       */
+/*   Updated: 2026/10/17 09:18:49 by pabmart2         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -27,7 +27,7 @@
  * - 'c': c_printer
  * - 's': s_printer
  * - 'p': p_printer
- * - 'd': d_printer
+ * - 'd', 'i': di_printer
  * - 'u': u_printer
  * - 'x': x_low_printer
  * - 'X': x_up_printer
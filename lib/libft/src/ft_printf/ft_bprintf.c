@@ -0,0 +1,65 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_bprintf.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 09:14:08 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 09:14:08 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "ft_printf.h"
+
+void	ft_outbuf_num(t_outbuf *out, unsigned long n, const char *base)
+{
+	char	digits[64];
+	size_t	radix;
+	size_t	i;
+
+	radix = ft_strlen(base);
+	i = sizeof(digits);
+	digits[--i] = base[n % radix];
+	while (n >= radix)
+	{
+		n /= radix;
+		digits[--i] = base[n % radix];
+	}
+	ft_outbuf_put(out, digits + i, sizeof(digits) - i);
+}
+
+void	ft_vbprintf(t_outbuf *out, char const *str, va_list args)
+{
+	va_list		copy;
+	const char	*percent;
+	t_printer	printer;
+
+	va_copy(copy, args);
+	while (*str)
+	{
+		percent = ft_strchr(str, '%');
+		if (!percent)
+			percent = str + ft_strlen(str);
+		ft_outbuf_put(out, str, percent - str);
+		str = percent;
+		if (!*str || !*++str)
+			break ;
+		printer = check_printer(*str);
+		if (printer)
+			printer(out, &copy);
+		else
+			ft_outbuf_put(out, str - 1, 2);
+		++str;
+	}
+	va_end(copy);
+}
+
+void	ft_bprintf(t_outbuf *out, char const *str, ...)
+{
+	va_list	args;
+
+	va_start(args, str);
+	ft_vbprintf(out, str, args);
+	va_end(args);
+}
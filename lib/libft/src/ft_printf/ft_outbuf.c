@@ -0,0 +1,106 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_outbuf.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 09:14:08 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 09:14:08 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "ft_printf.h"
+
+/**
+ * @brief Consumes written bytes from the pending vectors.
+ *
+ * @param iov The two pending vectors.
+ * @param i Index of the first vector not fully written. Advanced past every
+ *          vector left empty.
+ * @param n Number of bytes written.
+ */
+static void	consume(struct iovec *iov, int *i, size_t n)
+{
+	while (*i < 2 && n >= iov[*i].iov_len)
+		n -= iov[(*i)++].iov_len;
+	if (*i < 2)
+	{
+		iov[*i].iov_base = (char *)iov[*i].iov_base + n;
+		iov[*i].iov_len -= n;
+	}
+}
+
+/**
+ * @brief Writes the buffered bytes followed by mem with a single writev(2)
+ *        when possible, retrying short writes, and empties the buffer.
+ *
+ * @param out The buffer, bound to a file descriptor.
+ * @param mem Bytes to write after the buffered ones, or NULL.
+ * @param len Number of bytes of mem.
+ */
+static void	drain(t_outbuf *out, const char *mem, size_t len)
+{
+	struct iovec	iov[2];
+	ssize_t			n;
+	int				i;
+
+	iov[0].iov_base = out->buf;
+	iov[0].iov_len = out->len;
+	iov[1].iov_base = (void *)mem;
+	iov[1].iov_len = len;
+	i = 0;
+	consume(iov, &i, 0);
+	while (!out->error && i < 2)
+	{
+		n = writev(out->fd, iov + i, 2 - i);
+		if (n == -1 && errno != EINTR)
+			out->error = 1;
+		else if (n > 0)
+			consume(iov, &i, n);
+	}
+	out->len = 0;
+}
+
+void	ft_outbuf_init(t_outbuf *out, int fd, char *buf, size_t size)
+{
+	out->fd = fd;
+	out->buf = buf;
+	out->size = size;
+	out->len = 0;
+	out->total = 0;
+	out->error = 0;
+}
+
+void	ft_outbuf_put(t_outbuf *out, const char *mem, size_t len)
+{
+	size_t	room;
+
+	out->total += len;
+	if (out->fd < 0)
+	{
+		room = 0;
+		if (out->size > out->len + 1)
+			room = out->size - out->len - 1;
+		if (len > room)
+			len = room;
+	}
+	else if (out->len + len > out->size)
+	{
+		drain(out, mem, len);
+		return ;
+	}
+	ft_memcpy(out->buf + out->len, mem, len);
+	out->len += len;
+}
+
+int	ft_outbuf_flush(t_outbuf *out)
+{
+	if (out->fd < 0 && out->size > 0)
+		out->buf[out->len] = '\0';
+	if (out->fd >= 0)
+		drain(out, NULL, 0);
+	if (out->error)
+		return (-1);
+	return (0);
+}
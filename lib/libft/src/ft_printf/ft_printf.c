@@ -1,53 +1,58 @@
-/* ************************************************************************** */
-/*                                                                            */
-/*                                                        :::      ::::::::   */
-/*   ft_printf.c                                        :+:      :+:    :+:   */
-/*                                                    +:+ +:+         +:+     */
-/*   By: pablo <pablo@student.42.fr>                +#+  +:+       +#+        */
-/*                                                +#+#+#+#+#+   +#+           */
-/*   Created: 2024/09/23 17:59:18 by pabmart2          #+#    #+#             */
-/*   Updated: 2025/03/13 20:23:54 by pablo            ###   ########.fr       */
-/*                                                                            */
-/* ************************************************************************** */
-
 #include "ft_printf.h"
 
-static int	call_printer(char const *str, va_list args)
+int	ft_vdprintf(int fd, char const *str, va_list args)
+{
+	char		buf[FT_PRINTF_BUF];
+	t_outbuf	out;
+
+	ft_outbuf_init(&out, fd, buf, sizeof(buf));
+	ft_vbprintf(&out, str, args);
+	if (ft_outbuf_flush(&out) == -1 || out.total > INT_MAX)
+		return (-1);
+	return (out.total);
+}
+
+int	ft_dprintf(int fd, char const *str, ...)
 {
-	int			char_counter;
-	t_printer	printer;
-
-	char_counter = 0;
-	printer = check_printer(*(str));
-	if (printer)
-		char_counter += printer(args);
-	else
-	{
-		ft_putchar_fd('%', 1);
-		ft_putchar_fd(*str, 1);
-		char_counter += 2;
-	}
-	return (char_counter);
+	va_list	args;
+	int		printed;
+
+	va_start(args, str);
+	printed = ft_vdprintf(fd, str, args);
+	va_end(args);
+	return (printed);
 }
 
 int	ft_printf(char const *str, ...)
 {
 	va_list	args;
-	int		char_counter;
+	int		printed;
+
+	va_start(args, str);
+	printed = ft_vdprintf(STDOUT_FILENO, str, args);
+	va_end(args);
+	return (printed);
+}
+
+int	ft_vsnprintf(char *dst, size_t size, char const *str, va_list args)
+{
+	t_outbuf	out;
+
+	ft_outbuf_init(&out, -1, dst, size);
+	ft_vbprintf(&out, str, args);
+	ft_outbuf_flush(&out);
+	if (out.total > INT_MAX)
+		return (-1);
+	return (out.total);
+}
+
+int	ft_snprintf(char *dst, size_t size, char const *str, ...)
+{
+	va_list	args;
+	int		printed;
 
-	char_counter = 0;
 	va_start(args, str);
-	while (*str)
-	{
-		if (*str != '%')
-		{
-			ft_putchar_fd(*str, 1);
-			++char_counter;
-		}
-		else
-			char_counter += call_printer(++str, args);
-		++str;
-	}
+	printed = ft_vsnprintf(dst, size, str, args);
 	va_end(args);
-	return (char_counter);
+	return (printed);
 }
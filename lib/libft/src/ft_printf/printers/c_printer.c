@@ -6,17 +6,16 @@
 /*   By: pablo <pablo@student.42.fr>                +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/09/25 12:15:53 by pabmart2          #+#    #+#             */
-/*   Updated: 2025/03/13 20:24:14 by pablo            ###   ########.fr       */
+/*   Updated: 2026/10/17 09:18:49 by pabmart2         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "ft_printf.h"
 
-int	c_printer(va_list arg)
+void	c_printer(t_outbuf *out, va_list *args)
 {
 	char	c;
 
-	c = (char)va_arg(arg, int);
-	ft_putchar_fd(c, 1);
-	return (1);
+	c = (char)va_arg(*args, int);
+	ft_outbuf_put(out, &c, 1);
 }
@@ -6,20 +6,21 @@
 /*   By: pablo <pablo@student.42.fr>                +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/09/25 19:57:48 by pabmart2          #+#    #+#             */
-/*   Updated: 2025/03/29 16:35:43 by pablo            ###   ########.fr       */
+/*   Updated: 2026/10/17 09:18:49 by pabmart2         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "ft_printf.h"
 
-int	di_printer(va_list arg)
+void	di_printer(t_outbuf *out, va_list *args)
 {
-	char	*str;
-	size_t	len;
+	long	n;
 
-	str = ft_itoa(va_arg(arg, int));
-	ft_putstr_fd(str, 1);
-	len = ft_strlen(str);
-	ft_free((void **)&str);
-	return (len);
+	n = va_arg(*args, int);
+	if (n < 0)
+	{
+		ft_outbuf_put(out, "-", 1);
+		n = -n;
+	}
+	ft_outbuf_num(out, n, "0123456789");
 }
@@ -6,15 +6,14 @@
 /*   By: pablo <pablo@student.42.fr>                +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/09/25 12:15:53 by pabmart2          #+#    #+#             */
-/*   Updated: 2025/03/13 20:24:14 by pablo            ###   ########.fr       */
+/*   Updated: 2026/10/17 09:18:49 by pabmart2         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "ft_printf.h"
 
-int	prct_printer(va_list arg)
+void	prct_printer(t_outbuf *out, va_list *args)
 {
-	(void)arg;
-	ft_putchar_fd('%', 1);
-	return (1);
+	(void)args;
+	ft_outbuf_put(out, "%", 1);
 }
@@ -6,25 +6,18 @@
 /*   By: pablo <pablo@student.42.fr>                +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/09/25 12:15:53 by pabmart2          #+#    #+#             */
-/*   Updated: 2025/03/13 20:24:14 by pablo            ###   ########.fr       */
+/*   Updated: 2026/10/17 09:18:49 by pabmart2         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "ft_printf.h"
 
-int	s_printer(va_list arg)
+void	s_printer(t_outbuf *out, va_list *args)
 {
 	char	*str;
 
-	str = (char *)va_arg(arg, int *);
-	if (str)
-	{
-		ft_putstr_fd(str, 1);
-		return (ft_strlen(str));
-	}
-	else
-	{
-		ft_putstr_fd("(null)", 1);
-		return (6);
-	}
+	str = va_arg(*args, char *);
+	if (!str)
+		str = "(null)";
+	ft_outbuf_put(out, str, ft_strlen(str));
 }
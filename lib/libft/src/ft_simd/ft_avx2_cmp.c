@@ -0,0 +1,103 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_avx2_cmp.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 09:06:18 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 09:06:18 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "libft.h"
+
+#ifdef FT_SIMD_X86
+
+/**
+ * @brief Finds where two strings stop matching within 32 bytes.
+ *
+ * @param s1 The first string.
+ * @param s2 The second string.
+ * @return Index of the first byte that differs or ends s1, or 32.
+ */
+static FT_AVX2 size_t	stop_index(const char *s1, const char *s2)
+{
+	__m256i			a;
+	__m256i			b;
+	unsigned int	mask;
+
+	a = _mm256_loadu_si256((const __m256i *)s1);
+	b = _mm256_loadu_si256((const __m256i *)s2);
+	mask = (_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)) ^ 0xFFFFFFFFU)
+		| _mm256_movemask_epi8(_mm256_cmpeq_epi8(a, _mm256_setzero_si256()));
+	if (!mask)
+		return (32);
+	return (__builtin_ctz(mask));
+}
+
+/**
+ * @brief Tells whether 32 bytes can be loaded from a string without crossing
+ *        into the next page, which may not be mapped.
+ *
+ * @param p Start of the load.
+ * @return Non-zero if the load stays in the page of p.
+ */
+static FT_AVX2 int	in_page(const char *p)
+{
+	return (FT_SIMD_PAGE - ((uintptr_t)p & (FT_SIMD_PAGE - 1)) >= 32);
+}
+
+FT_AVX2 int	ft_strncmp_avx2(const char *s1, const char *s2, size_t n)
+{
+	size_t	i;
+	size_t	step;
+
+	i = 0;
+	while (i < n)
+	{
+		if (n - i >= 32 && in_page(s1 + i) && in_page(s2 + i))
+		{
+			step = stop_index(s1 + i, s2 + i);
+			i += step;
+			if (step < 32)
+				break ;
+		}
+		else if (s1[i] != s2[i] || !s1[i])
+			break ;
+		else
+			++i;
+	}
+	if (i >= n)
+		return (0);
+	return ((unsigned char)s1[i] - (unsigned char)s2[i]);
+}
+
+FT_AVX2 int	ft_memcmp_avx2(const void *s1, const void *s2, size_t n)
+{
+	const unsigned char	*a;
+	const unsigned char	*b;
+	size_t				i;
+	unsigned int		mask;
+
+	a = s1;
+	b = s2;
+	i = 0;
+	while (n - i >= 32)
+	{
+		mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(
+					_mm256_loadu_si256((const __m256i *)(a + i)),
+					_mm256_loadu_si256((const __m256i *)(b + i))));
+		mask ^= 0xFFFFFFFFU;
+		if (mask)
+			return (a[i + __builtin_ctz(mask)] - b[i + __builtin_ctz(mask)]);
+		i += 32;
+	}
+	while (i < n && a[i] == b[i])
+		++i;
+	if (i == n)
+		return (0);
+	return (a[i] - b[i]);
+}
+
+#endif
@@ -0,0 +1,80 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_avx2_mem.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 09:06:18 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 10:11:34 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "libft.h"
+
+#ifdef FT_SIMD_X86
+
+FT_AVX2 void	*ft_memcpy_avx2(void *dest, const void *src, size_t n)
+{
+	unsigned char		*d;
+	const unsigned char	*s;
+	__m256i				tail;
+	size_t				i;
+
+	if (n < 32)
+		return (ft_memcpy_sse2(dest, src, n));
+	d = dest;
+	s = src;
+	tail = _mm256_loadu_si256((const __m256i *)(s + n - 32));
+	i = 0;
+	while (n - i >= 32)
+	{
+		_mm256_storeu_si256((__m256i *)(d + i),
+			_mm256_loadu_si256((const __m256i *)(s + i)));
+		i += 32;
+	}
+	_mm256_storeu_si256((__m256i *)(d + n - 32), tail);
+	return (dest);
+}
+
+FT_AVX2 void	*ft_memset_avx2(void *s, int c, size_t n)
+{
+	unsigned char	*p;
+	__m256i			fill;
+	size_t			i;
+
+	if (n < 32)
+		return (ft_memset_sse2(s, c, n));
+	p = s;
+	fill = _mm256_set1_epi8((char)c);
+	i = 0;
+	while (n - i >= 32)
+	{
+		_mm256_storeu_si256((__m256i *)(p + i), fill);
+		i += 32;
+	}
+	_mm256_storeu_si256((__m256i *)(p + n - 32), fill);
+	return (s);
+}
+
+FT_AVX2 size_t	ft_memcount_avx2(const void *s, int c, size_t n)
+{
+	const unsigned char	*p;
+	__m256i				needle;
+	size_t				count;
+	size_t				i;
+
+	p = s;
+	needle = _mm256_set1_epi8((char)c);
+	count = 0;
+	i = 0;
+	while (n - i >= 32)
+	{
+		count += __builtin_popcount(_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+						_mm256_loadu_si256((const __m256i *)(p + i)), needle)));
+		i += 32;
+	}
+	return (count + ft_memcount_sse2(p + i, c, n - i));
+}
+
+#endif
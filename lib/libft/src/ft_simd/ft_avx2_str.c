@@ -0,0 +1,99 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_avx2_str.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 09:06:18 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 09:06:18 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "libft.h"
+
+#ifdef FT_SIMD_X86
+
+/**
+ * @brief Compares an aligned block of 32 bytes with a vector.
+ *
+ * @param p The block, aligned to 32 bytes.
+ * @param v The vector to compare with.
+ * @return A bit per byte, set where they are equal.
+ */
+static FT_AVX2 unsigned int	eq_mask(const char *p, __m256i v)
+{
+	return (_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+				_mm256_load_si256((const __m256i *)p), v)));
+}
+
+FT_AVX2 size_t	ft_strlen_avx2(const char *s)
+{
+	const char		*p;
+	unsigned int	mask;
+	__m256i			zero;
+
+	zero = _mm256_setzero_si256();
+	p = s - ((uintptr_t)s & 31);
+	mask = eq_mask(p, zero) >> ((uintptr_t)s & 31);
+	if (mask)
+		return (__builtin_ctz(mask));
+	while (!mask)
+	{
+		p += 32;
+		mask = eq_mask(p, zero);
+	}
+	return (p - s + __builtin_ctz(mask));
+}
+
+FT_AVX2 void	*ft_memchr_avx2(const void *s, int c, size_t n)
+{
+	const char		*base;
+	size_t			chunk;
+	unsigned int	mask;
+	__m256i			needle;
+
+	if (n == 0)
+		return (NULL);
+	needle = _mm256_set1_epi8((char)c);
+	base = s;
+	chunk = 32 - ((uintptr_t)base & 31);
+	mask = eq_mask(base - ((uintptr_t)base & 31), needle)
+		>> ((uintptr_t)base & 31);
+	while (1)
+	{
+		if (mask && (size_t)__builtin_ctz(mask) < n)
+			return ((void *)(base + __builtin_ctz(mask)));
+		if (n <= chunk)
+			return (NULL);
+		n -= chunk;
+		base += chunk;
+		chunk = 32;
+		mask = eq_mask(base, needle);
+	}
+}
+
+FT_AVX2 char	*ft_strchr_avx2(const char *s, int c)
+{
+	const char		*p;
+	unsigned int	mask;
+	__m256i			needle;
+	__m256i			zero;
+
+	needle = _mm256_set1_epi8((char)c);
+	zero = _mm256_setzero_si256();
+	p = s - ((uintptr_t)s & 31);
+	mask = (eq_mask(p, zero) | eq_mask(p, needle)) >> ((uintptr_t)s & 31);
+	p = s;
+	while (!mask)
+	{
+		p += 32 - ((uintptr_t)p & 31);
+		mask = eq_mask(p, zero) | eq_mask(p, needle);
+	}
+	p += __builtin_ctz(mask);
+	if (*p == (char)c)
+		return ((char *)p);
+	return (NULL);
+}
+
+#endif
@@ -0,0 +1,118 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_simd.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 09:06:18 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 10:11:34 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "libft.h"
+
+/**
+ * @brief Fills the table with the portable word-at-a-time versions.
+ *
+ * @param simd The table.
+ */
+static void	set_word(t_simd *simd)
+{
+	simd->strlen = ft_strlen_word;
+	simd->memchr = ft_memchr_word;
+	simd->strchr = ft_strchr_word;
+	simd->strncmp = ft_strncmp_word;
+	simd->memcmp = ft_memcmp_word;
+	simd->memcpy = ft_memcpy_word;
+	simd->memset = ft_memset_word;
+	simd->memcount = ft_memcount_word;
+	simd->level = FT_SIMD_WORD;
+}
+
+/**
+ * @brief Fills the table with the SSE2 or AVX2 versions.
+ *
+ * @param simd The table.
+ * @param level FT_SIMD_SSE2 or FT_SIMD_AVX2. Anything else leaves the table
+ *              untouched.
+ */
+#ifdef FT_SIMD_X86
+
+static void	set_x86(t_simd *simd, int level)
+{
+	if (level == FT_SIMD_SSE2)
+	{
+		simd->strlen = ft_strlen_sse2;
+		simd->memchr = ft_memchr_sse2;
+		simd->strchr = ft_strchr_sse2;
+		simd->strncmp = ft_strncmp_sse2;
+		simd->memcmp = ft_memcmp_sse2;
+		simd->memcpy = ft_memcpy_sse2;
+		simd->memset = ft_memset_sse2;
+		simd->memcount = ft_memcount_sse2;
+	}
+	if (level == FT_SIMD_AVX2)
+	{
+		simd->strlen = ft_strlen_avx2;
+		simd->memchr = ft_memchr_avx2;
+		simd->strchr = ft_strchr_avx2;
+		simd->strncmp = ft_strncmp_avx2;
+		simd->memcmp = ft_memcmp_avx2;
+		simd->memcpy = ft_memcpy_avx2;
+		simd->memset = ft_memset_avx2;
+		simd->memcount = ft_memcount_avx2;
+	}
+	simd->level = level;
+}
+#endif
+
+/**
+ * @brief Finds the best level supported by the CPU, capped by FT_SIMD.
+ *
+ * @return FT_SIMD_WORD, FT_SIMD_SSE2 or FT_SIMD_AVX2.
+ */
+static int	simd_level(void)
+{
+	int		level;
+	char	*cap;
+
+	level = FT_SIMD_WORD;
+#ifdef FT_SIMD_X86
+	level = FT_SIMD_SSE2;
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))
+		level = FT_SIMD_AVX2;
+#endif
+	cap = ft_getenv("FT_SIMD");
+	if (cap && ft_strncmp(cap, "word", 5) == 0)
+		level = FT_SIMD_WORD;
+	else if (cap && ft_strncmp(cap, "sse2", 5) == 0 && level > FT_SIMD_SSE2)
+		level = FT_SIMD_SSE2;
+	return (level);
+}
+
+const t_simd	*ft_simd(void)
+{
+	static t_simd	simd;
+	int				level;
+
+	if (simd.level == 0)
+	{
+		set_word(&simd);
+		level = simd_level();
+#ifdef FT_SIMD_X86
+		if (level != FT_SIMD_WORD)
+			set_x86(&simd, level);
+#endif
+	}
+	return (&simd);
+}
+
+/**
+ * @brief Picks the implementations at startup, see ft_simd().
+ */
+__attribute__((constructor)) static void	simd_startup(void)
+{
+	ft_simd();
+}
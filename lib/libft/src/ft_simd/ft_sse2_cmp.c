@@ -0,0 +1,103 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_sse2_cmp.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 09:06:18 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 09:06:18 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "libft.h"
+
+#ifdef FT_SIMD_X86
+
+/**
+ * @brief Finds where two strings stop matching within 16 bytes.
+ *
+ * @param s1 The first string.
+ * @param s2 The second string.
+ * @return Index of the first byte that differs or ends s1, or 16.
+ */
+static size_t	stop_index(const char *s1, const char *s2)
+{
+	__m128i			a;
+	__m128i			b;
+	unsigned int	mask;
+
+	a = _mm_loadu_si128((const __m128i *)s1);
+	b = _mm_loadu_si128((const __m128i *)s2);
+	mask = (_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) ^ 0xFFFF)
+		| _mm_movemask_epi8(_mm_cmpeq_epi8(a, _mm_setzero_si128()));
+	if (!mask)
+		return (16);
+	return (__builtin_ctz(mask));
+}
+
+/**
+ * @brief Tells whether 16 bytes can be loaded from a string without crossing
+ *        into the next page, which may not be mapped.
+ *
+ * @param p Start of the load.
+ * @return Non-zero if the load stays in the page of p.
+ */
+static int	in_page(const char *p)
+{
+	return (FT_SIMD_PAGE - ((uintptr_t)p & (FT_SIMD_PAGE - 1)) >= 16);
+}
+
+int	ft_strncmp_sse2(const char *s1, const char *s2, size_t n)
+{
+	size_t	i;
+	size_t	step;
+
+	i = 0;
+	while (i < n)
+	{
+		if (n - i >= 16 && in_page(s1 + i) && in_page(s2 + i))
+		{
+			step = stop_index(s1 + i, s2 + i);
+			i += step;
+			if (step < 16)
+				break ;
+		}
+		else if (s1[i] != s2[i] || !s1[i])
+			break ;
+		else
+			++i;
+	}
+	if (i >= n)
+		return (0);
+	return ((unsigned char)s1[i] - (unsigned char)s2[i]);
+}
+
+int	ft_memcmp_sse2(const void *s1, const void *s2, size_t n)
+{
+	const unsigned char	*a;
+	const unsigned char	*b;
+	size_t				i;
+	unsigned int		mask;
+
+	a = s1;
+	b = s2;
+	i = 0;
+	while (n - i >= 16)
+	{
+		mask = _mm_movemask_epi8(_mm_cmpeq_epi8(
+					_mm_loadu_si128((const __m128i *)(a + i)),
+					_mm_loadu_si128((const __m128i *)(b + i))));
+		mask ^= 0xFFFF;
+		if (mask)
+			return (a[i + __builtin_ctz(mask)] - b[i + __builtin_ctz(mask)]);
+		i += 16;
+	}
+	while (i < n && a[i] == b[i])
+		++i;
+	if (i == n)
+		return (0);
+	return (a[i] - b[i]);
+}
+
+#endif
@@ -0,0 +1,80 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_sse2_mem.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 09:06:18 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 10:11:34 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "libft.h"
+
+#ifdef FT_SIMD_X86
+
+void	*ft_memcpy_sse2(void *dest, const void *src, size_t n)
+{
+	unsigned char		*d;
+	const unsigned char	*s;
+	__m128i				tail;
+	size_t				i;
+
+	if (n < 16)
+		return (ft_memcpy_word(dest, src, n));
+	d = dest;
+	s = src;
+	tail = _mm_loadu_si128((const __m128i *)(s + n - 16));
+	i = 0;
+	while (n - i >= 16)
+	{
+		_mm_storeu_si128((__m128i *)(d + i),
+			_mm_loadu_si128((const __m128i *)(s + i)));
+		i += 16;
+	}
+	_mm_storeu_si128((__m128i *)(d + n - 16), tail);
+	return (dest);
+}
+
+void	*ft_memset_sse2(void *s, int c, size_t n)
+{
+	unsigned char	*p;
+	__m128i			fill;
+	size_t			i;
+
+	if (n < 16)
+		return (ft_memset_word(s, c, n));
+	p = s;
+	fill = _mm_set1_epi8((char)c);
+	i = 0;
+	while (n - i >= 16)
+	{
+		_mm_storeu_si128((__m128i *)(p + i), fill);
+		i += 16;
+	}
+	_mm_storeu_si128((__m128i *)(p + n - 16), fill);
+	return (s);
+}
+
+size_t	ft_memcount_sse2(const void *s, int c, size_t n)
+{
+	const unsigned char	*p;
+	__m128i				needle;
+	size_t				count;
+	size_t				i;
+
+	p = s;
+	needle = _mm_set1_epi8((char)c);
+	count = 0;
+	i = 0;
+	while (n - i >= 16)
+	{
+		count += __builtin_popcount(_mm_movemask_epi8(_mm_cmpeq_epi8(
+						_mm_loadu_si128((const __m128i *)(p + i)), needle)));
+		i += 16;
+	}
+	return (count + ft_memcount_word(p + i, c, n - i));
+}
+
+#endif
@@ -0,0 +1,99 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_sse2_str.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 09:06:18 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 09:06:18 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "libft.h"
+
+#ifdef FT_SIMD_X86
+
+/**
+ * @brief Compares an aligned block of 16 bytes with a vector.
+ *
+ * @param p The block, aligned to 16 bytes.
+ * @param v The vector to compare with.
+ * @return A bit per byte, set where they are equal.
+ */
+static unsigned int	eq_mask(const char *p, __m128i v)
+{
+	return (_mm_movemask_epi8(_mm_cmpeq_epi8(
+				_mm_load_si128((const __m128i *)p), v)));
+}
+
+size_t	ft_strlen_sse2(const char *s)
+{
+	const char		*p;
+	unsigned int	mask;
+	__m128i			zero;
+
+	zero = _mm_setzero_si128();
+	p = s - ((uintptr_t)s & 15);
+	mask = eq_mask(p, zero) >> ((uintptr_t)s & 15);
+	if (mask)
+		return (__builtin_ctz(mask));
+	while (!mask)
+	{
+		p += 16;
+		mask = eq_mask(p, zero);
+	}
+	return (p - s + __builtin_ctz(mask));
+}
+
+void	*ft_memchr_sse2(const void *s, int c, size_t n)
+{
+	const char		*base;
+	size_t			chunk;
+	unsigned int	mask;
+	__m128i			needle;
+
+	if (n == 0)
+		return (NULL);
+	needle = _mm_set1_epi8((char)c);
+	base = s;
+	chunk = 16 - ((uintptr_t)base & 15);
+	mask = eq_mask(base - ((uintptr_t)base & 15), needle)
+		>> ((uintptr_t)base & 15);
+	while (1)
+	{
+		if (mask && (size_t)__builtin_ctz(mask) < n)
+			return ((void *)(base + __builtin_ctz(mask)));
+		if (n <= chunk)
+			return (NULL);
+		n -= chunk;
+		base += chunk;
+		chunk = 16;
+		mask = eq_mask(base, needle);
+	}
+}
+
+char	*ft_strchr_sse2(const char *s, int c)
+{
+	const char		*p;
+	unsigned int	mask;
+	__m128i			needle;
+	__m128i			zero;
+
+	needle = _mm_set1_epi8((char)c);
+	zero = _mm_setzero_si128();
+	p = s - ((uintptr_t)s & 15);
+	mask = (eq_mask(p, zero) | eq_mask(p, needle)) >> ((uintptr_t)s & 15);
+	p = s;
+	while (!mask)
+	{
+		p += 16 - ((uintptr_t)p & 15);
+		mask = eq_mask(p, zero) | eq_mask(p, needle);
+	}
+	p += __builtin_ctz(mask);
+	if (*p == (char)c)
+		return ((char *)p);
+	return (NULL);
+}
+
+#endif
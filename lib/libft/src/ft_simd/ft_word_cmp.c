@@ -0,0 +1,77 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_word_cmp.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 09:06:18 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 09:06:18 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "libft.h"
+
+/**
+ * @brief Counts the bytes of the leading aligned words that are equal and
+ *        hold no terminator.
+ *
+ * @param w1 The first string, aligned to a word.
+ * @param w2 The second string, aligned to a word.
+ * @param n Most bytes to compare.
+ * @return The number of bytes, a multiple of the word size.
+ */
+static size_t	word_run(const t_word *w1, const t_word *w2, size_t n)
+{
+	size_t	i;
+
+	i = 0;
+	while (n / sizeof(t_word) > i && w1[i] == w2[i]
+		&& !((w1[i] - FT_WORD_ONES) & ~w1[i] & FT_WORD_HIGHS))
+		++i;
+	return (i * sizeof(t_word));
+}
+
+int	ft_strncmp_word(const char *s1, const char *s2, size_t n)
+{
+	size_t	i;
+
+	i = 0;
+	while (i < n && (uintptr_t)(s1 + i) % sizeof(t_word) && s1[i]
+		&& s1[i] == s2[i])
+		++i;
+	if ((uintptr_t)(s1 + i) % sizeof(t_word) == 0
+		&& (uintptr_t)(s2 + i) % sizeof(t_word) == 0)
+		i += word_run((const t_word *)(s1 + i), (const t_word *)(s2 + i),
+				n - i);
+	while (i < n && s1[i] && s1[i] == s2[i])
+		++i;
+	if (i >= n)
+		return (0);
+	return ((unsigned char)s1[i] - (unsigned char)s2[i]);
+}
+
+int	ft_memcmp_word(const void *s1, const void *s2, size_t n)
+{
+	const unsigned char	*a;
+	const unsigned char	*b;
+	size_t				i;
+
+	a = s1;
+	b = s2;
+	i = 0;
+	while (i < n && (uintptr_t)(a + i) % sizeof(t_word) && a[i] == b[i])
+		++i;
+	if ((uintptr_t)(a + i) % sizeof(t_word) == 0
+		&& (uintptr_t)(b + i) % sizeof(t_word) == 0)
+	{
+		while (n - i >= sizeof(t_word)
+			&& *(const t_word *)(a + i) == *(const t_word *)(b + i))
+			i += sizeof(t_word);
+	}
+	while (i < n && a[i] == b[i])
+		++i;
+	if (i == n)
+		return (0);
+	return (a[i] - b[i]);
+}
@@ -0,0 +1,89 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_word_mem.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 09:06:18 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 10:11:34 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "libft.h"
+
+void	*ft_memcpy_word(void *dest, const void *src, size_t n)
+{
+	unsigned char		*d;
+	const unsigned char	*s;
+
+	d = dest;
+	s = src;
+	if ((uintptr_t)d % sizeof(t_word) == (uintptr_t)s % sizeof(t_word))
+	{
+		while (n && (uintptr_t)d % sizeof(t_word))
+		{
+			*d++ = *s++;
+			--n;
+		}
+		while (n >= sizeof(t_word))
+		{
+			*(t_word *)d = *(const t_word *)s;
+			d += sizeof(t_word);
+			s += sizeof(t_word);
+			n -= sizeof(t_word);
+		}
+	}
+	while (n--)
+		*d++ = *s++;
+	return (dest);
+}
+
+void	*ft_memset_word(void *s, int c, size_t n)
+{
+	unsigned char	*p;
+	t_word			fill;
+
+	p = s;
+	while (n && (uintptr_t)p % sizeof(t_word))
+	{
+		*p++ = (unsigned char)c;
+		--n;
+	}
+	fill = FT_WORD_ONES * (unsigned char)c;
+	while (n >= sizeof(t_word))
+	{
+		*(t_word *)p = fill;
+		p += sizeof(t_word);
+		n -= sizeof(t_word);
+	}
+	while (n--)
+		*p++ = (unsigned char)c;
+	return (s);
+}
+
+size_t	ft_memcount_word(const void *s, int c, size_t n)
+{
+	const unsigned char	*p;
+	t_word				x;
+	size_t				count;
+
+	p = s;
+	count = 0;
+	while (n && (uintptr_t)p % sizeof(t_word))
+	{
+		count += *p++ == (unsigned char)c;
+		--n;
+	}
+	while (n >= sizeof(t_word))
+	{
+		x = *(const t_word *)p ^ (FT_WORD_ONES * (unsigned char)c);
+		x = ~(((x & ~FT_WORD_HIGHS) + ~FT_WORD_HIGHS) | x) & FT_WORD_HIGHS;
+		count += __builtin_popcountl(x);
+		p += sizeof(t_word);
+		n -= sizeof(t_word);
+	}
+	while (n--)
+		count += *p++ == (unsigned char)c;
+	return (count);
+}
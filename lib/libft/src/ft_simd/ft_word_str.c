@@ -0,0 +1,82 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_word_str.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 09:06:18 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 09:06:18 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "libft.h"
+
+size_t	ft_strlen_word(const char *s)
+{
+	const char		*p;
+	const t_word	*w;
+
+	p = s;
+	while ((uintptr_t)p % sizeof(t_word))
+	{
+		if (!*p)
+			return (p - s);
+		++p;
+	}
+	w = (const t_word *)p;
+	while (!((*w - FT_WORD_ONES) & ~*w & FT_WORD_HIGHS))
+		++w;
+	p = (const char *)w;
+	while (*p)
+		++p;
+	return (p - s);
+}
+
+void	*ft_memchr_word(const void *s, int c, size_t n)
+{
+	const unsigned char	*p;
+	t_word				x;
+	size_t				step;
+
+	p = s;
+	while (n)
+	{
+		x = 0;
+		if ((uintptr_t)p % sizeof(t_word) == 0 && n >= sizeof(t_word))
+			x = *(const t_word *)p ^ (FT_WORD_ONES * (unsigned char)c);
+		step = 1;
+		if (x && !((x - FT_WORD_ONES) & ~x & FT_WORD_HIGHS))
+			step = sizeof(t_word);
+		else if (*p == (unsigned char)c)
+			return ((void *)p);
+		p += step;
+		n -= step;
+	}
+	return (NULL);
+}
+
+char	*ft_strchr_word(const char *s, int c)
+{
+	const t_word	*w;
+	t_word			mask;
+	t_word			x;
+
+	while ((uintptr_t)s % sizeof(t_word) && *s && *s != (char)c)
+		++s;
+	if ((uintptr_t)s % sizeof(t_word) == 0)
+	{
+		w = (const t_word *)s;
+		mask = FT_WORD_ONES * (unsigned char)c;
+		x = *w ^ mask;
+		while (!((*w - FT_WORD_ONES) & ~*w & FT_WORD_HIGHS)
+			&& !((x - FT_WORD_ONES) & ~x & FT_WORD_HIGHS))
+			x = *++w ^ mask;
+		s = (const char *)w;
+	}
+	while (*s && *s != (char)c)
+		++s;
+	if (*s == (char)c)
+		return ((char *)s);
+	return (NULL);
+}
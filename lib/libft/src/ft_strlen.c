@@ -6,7 +6,7 @@
 /*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/09/10 17:33:10 by pabmart2          #+#    #+#             */
-/*   Updated: 2025/03/31 22:03:44 by pabmart2         ###   ########.fr       */
+/*   Updated: 2026/10/17 09:06:18 by pabmart2         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -14,12 +14,7 @@
 
 size_t	ft_strlen(const char *str)
 {
-	size_t	i;
-
-	i = 0;
 	if (str == NULL)
 		return (0);
-	while (str[i])
-		++i;
-	return (i);
+	return (ft_simd()->strlen(str));
 }
@@ -0,0 +1,83 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_simd_ref.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 10:28:15 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 10:36:27 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "ft_simd_test.h"
+
+size_t	ref_strlen(const char *s)
+{
+	size_t	len;
+
+	len = 0;
+	while (s[len])
+		++len;
+	return (len);
+}
+
+void	*ref_memchr(const void *s, int c, size_t n)
+{
+	const unsigned char	*p;
+	size_t				i;
+
+	p = s;
+	i = 0;
+	while (i < n)
+	{
+		if (p[i] == (unsigned char)c)
+			return ((void *)(p + i));
+		++i;
+	}
+	return (NULL);
+}
+
+int	ref_memcmp(const void *s1, const void *s2, size_t n)
+{
+	const unsigned char	*p1;
+	const unsigned char	*p2;
+	size_t				i;
+
+	p1 = s1;
+	p2 = s2;
+	i = 0;
+	while (i < n)
+	{
+		if (p1[i] != p2[i])
+			return (p1[i] - p2[i]);
+		++i;
+	}
+	return (0);
+}
+
+int	ref_strncmp(const char *s1, const char *s2, size_t n)
+{
+	size_t	i;
+
+	i = 0;
+	while (i < n)
+	{
+		if (s1[i] != s2[i] || !s1[i])
+			return ((unsigned char)s1[i] - (unsigned char)s2[i]);
+		++i;
+	}
+	return (0);
+}
+
+size_t	ref_memcount(const void *s, int c, size_t n)
+{
+	const unsigned char	*p;
+	size_t				count;
+
+	p = s;
+	count = 0;
+	while (n--)
+		count += *p++ == (unsigned char)c;
+	return (count);
+}
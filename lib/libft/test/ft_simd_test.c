@@ -0,0 +1,120 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_simd_test.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 10:28:15 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 10:36:28 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "ft_simd_test.h"
+
+/**
+ * @brief Checks that ft_simd() picked the best level of the CPU, capped by
+ *        FT_SIMD, and the implementations of that level.
+ *
+ * @param names Name of each level.
+ * @return 1 on mismatch, 0 otherwise.
+ */
+static long	check_level(const char **names)
+{
+	t_simd		want;
+	const char	*cap;
+	int			level;
+
+	level = best_level();
+	cap = getenv("FT_SIMD");
+	if (cap && strcmp(cap, "word") == 0)
+		level = FT_SIMD_WORD;
+	else if (cap && strcmp(cap, "sse2") == 0 && level > FT_SIMD_SSE2)
+		level = FT_SIMD_SSE2;
+	if (!cap)
+		cap = "unset";
+	set_table(&want, level);
+	if (memcmp(&want, ft_simd(), sizeof(want)) == 0)
+		return (printf("ok    ft_simd: %s table with FT_SIMD %s\n",
+				names[level], cap), 0);
+	printf("FAIL  ft_simd: level %d with FT_SIMD %s, expected the %s table\n",
+		ft_simd()->level, cap, names[level]);
+	return (1);
+}
+
+/**
+ * @brief Checks every function of a table against the scalar references,
+ *        for every length up to TEST_MAX_LEN, at every alignment and against
+ *        the end of a page.
+ *
+ * @param c The case, with its regions mapped.
+ * @param simd The table.
+ * @param name Name of the table.
+ * @return The number of mismatches.
+ */
+static long	run_table(t_case *c, const t_simd *simd, const char *name)
+{
+	c->simd = simd;
+	c->variant = name;
+	c->failures = 0;
+	c->align = -1;
+	while (c->align < TEST_ALIGNS)
+	{
+		c->len = 0;
+		while (c->len <= TEST_MAX_LEN)
+		{
+			check_strlen(c);
+			check_strchr(c);
+			check_strncmp(c);
+			check_memchr(c);
+			check_memcmp(c);
+			check_memcount(c);
+			check_memcpy(c);
+			check_memset(c);
+			++c->len;
+		}
+		++c->align;
+	}
+	if (c->failures == 0)
+		printf("ok    %s: alignments 0-%d and page end, lengths 0-%d\n", name,
+			TEST_ALIGNS - 1, TEST_MAX_LEN);
+	return (c->failures);
+}
+
+/**
+ * @brief Checks the table picked by ft_simd(), then the word, SSE2 and AVX2
+ *        implementations the CPU supports.
+ *
+ * The table picked depends on FT_SIMD, so `make test` also runs this with
+ * it set to "sse2" and "word", with the "level" argument to only check that
+ * table. It is the same table as one of the checked levels. A read or write
+ * past a buffer placed at the end of a page crashes the harness, so the
+ * output is line-buffered to show how far it got.
+ *
+ * Usage: ft_simd_test [level]
+ */
+int	main(int argc, char *argv[])
+{
+	static const char	*names[4] = {"none", "word", "sse2", "avx2"};
+	t_simd				table;
+	t_case				c;
+	long				failures;
+	int					level;
+
+	setvbuf(stdout, NULL, _IOLBF, 0);
+	failures = check_level(names);
+	if (argc > 1 && strcmp(argv[1], "level") == 0)
+		return (failures != 0);
+	c.regions[0] = map_region();
+	c.regions[1] = map_region();
+	if (!c.regions[0] || !c.regions[1])
+		return (perror("ft_simd_test"), 1);
+	level = FT_SIMD_WORD;
+	while (level <= best_level())
+	{
+		set_table(&table, level);
+		failures += run_table(&c, &table, names[level]);
+		++level;
+	}
+	return (failures != 0);
+}
@@ -0,0 +1,157 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_simd_test.h                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 10:28:15 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 10:36:28 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef FT_SIMD_TEST_H
+# define FT_SIMD_TEST_H
+
+# include "libft.h"
+# include <stdio.h>
+# include <stdlib.h>
+# include <string.h>
+# include <sys/mman.h>
+# include <unistd.h>
+
+# define TEST_MAX_LEN 300
+# define TEST_ALIGNS 64
+# define TEST_EDGE 33
+# define TEST_TARGET 0xE9
+# define TEST_CANARY 0xA5
+# define TEST_MAX_REPORTS 20
+
+/**
+ * @struct s_case
+ * @brief One buffer placement of the harness, checked against every function
+ *        of a table.
+ *
+ * @param simd
+ * The table under test.
+ *
+ * @param variant
+ * Name of the table in the report.
+ *
+ * @param regions
+ * Two mappings of three pages, the last of them PROT_NONE, so a read or
+ * write past the end of a buffer placed against it faults.
+ *
+ * @param len
+ * Length of the buffers, from 0 to TEST_MAX_LEN.
+ *
+ * @param align
+ * Offset of the buffers from a 64-byte boundary, or -1 to place them so they
+ * end against the PROT_NONE page. See case_buf().
+ *
+ * @param failures
+ * Number of mismatches found so far.
+ */
+typedef struct s_case
+{
+	const t_simd	*simd;
+	const char		*variant;
+	unsigned char	*regions[2];
+	size_t			len;
+	int				align;
+	long			failures;
+}					t_case;
+
+/*
+ * Scalar references, one byte at a time.
+ */
+size_t			ref_strlen(const char *s);
+void			*ref_memchr(const void *s, int c, size_t n);
+int				ref_memcmp(const void *s1, const void *s2, size_t n);
+int				ref_strncmp(const char *s1, const char *s2, size_t n);
+size_t			ref_memcount(const void *s, int c, size_t n);
+
+/**
+ * @brief Returns the best level the CPU supports, ignoring FT_SIMD.
+ *
+ * @return FT_SIMD_WORD, FT_SIMD_SSE2 or FT_SIMD_AVX2.
+ */
+int				best_level(void);
+
+/**
+ * @brief Fills a table with the implementations of one level, as ft_simd()
+ *        would.
+ *
+ * @param simd The table. Its padding is zeroed too, so it can be compared
+ *             with memcmp(3).
+ * @param level FT_SIMD_WORD, or FT_SIMD_SSE2 or FT_SIMD_AVX2 on x86-64.
+ */
+void			set_table(t_simd *simd, int level);
+
+/**
+ * @brief Maps three pages and makes the last one PROT_NONE.
+ *
+ * @return The mapping, or NULL on error.
+ */
+unsigned char	*map_region(void);
+
+/**
+ * @brief Returns a buffer of the case, placed as c->align says.
+ *
+ * The second buffer is offset differently from the first, so two-buffer
+ * functions also see mismatched alignments.
+ *
+ * @param c The case.
+ * @param which 0 for the first buffer, 1 for the second.
+ * @param size Size of the buffer, at most TEST_MAX_LEN + 1.
+ * @return The buffer.
+ */
+unsigned char	*case_buf(t_case *c, int which, size_t size);
+
+/**
+ * @brief Fills a buffer with bytes from 1 to 100, so it holds no NUL, no
+ *        TEST_TARGET and no byte above 127.
+ *
+ * @param buf The buffer.
+ * @param size Its size.
+ * @param seed Shifts the pattern.
+ */
+void			fill(unsigned char *buf, size_t size, int seed);
+
+/**
+ * @brief Returns the next position to plant a byte at.
+ *
+ * Every position is visited in the first and last TEST_EDGE bytes, where
+ * the head and tail code paths are, and the middle one in between.
+ * TEST_EDGE covers an AVX2 vector and one more byte.
+ *
+ * @param k The current position.
+ * @param len Length of the buffer.
+ * @return The next position, len or more when done.
+ */
+size_t			next_pos(size_t k, size_t len);
+
+/**
+ * @brief Counts and reports a mismatch of the case.
+ *
+ * Only the first TEST_MAX_REPORTS mismatches are printed.
+ *
+ * @param c The case.
+ * @param fn Name of the function.
+ * @param pos Position planted when the mismatch was found.
+ */
+void			fail(t_case *c, const char *fn, size_t pos);
+
+/*
+ * Checks of every function, each over the buffers of one case.
+ */
+void			check_strlen(t_case *c);
+void			check_strchr(t_case *c);
+void			check_strncmp(t_case *c);
+void			check_memchr(t_case *c);
+void			check_memcmp(t_case *c);
+void			check_memcount(t_case *c);
+void			check_memcpy(t_case *c);
+void			check_memset(t_case *c);
+
+#endif
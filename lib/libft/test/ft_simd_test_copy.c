@@ -0,0 +1,83 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_simd_test_copy.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 10:28:15 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 10:36:28 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "ft_simd_test.h"
+
+/**
+ * @brief Sets or checks the 16 bytes around a destination block.
+ *
+ * @param dst The block.
+ * @param len Its length.
+ * @param end End of the mapping. No byte at or past it is touched.
+ * @param set Non-zero to set the canaries, 0 to check them.
+ * @return 1 if a canary was overwritten, 0 otherwise.
+ */
+static int	canary(unsigned char *dst, size_t len, unsigned char *end,
+		int set)
+{
+	unsigned char	*p;
+	int				bad;
+
+	bad = 0;
+	p = dst - 16;
+	while (p < dst + len + 16 && p < end)
+	{
+		if (p == dst)
+			p += len;
+		if (p >= end)
+			return (bad);
+		if (set)
+			*p = TEST_CANARY;
+		bad |= *p != TEST_CANARY;
+		++p;
+	}
+	return (bad);
+}
+
+void	check_memcpy(t_case *c)
+{
+	unsigned char	*src;
+	unsigned char	*dst;
+	unsigned char	*end;
+
+	src = case_buf(c, 0, c->len);
+	dst = case_buf(c, 1, c->len);
+	end = c->regions[1] + 2 * sysconf(_SC_PAGESIZE);
+	fill(src, c->len, 6);
+	memset(dst, 0, c->len);
+	canary(dst, c->len, end, 1);
+	if (c->simd->memcpy(dst, src, c->len) != dst
+		|| ref_memcmp(dst, src, c->len) != 0
+		|| canary(dst, c->len, end, 0))
+		fail(c, "memcpy", c->len);
+}
+
+void	check_memset(t_case *c)
+{
+	unsigned char	*dst;
+	unsigned char	*end;
+	int				i;
+
+	dst = case_buf(c, 1, c->len);
+	end = c->regions[1] + 2 * sysconf(_SC_PAGESIZE);
+	i = 0;
+	while (i < 2)
+	{
+		memset(dst, 0, c->len);
+		canary(dst, c->len, end, 1);
+		if (c->simd->memset(dst, TEST_TARGET - 256 * i, c->len) != dst
+			|| ref_memcount(dst, TEST_TARGET, c->len) != c->len
+			|| canary(dst, c->len, end, 0))
+			fail(c, "memset", c->len);
+		++i;
+	}
+}
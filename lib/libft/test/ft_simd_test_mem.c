@@ -0,0 +1,117 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_simd_test_mem.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 10:28:15 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 10:36:28 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "ft_simd_test.h"
+
+/**
+ * @brief Returns -1, 0 or 1 as a comparison result is negative, zero or
+ *        positive.
+ */
+static int	sign(int n)
+{
+	return ((n > 0) - (n < 0));
+}
+
+void	check_memchr(t_case *c)
+{
+	unsigned char	*p;
+	unsigned char	saved;
+	size_t			k;
+	int				target;
+
+	p = case_buf(c, 0, c->len);
+	fill(p, c->len, 3);
+	if (c->simd->memchr(p, TEST_TARGET, c->len) != NULL)
+		fail(c, "memchr", c->len);
+	k = 0;
+	while (k < c->len)
+	{
+		saved = p[k];
+		p[k] = TEST_TARGET;
+		target = TEST_TARGET - 256 * (k & 1);
+		if (c->simd->memchr(p, target, c->len)
+			!= ref_memchr(p, target, c->len)
+			|| c->simd->memchr(p, TEST_TARGET, k) != NULL)
+			fail(c, "memchr", k);
+		p[k] = saved;
+		k = next_pos(k, c->len);
+	}
+}
+
+/**
+ * @brief Compares two blocks both ways, up to a mismatch planted at k and
+ *        over the whole length.
+ *
+ * @param c The case.
+ * @param p The blocks.
+ * @param k Position of the mismatch, or c->len if there is none.
+ */
+static void	memcmp_at(t_case *c, unsigned char **p, size_t k)
+{
+	size_t	n[2];
+	int		i;
+
+	n[0] = k;
+	n[1] = c->len;
+	i = 0;
+	while (i < 4)
+	{
+		if (sign(c->simd->memcmp(p[i & 1], p[!(i & 1)], n[i / 2]))
+			!= sign(ref_memcmp(p[i & 1], p[!(i & 1)], n[i / 2])))
+			fail(c, "memcmp", k);
+		++i;
+	}
+}
+
+void	check_memcmp(t_case *c)
+{
+	unsigned char	*p[2];
+	size_t			k;
+
+	p[0] = case_buf(c, 0, c->len);
+	p[1] = case_buf(c, 1, c->len);
+	fill(p[0], c->len, 4);
+	fill(p[1], c->len, 4);
+	memcmp_at(c, p, c->len);
+	k = 0;
+	while (k < c->len)
+	{
+		p[0][k] = 0x20;
+		p[1][k] = 0xC0;
+		memcmp_at(c, p, k);
+		p[0][k] = 1 + (k * 7 + 4) % 100;
+		p[1][k] = p[0][k];
+		k = next_pos(k, c->len);
+	}
+}
+
+void	check_memcount(t_case *c)
+{
+	unsigned char	*p;
+	size_t			k;
+
+	p = case_buf(c, 0, c->len);
+	fill(p, c->len, 5);
+	k = 0;
+	while (k < c->len)
+	{
+		p[k] = TEST_TARGET;
+		if (c->simd->memcount(p, TEST_TARGET, c->len)
+			!= ref_memcount(p, TEST_TARGET, c->len)
+			|| c->simd->memcount(p, TEST_TARGET - 256, k)
+			!= ref_memcount(p, TEST_TARGET, k))
+			fail(c, "memcount", k);
+		k = next_pos(k, c->len);
+	}
+	if (c->simd->memcount(p, 5, c->len) != ref_memcount(p, 5, c->len))
+		fail(c, "memcount", c->len);
+}
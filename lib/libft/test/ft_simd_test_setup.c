@@ -0,0 +1,94 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_simd_test_setup.c                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 10:28:15 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 10:36:28 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "ft_simd_test.h"
+
+int	best_level(void)
+{
+	int	level;
+
+	level = FT_SIMD_WORD;
+#ifdef FT_SIMD_X86
+	level = FT_SIMD_SSE2;
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))
+		level = FT_SIMD_AVX2;
+#endif
+	return (level);
+}
+
+/**
+ * @brief Fills a table with the SSE2 or AVX2 implementations.
+ *
+ * @param simd The table.
+ * @param level FT_SIMD_SSE2 or FT_SIMD_AVX2.
+ */
+#ifdef FT_SIMD_X86
+
+static void	set_x86(t_simd *simd, int level)
+{
+	if (level == FT_SIMD_SSE2)
+	{
+		simd->strlen = ft_strlen_sse2;
+		simd->memchr = ft_memchr_sse2;
+		simd->strchr = ft_strchr_sse2;
+		simd->strncmp = ft_strncmp_sse2;
+		simd->memcmp = ft_memcmp_sse2;
+		simd->memcpy = ft_memcpy_sse2;
+		simd->memset = ft_memset_sse2;
+		simd->memcount = ft_memcount_sse2;
+	}
+	if (level == FT_SIMD_AVX2)
+	{
+		simd->strlen = ft_strlen_avx2;
+		simd->memchr = ft_memchr_avx2;
+		simd->strchr = ft_strchr_avx2;
+		simd->strncmp = ft_strncmp_avx2;
+		simd->memcmp = ft_memcmp_avx2;
+		simd->memcpy = ft_memcpy_avx2;
+		simd->memset = ft_memset_avx2;
+		simd->memcount = ft_memcount_avx2;
+	}
+}
+#endif
+
+void	set_table(t_simd *simd, int level)
+{
+	memset(simd, 0, sizeof(*simd));
+	simd->strlen = ft_strlen_word;
+	simd->memchr = ft_memchr_word;
+	simd->strchr = ft_strchr_word;
+	simd->strncmp = ft_strncmp_word;
+	simd->memcmp = ft_memcmp_word;
+	simd->memcpy = ft_memcpy_word;
+	simd->memset = ft_memset_word;
+	simd->memcount = ft_memcount_word;
+#ifdef FT_SIMD_X86
+	set_x86(simd, level);
+#endif
+	simd->level = level;
+}
+
+unsigned char	*map_region(void)
+{
+	unsigned char	*region;
+	long			page;
+
+	page = sysconf(_SC_PAGESIZE);
+	region = mmap(NULL, 3 * page, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (region == MAP_FAILED)
+		return (NULL);
+	if (mprotect(region + 2 * page, page, PROT_NONE) == -1)
+		return (munmap(region, 3 * page), NULL);
+	return (region);
+}
@@ -0,0 +1,115 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_simd_test_str.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 10:28:15 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 10:36:28 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "ft_simd_test.h"
+
+/**
+ * @brief Returns -1, 0 or 1 as a comparison result is negative, zero or
+ *        positive.
+ */
+static int	sign(int n)
+{
+	return ((n > 0) - (n < 0));
+}
+
+void	check_strlen(t_case *c)
+{
+	unsigned char	*s;
+
+	s = case_buf(c, 0, c->len + 1);
+	fill(s, c->len, 0);
+	s[c->len] = '\0';
+	if (c->simd->strlen((char *)s) != ref_strlen((char *)s))
+		fail(c, "strlen", c->len);
+}
+
+void	check_strchr(t_case *c)
+{
+	unsigned char	*s;
+	unsigned char	saved;
+	size_t			k;
+	int				target;
+
+	s = case_buf(c, 0, c->len + 1);
+	fill(s, c->len, 1);
+	s[c->len] = '\0';
+	k = 0;
+	while (k < c->len)
+	{
+		saved = s[k];
+		s[k] = TEST_TARGET;
+		target = TEST_TARGET - 256 * (k & 1);
+		if (c->simd->strchr((char *)s, target)
+			!= ref_memchr(s, target, c->len + 1))
+			fail(c, "strchr", k);
+		s[k] = saved;
+		k = next_pos(k, c->len);
+	}
+	if (c->simd->strchr((char *)s, TEST_TARGET) != NULL
+		|| c->simd->strchr((char *)s, '\0') != (char *)s + c->len)
+		fail(c, "strchr", c->len);
+}
+
+/**
+ * @brief Compares two strings both ways, up to a mismatch planted at k and
+ *        without a limit.
+ *
+ * @param c The case.
+ * @param s The strings, NUL-terminated at c->len at the latest.
+ * @param k Position of the mismatch, or c->len if there is none.
+ */
+static void	strncmp_at(t_case *c, unsigned char **s, size_t k)
+{
+	size_t	n[2];
+	char	*s1;
+	char	*s2;
+	int		i;
+
+	n[0] = k;
+	n[1] = SIZE_MAX;
+	i = 0;
+	while (i < 4)
+	{
+		s1 = (char *)s[i & 1];
+		s2 = (char *)s[!(i & 1)];
+		if (sign(c->simd->strncmp(s1, s2, n[i / 2]))
+			!= sign(ref_strncmp(s1, s2, n[i / 2])))
+			fail(c, "strncmp", k);
+		++i;
+	}
+}
+
+void	check_strncmp(t_case *c)
+{
+	unsigned char	*s[2];
+	size_t			k;
+
+	s[0] = case_buf(c, 0, c->len + 1);
+	s[1] = case_buf(c, 1, c->len + 1);
+	fill(s[0], c->len, 2);
+	fill(s[1], c->len, 2);
+	s[0][c->len] = '\0';
+	s[1][c->len] = '\0';
+	strncmp_at(c, s, c->len);
+	k = 0;
+	while (k < c->len)
+	{
+		s[0][k] = 0x20;
+		s[1][k] = 0xC0;
+		strncmp_at(c, s, k);
+		s[0][k] = '\0';
+		strncmp_at(c, s, k);
+		s[0][k] = 1 + (k * 7 + 2) % 100;
+		s[1][k] = s[0][k];
+		k = next_pos(k, c->len);
+	}
+}
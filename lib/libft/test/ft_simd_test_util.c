@@ -0,0 +1,61 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ft_simd_test_util.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 10:28:15 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 10:36:28 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "ft_simd_test.h"
+
+unsigned char	*case_buf(t_case *c, int which, size_t size)
+{
+	long	page;
+	int		align;
+
+	page = sysconf(_SC_PAGESIZE);
+	if (c->align < 0)
+		return (c->regions[which] + 2 * page - size);
+	align = c->align;
+	if (which)
+		align = (align * 5 + 3) % TEST_ALIGNS;
+	return (c->regions[which] + page + align);
+}
+
+void	fill(unsigned char *buf, size_t size, int seed)
+{
+	size_t	i;
+
+	i = 0;
+	while (i < size)
+	{
+		buf[i] = 1 + (i * 7 + seed) % 100;
+		++i;
+	}
+}
+
+size_t	next_pos(size_t k, size_t len)
+{
+	++k;
+	if (k >= TEST_EDGE && k < len / 2)
+		k = len / 2;
+	else if (k > len / 2 && k + TEST_EDGE < len)
+		k = len - TEST_EDGE;
+	return (k);
+}
+
+void	fail(t_case *c, const char *fn, size_t pos)
+{
+	if (++c->failures > TEST_MAX_REPORTS)
+		return ;
+	if (c->align < 0)
+		printf("FAIL  %s: %s, len %zu, at page end, pos %zu\n", c->variant,
+			fn, c->len, pos);
+	else
+		printf("FAIL  %s: %s, len %zu, align %d, pos %zu\n", c->variant,
+			fn, c->len, c->align, pos);
+}
@@ -0,0 +1,148 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   cmd_cache.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 08:23:12 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 08:41:41 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * @brief Copies an entry of the cache, following its seqlock.
+ *
+ * @param slot The shared entry.
+ * @param copy Filled with a private copy of the entry.
+ * @return 0 if the copy is consistent, 1 if a writer was updating the entry.
+ */
+static int	read_entry(t_cmd_entry *slot, t_cmd_entry *copy)
+{
+	unsigned int	seq;
+
+	seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+	if (seq & 1)
+		return (1);
+	ft_memcpy(copy, slot, sizeof(t_cmd_entry));
+	__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	if (__atomic_load_n(&slot->seq, __ATOMIC_RELAXED) != seq)
+		return (1);
+	copy->name[CMD_CACHE_NAME - 1] = '\0';
+	copy->path[CMD_CACHE_PATH - 1] = '\0';
+	return (0);
+}
+
+/**
+ * @brief Tells whether the PATH directories searched to find an entry still
+ *        have the modification time they had when it was stored.
+ *
+ * A directory that did not exist is recorded with all bits set.
+ *
+ * @param entry The entry to validate.
+ * @param paths The PATH directories.
+ * @return 1 if every directory up to the one holding the command is
+ *         unchanged, 0 otherwise.
+ */
+static int	dirs_match(t_cmd_entry *entry, char **paths)
+{
+	struct stat	st;
+	int			i;
+
+	if (entry->dir < 0 || entry->dir >= CMD_CACHE_DIRS)
+		return (0);
+	i = 0;
+	while (i <= entry->dir)
+	{
+		if (!paths[i])
+			return (0);
+		if (stat(paths[i], &st) == -1)
+			ft_memset(&st.st_mtim, -1, sizeof(st.st_mtim));
+		if (st.st_mtim.tv_sec != entry->mtimes[i].tv_sec
+			|| st.st_mtim.tv_nsec != entry->mtimes[i].tv_nsec)
+			return (0);
+		++i;
+	}
+	return (1);
+}
+
+/**
+ * @brief Records the modification time of the PATH directories up to the
+ *        one holding the command, then checks again that none of the
+ *        previous ones has it.
+ *
+ * Taking the times before checking means a command added meanwhile always
+ * invalidates the entry.
+ *
+ * @param entry The entry to fill. Its dir must be set.
+ * @param paths The PATH directories.
+ * @param cmd The command name, with its leading '/'.
+ * @return 0 if the entry can be stored, 1 otherwise. Relative directories
+ *         depend on the working directory and are never cached.
+ */
+static int	stamp_dirs(t_cmd_entry *entry, char **paths, char *cmd)
+{
+	struct stat	st;
+	char		path[PATH_MAX];
+	int			i;
+
+	i = -1;
+	while (++i <= entry->dir)
+	{
+		if (paths[i][0] != '/')
+			return (1);
+		if (stat(paths[i], &st) == -1)
+			ft_memset(&st.st_mtim, -1, sizeof(st.st_mtim));
+		entry->mtimes[i] = st.st_mtim;
+	}
+	i = 0;
+	while (i < entry->dir)
+	{
+		if (join_path(path, paths[i++], cmd) || access(path, X_OK) == 0)
+			return (1);
+	}
+	return (0);
+}
+
+int	cmd_cache_lookup(t_cmd_cache *cache, char *cmd, char **paths,
+		char *cmd_path)
+{
+	t_cmd_entry		*slot;
+	t_cmd_entry		entry;
+	unsigned long	path_hash;
+
+	slot = cmd_cache_slot(cache, cmd, &path_hash);
+	if (!slot || read_entry(slot, &entry) || entry.path_hash != path_hash
+		|| ft_strncmp(entry.name, cmd, CMD_CACHE_NAME) != 0
+		|| !dirs_match(&entry, paths) || access(entry.path, X_OK) != 0)
+		return (1);
+	ft_strlcpy(cmd_path, entry.path, PATH_MAX);
+	return (0);
+}
+
+void	cmd_cache_store(t_cmd_cache *cache, char **paths, size_t dir,
+		char *cmd_path)
+{
+	t_cmd_entry	*slot;
+	t_cmd_entry	entry;
+	char		*cmd;
+
+	cmd = cmd_path + ft_strlen(paths[dir]);
+	slot = cmd_cache_slot(cache, cmd, &entry.path_hash);
+	if (!slot || dir >= CMD_CACHE_DIRS
+		|| ft_strlen(cmd_path) >= CMD_CACHE_PATH)
+		return ;
+	ft_strlcpy(entry.name, cmd, CMD_CACHE_NAME);
+	ft_strlcpy(entry.path, cmd_path, CMD_CACHE_PATH);
+	entry.dir = dir;
+	if (stamp_dirs(&entry, paths, cmd) || flock(cache->fd, LOCK_EX) == -1)
+		return ;
+	__atomic_store_n(&slot->seq, slot->seq + 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	ft_memcpy(&slot->path_hash, &entry.path_hash,
+		sizeof(t_cmd_entry) - offsetof(t_cmd_entry, path_hash));
+	__atomic_store_n(&slot->seq, slot->seq + 1, __ATOMIC_RELEASE);
+	flock(cache->fd, LOCK_UN);
+}
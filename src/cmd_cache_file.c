@@ -0,0 +1,110 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   cmd_cache_file.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 08:23:12 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 10:55:21 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+unsigned long	fnv_hash(const char *str, unsigned long hash)
+{
+	while (*str)
+		hash = (hash ^ (unsigned char)*str++) * 1099511628211UL;
+	return (hash);
+}
+
+/**
+ * @brief Checks the cache file, laying it out first if it was just created.
+ *
+ * Its entries name the executables pipex runs, so a file that is not a
+ * regular file owned by the effective user, or that the group or others can
+ * write to, is rejected: another user could have planted it.
+ *
+ * A new file is sized and stamped with CMD_CACHE_MAGIC under an exclusive
+ * flock(2). A file of any other size or magic is not touched, so instances
+ * mapping it are never hit by SIGBUS.
+ *
+ * @param fd The cache file.
+ * @return 0 if the file can be mapped, 1 otherwise.
+ */
+static int	init_file(int fd)
+{
+	struct stat		st;
+	unsigned int	magic;
+
+	if (fstat(fd, &st) == -1 || !S_ISREG(st.st_mode)
+		|| st.st_uid != geteuid() || (st.st_mode & (S_IWGRP | S_IWOTH)))
+		return (1);
+	if (st.st_size == 0 && flock(fd, LOCK_EX) == 0)
+	{
+		magic = CMD_CACHE_MAGIC;
+		if (fstat(fd, &st) == 0 && st.st_size == 0
+			&& ftruncate(fd, sizeof(t_cmd_file)) == 0
+			&& pwrite(fd, &magic, sizeof(magic), 0) == sizeof(magic))
+			st.st_size = sizeof(t_cmd_file);
+		flock(fd, LOCK_UN);
+	}
+	if (st.st_size != sizeof(t_cmd_file)
+		|| pread(fd, &magic, sizeof(magic), 0) != sizeof(magic))
+		return (1);
+	return (magic != CMD_CACHE_MAGIC);
+}
+
+int	cmd_cache_open(t_cmd_cache *cache)
+{
+	char	buf[CMD_CACHE_PATH];
+	char	*file;
+	void	*map;
+
+	cache->state = -1;
+	file = ft_getenv("PIPEX_CMD_CACHE");
+	if (!file || !*file || ft_strncmp(file, "0", 2) == 0)
+		return (1);
+	if (*file != '/')
+		ft_snprintf(buf, sizeof(buf), CMD_CACHE_FILE, geteuid());
+	if (*file != '/')
+		file = buf;
+	cache->fd = open(file, O_RDWR | O_CREAT | O_NOFOLLOW | O_CLOEXEC, 0600);
+	if (cache->fd == -1)
+		return (1);
+	map = MAP_FAILED;
+	if (init_file(cache->fd) == 0)
+		map = mmap(NULL, sizeof(t_cmd_file), PROT_READ | PROT_WRITE,
+				MAP_SHARED, cache->fd, 0);
+	if (map == MAP_FAILED)
+		return (close(cache->fd), 1);
+	cache->map = map;
+	cache->state = 1;
+	return (0);
+}
+
+void	cmd_cache_close(t_cmd_cache *cache)
+{
+	if (cache->state == 1)
+	{
+		munmap(cache->map, sizeof(t_cmd_file));
+		close(cache->fd);
+	}
+	cache->state = 0;
+}
+
+t_cmd_entry	*cmd_cache_slot(t_cmd_cache *cache, const char *cmd,
+		unsigned long *path_hash)
+{
+	char	*path;
+
+	if (cache->state == 0)
+		cmd_cache_open(cache);
+	path = ft_getenv("PATH");
+	if (cache->state != 1 || !path || ft_strlen(cmd) >= CMD_CACHE_NAME)
+		return (NULL);
+	*path_hash = fnv_hash(path, CMD_CACHE_FNV);
+	return (&cache->map->entries[fnv_hash(cmd, *path_hash)
+			% CMD_CACHE_SLOTS]);
+}
@@ -0,0 +1,86 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   deadline.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 08:14:49 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 08:19:47 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+void	signal_stage(t_stage *stage, long now)
+{
+	if (stage->signals == 0)
+	{
+		kill(stage->pid, SIGTERM);
+		stage->deadline_ns = now + TIMEOUT_GRACE_MS * 1000000L;
+	}
+	else
+	{
+		kill(stage->pid, SIGKILL);
+		stage->deadline_ns = 0;
+	}
+	++stage->signals;
+}
+
+void	arm_stage(t_pinfo *pinfo, size_t index)
+{
+	t_stage	*stage;
+	long	now;
+	long	timeout;
+
+	stage = &pinfo->stages[index];
+	now = now_ns();
+	if (index == 0 && pinfo->opts.timeout_ms > 0)
+		pinfo->deadline_ns = now + pinfo->opts.timeout_ms * 1000000L;
+	stage->pidfd = -1;
+	if (stage->pid == -1)
+	{
+		check_pipefail(pinfo, index);
+		return ;
+	}
+	stage->pidfd = syscall(SYS_pidfd_open, stage->pid, 0);
+	timeout = duration_opt(pinfo->opts.stage_timeout, index);
+	if (timeout > 0)
+		stage->deadline_ns = now + timeout * 1000000L;
+	if (pinfo->deadline_ns && (!stage->deadline_ns
+			|| pinfo->deadline_ns < stage->deadline_ns))
+		stage->deadline_ns = pinfo->deadline_ns;
+}
+
+int	check_deadlines(t_pinfo *pinfo)
+{
+	t_stage	*stage;
+	long	now;
+	long	next;
+	size_t	i;
+
+	now = now_ns();
+	next = -1;
+	i = 0;
+	while (i < 2)
+	{
+		stage = &pinfo->stages[i++];
+		if (stage->deadline_ns && stage->deadline_ns <= now)
+			signal_stage(stage, now);
+		if (stage->deadline_ns && (next == -1
+				|| stage->deadline_ns - now < next))
+			next = stage->deadline_ns - now;
+	}
+	if (next == -1)
+		return (-1);
+	if (next / 1000000 >= INT_MAX)
+		return (INT_MAX);
+	return (next / 1000000 + 1);
+}
+
+int	sooner(int timeout, int ms)
+{
+	if (timeout == -1 || ms < timeout)
+		return (ms);
+	return (timeout);
+}
@@ -6,119 +6,78 @@
 /*   By: pablo <pablo@student.42.fr>                +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/04/07 12:37:31 by pablo             #+#    #+#             */
-/*   Updated: 2025/05/23 11:55:38 by pablo            ###   ########.fr       */
+/*   Updated: 2026/10/17 08:41:41 by pabmart2         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "pipex.h"
 
 /**
- * @brief Cleans up resources and handles errors during command execution.
+ * @brief Redirects the endpoint of the first or last command.
  *
- * This function is responsible for freeing the memory allocated for the
- * command path and its arguments, and then printing an error message
- * before exiting the program with a failure status.
- *
- * @param cmd_path Pointer to the command path string to be freed.
- * @param args Pointer to the array of argument strings to be freed.
+ * The first command reads from the infile and the last one writes to the
+ * outfile. With PIPEX_SPLICE the parent owns both files, so the relay pipe
+ * ends are used instead.
  *
+ * @param pinfo Pipeline information. pinfo->i is the argv index of the
+ *              command.
+ * @param argv Array of command-line arguments
+ * @return 0 on success, 1 on failure with an error message printed.
  */
-static void	execution_cleanup(char *cmd_path, char **args)
+static int	redirect_endpoint(t_pinfo *pinfo, char *argv[])
 {
-	ft_free((void **)&cmd_path);
-	ft_matrix_free((void **)args, 0);
-	ft_perror("Error executing command", 0, 0);
+	if (!pinfo->opts.splice && pinfo->i == 2)
+		return (set_infile(argv[1]));
+	if (!pinfo->opts.splice)
+		return (set_outfile(argv[4]));
+	if (pinfo->i == 2 && dup2(pinfo->relay_ends[0], STDIN_FILENO) != -1)
+		return (0);
+	if (pinfo->i != 2 && dup2(pinfo->relay_ends[1], STDOUT_FILENO) != -1)
+		return (0);
+	perror("Error duplicating file");
+	return (1);
 }
 
 /**
- * @brief Executes the first command in a pipeline
- *
- * This function handles execution of the first command in a pipeline setup.
- * It sets up input redirection from a file specified in argv[1], then
- * redirects standard output to the write end of the provided pipe.
- * After setup, the command is executed with execve.
+ * @brief Wires the standard input and output of the child and replaces it
+ *        with the planned command of the stage.
  *
- * @param argv Array of command-line arguments:
- *             argv[1] -> Input file path |
- *             argv[2] -> Command with arguments to execute
- * @param paths String containing PATH environment data
- * @param pipe_fds Array with pipe file descriptors [read_end, write_end]
+ * The executable and the arguments were resolved by plan_stages() before
+ * forking, so nothing is allocated here. The descriptors held by pinfo are
+ * closed with close_pinfo(), while the arena holding the argument vector is
+ * kept until execve().
  *
- * @note The function does not return if command execution is successful
- *       as execve replaces the current process.
- * @note If any error occurs, appropriate cleanup is performed and
- *       the function exits with the corresponding error code.
+ * @param pinfo Pipeline information. It is always cleaned.
+ * @param stage The stage to execute.
+ * @param in Descriptor to use as standard input, or -1 to keep it.
+ * @param out Descriptor to use as standard output, or -1 to keep it.
  */
-static void	execute_first_cmd(char *argv[], char **paths, int *pipe_fds)
+static void	exec_stage(t_pinfo *pinfo, t_stage *stage, int in, int out)
 {
 	extern char	**environ;
-	char		**args;
-	char		*cmd_path;
 
-	if (set_infile(argv[1]))
-		return ;
-	cmd_path = get_cmd_path(argv[2], paths);
-	if (!cmd_path)
-	{
-		ft_matrix_free((void **)paths, 0);
-		clean_pipe(pipe_fds);
-		ft_perror("Command not found", 0, 127);
-	}
-	args = ft_split(argv[2], ' ');
-	if (dup2(pipe_fds[1], STDOUT_FILENO) != -1)
+	if ((in != -1 && dup2(in, STDIN_FILENO) == -1)
+		|| (out != -1 && dup2(out, STDOUT_FILENO) == -1))
 	{
-		ft_matrix_free((void **)paths, 0);
-		clean_pipe(pipe_fds);
-		execve(cmd_path, args, environ);
+		perror("Error duplicating file");
+		clean_pinfo(pinfo);
+		return ;
 	}
-	execution_cleanup(cmd_path, args);
+	close_pinfo(pinfo);
+	execve(stage->path, stage->args, environ);
+	perror("Error executing command");
+	clean_pinfo(pinfo);
 }
 
-/**
- * @brief Executes the last command in the pipe sequence
- *
- * This function handles the execution of the last command in a pipeline.
- * It redirects the standard input to read from the pipe and the standard
- * output to write to the specified output file. If any step fails, it
- * performs appropriate cleanup and error handling.
- *
- * @param argv Array of command line arguments containing commands and filenames
- * @param paths String containing the PATH environment variable content
- * @param pipe_fds Array of pipe file descriptors for interprocess communication
- *
- * @return None, but exits process on successful execution or handles errors
- */
-static void	execute_last_cmd(char *argv[], char **paths, int *pipe_fds)
+void	execute_cmd(t_pinfo *pinfo, char *argv[])
 {
-	extern char	**environ;
-	char		**args;
-	char		*cmd_path;
-
-	if (set_outfile(argv[4]))
-		return ;
-	cmd_path = get_cmd_path(argv[3], paths);
-	if (!cmd_path)
-	{
-		ft_matrix_free((void **)paths, 0);
-		clean_pipe(pipe_fds);
-		ft_perror("Command not found", 0, 127);
-	}
-	args = ft_split(argv[3], ' ');
-	if (dup2(pipe_fds[0], STDIN_FILENO) != -1)
+	if (redirect_endpoint(pinfo, argv))
 	{
-		ft_matrix_free((void **)paths, 0);
-		clean_pipe(pipe_fds);
-		execve(cmd_path, args, environ);
+		clean_pinfo(pinfo);
+		return ;
 	}
-	execution_cleanup(cmd_path, args);
-}
-
-void	execute_cmd(char *argv[], char **paths, int *pipe_fds, int i)
-{
-	if (i == 2)
-		execute_first_cmd(argv, paths, pipe_fds);
+	if (pinfo->i == 2)
+		exec_stage(pinfo, &pinfo->stages[0], -1, pinfo->pipe_fds[1]);
 	else
-		execute_last_cmd(argv, paths, pipe_fds);
-	clean_pipe(pipe_fds);
-	ft_matrix_free((void **)paths, 0);
+		exec_stage(pinfo, &pinfo->stages[1], pinfo->pipe_fds[0], -1);
 }
@@ -6,22 +6,39 @@
 /*   By: pablo <pablo@student.42.fr>                +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/04/05 19:10:05 by pablo             #+#    #+#             */
-/*   Updated: 2025/05/22 22:05:05 by pablo            ###   ########.fr       */
+/*   Updated: 2026/10/17 07:48:43 by pabmart2         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "pipex.h"
 
-int	set_infile(char file[])
+int	open_infile(char file[])
 {
 	int	file_fd;
 
-	file_fd = open(file, O_RDONLY);
+	file_fd = open(file, O_RDONLY | O_CLOEXEC);
 	if (file_fd == -1)
-	{
 		perror("Error opening infile");
+	return (file_fd);
+}
+
+int	open_outfile(char file[])
+{
+	int	file_fd;
+
+	file_fd = open(file, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (file_fd == -1)
+		perror("Error opening outfile");
+	return (file_fd);
+}
+
+int	set_infile(char file[])
+{
+	int	file_fd;
+
+	file_fd = open_infile(file);
+	if (file_fd == -1)
 		return (1);
-	}
 	if (dup2(file_fd, STDIN_FILENO) == -1)
 	{
 		perror("Error duplicating file");
@@ -39,12 +56,9 @@ int	set_outfile(char file[])
 {
 	int	file_fd;
 
-	file_fd = open(file, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	file_fd = open_outfile(file);
 	if (file_fd == -1)
-	{
-		perror("Error opening outfile");
 		return (1);
-	}
 	if (dup2(file_fd, STDOUT_FILENO) == -1)
 	{
 		perror("Error duplicating file");
@@ -6,7 +6,7 @@
 /*   By: pablo <pablo@student.42.fr>                +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/04/07 13:16:10 by pablo             #+#    #+#             */
-/*   Updated: 2025/05/22 22:13:13 by pablo            ###   ########.fr       */
+/*   Updated: 2026/10/17 10:58:08 by pabmart2         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -20,51 +20,125 @@
  * the child's PID. If fork fails, it cleans up resources and exits with an
  * error.
  *
- * @param i Index of the command in the pipeline
+ * @param pinfo Pipeline information. pinfo->i is the argv index of the
+ *              command to execute.
  * @param argv Array of arguments, including the command to execute
- * @param pipe_fds Array of pipe file descriptors for the pipeline
- * @param paths Matrix containing PATH information for executable lookup
  *
- * @return The process ID of the child, or -1 if fork failed
+ * @return The process ID of the child
  */
-static pid_t	handle_fork(int i, char *argv[], int *pipe_fds, char **paths)
+static pid_t	handle_fork(t_pinfo *pinfo, char *argv[])
 {
 	pid_t	pid;
 
 	pid = fork();
 	if (pid == 0)
 	{
-		execute_cmd(argv, paths, pipe_fds, i);
+		execute_cmd(pinfo, argv);
 		exit(EXIT_FAILURE);
 	}
 	else if (pid == -1)
 	{
+		clean_pinfo(pinfo);
 		ft_perror("Error forking", 0, EXIT_FAILURE);
-		clean_pipe(pipe_fds);
-		ft_matrix_free((void **)paths, 0);
 	}
 	return (pid);
 }
 
-int	fork_loop(int argc, char *argv[], int *pipe_fds)
+/**
+ * @brief Launches the command at argv[pinfo->i] with the selected backend
+ *        and records how long the launch took.
+ *
+ * With PIPEX_SPLICE, a command whose endpoint file could not be opened by
+ * the parent is not launched and gets the status a forked child would have
+ * exited with.
+ *
+ * @param pinfo Pipeline information. pinfo->i is the argv index of the
+ *              command to launch.
+ * @param argv Array of arguments, including the command to execute
+ */
+static void	launch_stage(t_pinfo *pinfo, char *argv[])
 {
-	int		i;
-	pid_t	pid;
-	char	**paths;
+	t_stage			*stage;
+	struct timespec	start;
 
-	paths = ft_split(ft_getenv("PATH"), ':');
-	if (!paths)
+	stage = &pinfo->stages[pinfo->i - 2];
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	if (pinfo->opts.splice && pinfo->relays[pinfo->i - 2].in == -1)
 	{
-		clean_pipe(pipe_fds);
-		ft_perror("Error getting cmd paths", 0, EXIT_FAILURE);
+		stage->pid = -1;
+		stage->status = EXIT_FAILURE;
 	}
-	i = 2;
-	while (i < argc - 1)
+	else if (pinfo->opts.launch == LAUNCH_SPAWN)
+		stage->pid = handle_spawn(pinfo, argv);
+	else
+		stage->pid = handle_fork(pinfo, argv);
+	stage->launch_ns = elapsed_ns(&start);
+	arm_stage(pinfo, pinfo->i - 2);
+}
+
+/**
+ * @brief Releases the parent's copy of the pipe, pumps the endpoint relays
+ *        when PIPEX_SPLICE is enabled and waits for both stages.
+ *
+ * @param pinfo Pointer to a t_pinfo structure with every stage launched.
+ * @return The exit status of the last stage.
+ */
+static int	finish_pipeline(t_pinfo *pinfo)
+{
+	clean_pipe(pinfo->pipe_fds);
+	pinfo->pipe_fds = NULL;
+	close_relay_ends(pinfo);
+	signal(SIGPIPE, SIG_IGN);
+	run_relays(pinfo);
+	return (wait_childs(pinfo));
+}
+
+/**
+ * @brief Plans every stage, then sets the relays and links requested by the
+ *        runtime options.
+ *
+ * Nothing is opened or launched if a command cannot be found.
+ *
+ * @param pinfo Pipeline information, with no stage launched yet.
+ * @param argv Array of command-line arguments
+ * @return 0 on success, or the status to exit with, see plan_stages().
+ */
+static int	prepare_pipeline(t_pinfo *pinfo, char *argv[])
+{
+	int	status;
+
+	status = plan_stages(pinfo, argv);
+	if (status)
+		return (status);
+	if (pinfo->opts.splice && set_relays(pinfo, argv))
+		return (1);
+	if (pinfo->opts.pipe_size || pinfo->opts.instrument)
+		set_links(pinfo);
+	if (pinfo->opts.instrument && set_link_relays(pinfo))
+		return (1);
+	return (0);
+}
+
+int	fork_loop(int argc, char *argv[], t_arena *arena, int *pipe_fds)
+{
+	t_pinfo	*pinfo;
+	int		exit_status;
+
+	pinfo = set_pinfo(arena, pipe_fds);
+	if (!pinfo)
+		return (clean_pipe(pipe_fds), ft_arena_destroy(arena), 1);
+	exit_status = prepare_pipeline(pinfo, argv);
+	if (exit_status)
+		return (clean_pinfo(pinfo), exit_status);
+	pinfo->i = 2;
+	while (pinfo->i < argc - 1)
 	{
-		pid = handle_fork(i, argv, pipe_fds, paths);
-		++i;
+		launch_stage(pinfo, argv);
+		++pinfo->i;
 	}
-	ft_matrix_free((void **)paths, 0);
-	clean_pipe(pipe_fds);
-	return (wait_childs(pid));
+	exit_status = finish_pipeline(pinfo);
+	if (pinfo->opts.stats)
+		report_stats(pinfo, argv);
+	clean_pinfo(pinfo);
+	return (exit_status);
 }
@@ -0,0 +1,72 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   json.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 07:46:52 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 09:18:49 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * @brief Writes s as the contents of a JSON string, escaping quotes,
+ *        backslashes and control characters.
+ *
+ * @param out Output buffer of the report.
+ * @param s The string to escape.
+ */
+static void	put_escaped(t_outbuf *out, const char *s)
+{
+	char	esc[7];
+	size_t	run;
+
+	while (*s)
+	{
+		run = 0;
+		while (s[run] && s[run] != '"' && s[run] != '\\'
+			&& (unsigned char)s[run] >= 0x20)
+			++run;
+		ft_outbuf_put(out, s, run);
+		s += run;
+		if (!*s)
+			return ;
+		ft_strlcpy(esc, "\\u0000", sizeof(esc));
+		esc[4] = "0123456789abcdef"[(unsigned char)*s >> 4];
+		esc[5] = "0123456789abcdef"[(unsigned char)*s & 0xf];
+		if (*s == '"' || *s == '\\')
+			ft_strlcpy(esc + 1, s, 2);
+		json_put(out, esc);
+		++s;
+	}
+}
+
+void	json_put(t_outbuf *out, const char *raw)
+{
+	ft_outbuf_put(out, raw, ft_strlen(raw));
+}
+
+void	json_key_str(t_outbuf *out, const char *key, const char *value)
+{
+	json_put(out, "\"");
+	json_put(out, key);
+	json_put(out, "\":\"");
+	put_escaped(out, value);
+	json_put(out, "\"");
+}
+
+void	json_key_num(t_outbuf *out, const char *key, long value)
+{
+	json_put(out, "\"");
+	json_put(out, key);
+	json_put(out, "\":");
+	if (value < 0)
+		json_put(out, "-");
+	if (value < 0)
+		ft_outbuf_num(out, -(unsigned long)value, "0123456789");
+	else
+		ft_outbuf_num(out, value, "0123456789");
+}
@@ -0,0 +1,78 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   links.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 07:56:29 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 08:03:32 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * @brief Reads the largest capacity an unprivileged pipe may be given.
+ *
+ * @return The value of PIPE_MAX_FILE, or PIPE_MAX_DEFAULT if it cannot be
+ *         read.
+ */
+static int	pipe_max_size(void)
+{
+	char	buffer[32];
+	ssize_t	n;
+	int		fd;
+
+	n = -1;
+	fd = open(PIPE_MAX_FILE, O_RDONLY | O_CLOEXEC);
+	if (fd != -1)
+	{
+		n = read(fd, buffer, sizeof(buffer) - 1);
+		close(fd);
+	}
+	if (n <= 0)
+		return (PIPE_MAX_DEFAULT);
+	buffer[n] = '\0';
+	return (ft_atoi(buffer));
+}
+
+void	resize_link(t_link *link, int fd, long size)
+{
+	if (size > link->max)
+		size = link->max;
+	if (fcntl(fd, F_SETPIPE_SZ, (int)size) == -1)
+	{
+		perror("Error resizing pipe");
+		link->max = link->size;
+	}
+	else
+		link->size = fcntl(fd, F_GETPIPE_SZ);
+}
+
+void	set_links(t_pinfo *pinfo)
+{
+	t_link	*link;
+	long	size;
+
+	link = &pinfo->links[0];
+	link->max = pipe_max_size();
+	link->size = fcntl(pinfo->pipe_fds[0], F_GETPIPE_SZ);
+	size = pipe_size_opt(pinfo->opts.pipe_size, 0);
+	if (size > 0)
+		resize_link(link, pinfo->pipe_fds[0], size);
+	else if (size == -1)
+	{
+		link->autosize = 1;
+		link->rd = fcntl(pinfo->pipe_fds[0], F_DUPFD_CLOEXEC, 0);
+		if (link->rd == -1)
+			perror("Error duplicating pipe");
+	}
+}
+
+void	close_link(t_link *link)
+{
+	if (link->rd != -1 && close(link->rd) == -1)
+		perror("Error closing pipe");
+	link->rd = -1;
+}
@@ -6,7 +6,7 @@
 /*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/04/02 11:59:19 by pablo             #+#    #+#             */
-/*   Updated: 2025/05/26 19:32:42 by pabmart2         ###   ########.fr       */
+/*   Updated: 2026/10/17 08:41:41 by pabmart2         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -15,14 +15,19 @@
 
 int	main(int argc, char *argv[])
 {
-	int	*pipe_fds;
+	t_arena	arena;
+	int		*pipe_fds;
 
 	if (argc < 5)
 		ft_perror("Not enough arguments", EINVAL, EXIT_FAILURE);
 	else if (argc > 5)
 		ft_perror("Too many arguments", EINVAL, EXIT_FAILURE);
-	pipe_fds = create_pipe();
+	ft_arena_init(&arena);
+	pipe_fds = create_pipe(&arena);
 	if (!pipe_fds)
+	{
+		ft_arena_destroy(&arena);
 		ft_perror("Error creating pipes", 0, EXIT_FAILURE);
-	return (fork_loop(argc, argv, pipe_fds));
+	}
+	return (fork_loop(argc, argv, &arena, pipe_fds));
 }
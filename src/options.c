@@ -0,0 +1,103 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   options.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 07:46:07 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 08:32:26 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * @brief Reads a boolean option from the environment.
+ *
+ * @param name Name of the environment variable.
+ * @return 1 if the variable is set to anything other than "" or "0", 0
+ *         otherwise.
+ */
+static char	env_flag(const char *name)
+{
+	char	*value;
+
+	value = ft_getenv(name);
+	return (value && *value && ft_strncmp(value, "0", 2) != 0);
+}
+
+/**
+ * @brief Finds an entry of a comma separated option list.
+ *
+ * @param spec The option value.
+ * @param index Index of the entry, from 0.
+ * @return The start of the entry, or of the last one if the list is shorter.
+ */
+static const char	*list_entry(const char *spec, size_t index)
+{
+	while (index-- > 0 && ft_strchr(spec, ','))
+		spec = ft_strchr(spec, ',') + 1;
+	return (spec);
+}
+
+void	set_popts(t_popts *opts)
+{
+	char	*value;
+
+	opts->launch = LAUNCH_FORK;
+	value = ft_getenv("PIPEX_LAUNCH");
+	if (value && ft_strncmp(value, "spawn", 6) == 0)
+		opts->launch = LAUNCH_SPAWN;
+	opts->stats = env_flag("PIPEX_STATS");
+	opts->splice = env_flag("PIPEX_SPLICE");
+	opts->instrument = env_flag("PIPEX_INSTRUMENT");
+	opts->pipefail = env_flag("PIPEX_PIPEFAIL");
+	opts->pipe_size = ft_getenv("PIPEX_PIPE_SIZE");
+	if (opts->pipe_size && !*opts->pipe_size)
+		opts->pipe_size = NULL;
+	opts->timeout_ms = duration_opt(ft_getenv("PIPEX_TIMEOUT"), 0);
+	opts->stage_timeout = ft_getenv("PIPEX_STAGE_TIMEOUT");
+	if (opts->stage_timeout && !*opts->stage_timeout)
+		opts->stage_timeout = NULL;
+	opts->path_index = PATH_INDEX_STAGES;
+	value = ft_getenv("PIPEX_PATH_INDEX");
+	if (value && *value)
+		opts->path_index = ft_atoi(value);
+}
+
+long	pipe_size_opt(const char *spec, size_t link)
+{
+	long	size;
+
+	if (!spec)
+		return (0);
+	spec = list_entry(spec, link);
+	if (ft_strncmp(spec, "auto", 4) == 0 && (!spec[4] || spec[4] == ','))
+		return (-1);
+	size = 0;
+	while (ft_isdigit(*spec) && size <= INT_MAX)
+		size = size * 10 + *spec++ - '0';
+	if (*spec == 'k' || *spec == 'K')
+		size *= 1024;
+	else if (*spec == 'm' || *spec == 'M')
+		size *= 1024 * 1024;
+	return (size);
+}
+
+long	duration_opt(const char *spec, size_t index)
+{
+	long	ms;
+
+	if (!spec)
+		return (0);
+	spec = list_entry(spec, index);
+	ms = 0;
+	while (ft_isdigit(*spec) && ms <= INT_MAX)
+		ms = ms * 10 + *spec++ - '0';
+	if (spec[0] == 'm' && spec[1] == 's')
+		return (ms);
+	if (spec[0] == 'm')
+		return (ms * 60000);
+	return (ms * 1000);
+}
@@ -0,0 +1,73 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   path_index_dir.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 08:32:25 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 08:41:42 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * @brief Reads a PATH directory with getdents64(2) and adds its entries to
+ *        the index.
+ *
+ * Every entry is added, whatever its type or mode: the single access(2)
+ * done by path_index_lookup() decides whether it can be executed, just as
+ * when probing.
+ *
+ * @param index The index.
+ * @param path The directory.
+ * @param dir Index of the directory in PATH.
+ * @return 0 on success, or if the directory does not exist, 1 otherwise.
+ */
+static int	scan_dir(t_path_index *index, const char *path, size_t dir)
+{
+	unsigned long	buf[PATH_INDEX_DIRENT / sizeof(unsigned long)];
+	t_dirent64		*entry;
+	long			len;
+	long			pos;
+	int				fd;
+
+	fd = open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+	if (fd == -1)
+		return (errno != ENOENT && errno != ENOTDIR);
+	len = syscall(SYS_getdents64, fd, buf, sizeof(buf));
+	while (len > 0)
+	{
+		pos = 0;
+		while (pos < len)
+		{
+			entry = (t_dirent64 *)((char *)buf + pos);
+			pos += entry->d_reclen;
+			if (path_index_add(index, entry->d_name, dir))
+				return (close(fd), 1);
+		}
+		len = syscall(SYS_getdents64, fd, buf, sizeof(buf));
+	}
+	close(fd);
+	return (len < 0);
+}
+
+int	path_index_build(t_path_index *index, char **paths)
+{
+	ft_bzero(index, sizeof(t_path_index));
+	while (paths[index->n_dirs])
+	{
+		if (scan_dir(index, paths[index->n_dirs], index->n_dirs))
+			return (path_index_clean(index), 1);
+		++index->n_dirs;
+	}
+	index->state = 1;
+	return (0);
+}
+
+void	path_index_clean(t_path_index *index)
+{
+	ft_arena_destroy(&index->arena);
+	ft_bzero(index, sizeof(t_path_index));
+}
@@ -0,0 +1,59 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pinfo.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 07:46:07 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 08:41:42 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+void	close_pinfo(t_pinfo *pinfo)
+{
+	if (pinfo->pipe_fds)
+		clean_pipe(pinfo->pipe_fds);
+	pinfo->pipe_fds = NULL;
+	close_relay(&pinfo->relays[0]);
+	close_relay(&pinfo->relays[1]);
+	close_relay(&pinfo->relays[2]);
+	close_relay_ends(pinfo);
+	close_link(&pinfo->links[0]);
+	cmd_cache_close(&pinfo->cmd_cache);
+}
+
+void	clean_pinfo(t_pinfo *pinfo)
+{
+	close_pinfo(pinfo);
+	ft_arena_destroy(pinfo->arena);
+}
+
+t_pinfo	*set_pinfo(t_arena *arena, int *pipe_fds)
+{
+	t_pinfo	*pinfo;
+	char	*path;
+
+	path = ft_getenv("PATH");
+	if (!path)
+		path = "";
+	pinfo = ft_arena_calloc(arena, 1, sizeof(t_pinfo));
+	if (pinfo)
+		pinfo->paths = ft_arena_split(arena, path, ':');
+	if (!pinfo || !pinfo->paths)
+		return (perror("Error getting cmd paths"), NULL);
+	pinfo->arena = arena;
+	pinfo->pipe_fds = pipe_fds;
+	pinfo->stages[0].pid = -1;
+	pinfo->stages[1].pid = -1;
+	init_relay(&pinfo->relays[0], -1, -1);
+	init_relay(&pinfo->relays[1], -1, -1);
+	init_relay(&pinfo->relays[2], -1, -1);
+	pinfo->relay_ends[0] = -1;
+	pinfo->relay_ends[1] = -1;
+	pinfo->links[0].rd = -1;
+	set_popts(&pinfo->opts);
+	return (pinfo);
+}
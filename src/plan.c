@@ -0,0 +1,67 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   plan.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 08:28:39 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 08:41:42 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * @brief Tokenizes the command of a stage and resolves its executable.
+ *
+ * @param pinfo Pipeline information holding the PATH array, the command
+ *              cache and the arena.
+ * @param stage The stage to plan.
+ * @param cmd Command string of the stage as given on the command line.
+ * @param index The PATH index, see path_index_build().
+ * @return 0 on success, 127 if the command is empty or was not found, 2 if
+ *         it leaves a quote open, or 1 if memory could not be allocated.
+ */
+static int	plan_stage(t_pinfo *pinfo, t_stage *stage, char *cmd,
+		t_path_index *index)
+{
+	stage->args = split_args(pinfo->arena, cmd);
+	if (!stage->args && errno == EINVAL)
+		return (ft_perror("Unterminated quote in command", 0, 0), 2);
+	if (!stage->args)
+		return (perror("Error splitting arguments from command"), 1);
+	stage->path = get_cmd_path(pinfo, stage->args[0], index);
+	if (!stage->path)
+	{
+		stage->status = 127;
+		if (stage->args[0])
+			ft_perror("Command not found", 0, 0);
+		return (127);
+	}
+	return (0);
+}
+
+int	plan_stages(t_pinfo *pinfo, char *argv[])
+{
+	t_path_index	index;
+	size_t			i;
+	int				status;
+	int				error;
+
+	ft_bzero(&index, sizeof(t_path_index));
+	if (pinfo->opts.path_index > 0
+		&& 2 >= (size_t)pinfo->opts.path_index)
+		path_index_build(&index, pinfo->paths);
+	status = 0;
+	i = 0;
+	while (i < 2 && status != 1)
+	{
+		error = plan_stage(pinfo, &pinfo->stages[i], argv[2 + i], &index);
+		if (error)
+			status = error;
+		++i;
+	}
+	path_index_clean(&index);
+	return (status);
+}
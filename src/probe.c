@@ -0,0 +1,94 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   probe.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 08:05:21 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 08:19:47 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+long	elapsed_ns(struct timespec *start)
+{
+	struct timespec	now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((now.tv_sec - start->tv_sec) * 1000000000L
+		+ (now.tv_nsec - start->tv_nsec));
+}
+
+long	now_ns(void)
+{
+	struct timespec	now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec * 1000000000L + now.tv_nsec);
+}
+
+/**
+ * @brief Accounts the time since the previous sample to the state found
+ *        then, and samples the fill level of the relay pipes again.
+ *
+ * @param relay The relay to sample.
+ * @param dt Nanoseconds since the previous sample.
+ */
+static void	sample_relay(t_relay *relay, long dt)
+{
+	int	avail;
+
+	if (relay->in == -1)
+		return ;
+	relay->blocked_ns += relay->blocked * dt;
+	relay->wait_ns += relay->waiting * dt;
+	relay->blocked = relay->poll_in
+		&& ioctl(relay->in, FIONREAD, &avail) != -1
+		&& avail + PIPE_BUF > fcntl(relay->in, F_GETPIPE_SZ);
+	relay->waiting = relay->poll_out
+		&& ioctl(relay->out, FIONREAD, &avail) != -1 && avail == 0;
+}
+
+int	set_link_relays(t_pinfo *pinfo)
+{
+	int	fds[2];
+
+	if (pipe2(fds, O_CLOEXEC) == -1)
+		return (perror("Error creating pipe"), 1);
+	if (fcntl(pinfo->pipe_fds[0], F_SETFD, FD_CLOEXEC) == -1)
+	{
+		close(fds[0]);
+		close(fds[1]);
+		return (perror("Error creating pipe"), 1);
+	}
+	init_relay(&pinfo->relays[2], pinfo->pipe_fds[0], fds[1]);
+	pinfo->relays[2].poll_in = 1;
+	pinfo->relays[2].poll_out = 1;
+	pinfo->pipe_fds[0] = fds[0];
+	return (0);
+}
+
+int	relay_tick(t_pinfo *pinfo)
+{
+	long	dt;
+	int		timeout;
+
+	timeout = check_deadlines(pinfo);
+	if (tune_links(pinfo))
+		timeout = sooner(timeout, PIPE_TUNE_MS);
+	if (pinfo->opts.pipefail && reap_stages(pinfo))
+		timeout = sooner(timeout, SUPERVISE_POLL_MS);
+	if (!pinfo->opts.instrument)
+		return (timeout);
+	dt = elapsed_ns(&pinfo->sampled_at);
+	if (dt >= RELAY_SAMPLE_MS * 1000000L)
+	{
+		clock_gettime(CLOCK_MONOTONIC, &pinfo->sampled_at);
+		sample_relay(&pinfo->relays[0], dt);
+		sample_relay(&pinfo->relays[1], dt);
+		sample_relay(&pinfo->relays[2], dt);
+	}
+	return (RELAY_SAMPLE_MS);
+}
@@ -0,0 +1,89 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   relay.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 07:50:31 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 08:07:12 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+void	init_relay(t_relay *relay, int in, int out)
+{
+	ft_bzero(relay, sizeof(t_relay));
+	relay->in = in;
+	relay->out = out;
+	relay->slot[0] = -1;
+	relay->slot[1] = -1;
+	if (in == -1 || out == -1)
+		close_relay(relay);
+}
+
+void	close_relay(t_relay *relay)
+{
+	if (relay->in != -1 && close(relay->in) == -1)
+		perror("Error closing relay");
+	if (relay->out != -1 && close(relay->out) == -1)
+		perror("Error closing relay");
+	relay->in = -1;
+	relay->out = -1;
+}
+
+int	set_relays(t_pinfo *pinfo, char *argv[])
+{
+	int	in_pipe[2];
+	int	out_pipe[2];
+
+	if (pipe2(in_pipe, O_CLOEXEC) == -1)
+		return (perror("Error creating pipe"), 1);
+	if (pipe2(out_pipe, O_CLOEXEC) == -1)
+	{
+		close(in_pipe[0]);
+		close(in_pipe[1]);
+		return (perror("Error creating pipe"), 1);
+	}
+	init_relay(&pinfo->relays[0], open_infile(argv[1]), in_pipe[1]);
+	pinfo->relays[0].poll_out = 1;
+	init_relay(&pinfo->relays[1], out_pipe[0], open_outfile(argv[4]));
+	pinfo->relays[1].poll_in = 1;
+	pinfo->relay_ends[0] = in_pipe[0];
+	pinfo->relay_ends[1] = out_pipe[1];
+	if (pinfo->relays[0].in != -1)
+		posix_fadvise(pinfo->relays[0].in, 0, 0, POSIX_FADV_SEQUENTIAL);
+	return (0);
+}
+
+void	close_relay_ends(t_pinfo *pinfo)
+{
+	if (pinfo->relay_ends[0] != -1 && close(pinfo->relay_ends[0]) == -1)
+		perror("Error closing relay");
+	if (pinfo->relay_ends[1] != -1 && close(pinfo->relay_ends[1]) == -1)
+		perror("Error closing relay");
+	pinfo->relay_ends[0] = -1;
+	pinfo->relay_ends[1] = -1;
+}
+
+ssize_t	relay_rw(t_relay *relay)
+{
+	char	buffer[RELAY_CHUNK];
+	ssize_t	n;
+	ssize_t	written;
+	ssize_t	total;
+
+	n = read(relay->in, buffer, RELAY_CHUNK);
+	relay->reads += n > 0;
+	total = 0;
+	while (n > 0 && total < n)
+	{
+		written = write(relay->out, buffer + total, n - total);
+		if (written == -1)
+			return (-1);
+		++relay->writes;
+		total += written;
+	}
+	return (n);
+}
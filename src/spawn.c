@@ -0,0 +1,135 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   spawn.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 07:46:35 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 08:28:41 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * @brief Opens the endpoint file of the stage and picks the descriptors that
+ *        will become its standard input and output.
+ *
+ * With PIPEX_SPLICE the endpoint is the relay pipe end instead.
+ *
+ * @param pinfo Pipeline information. pinfo->i is the argv index of the
+ *              command to launch.
+ * @param argv Array of command line arguments
+ * @param fds Filled with [stdin_fd, stdout_fd] for the stage.
+ *
+ * @return 0 on success, 1 if the endpoint file could not be opened.
+ */
+static int	set_stage_fds(t_pinfo *pinfo, char *argv[], int *fds)
+{
+	if (pinfo->i == 2)
+	{
+		fds[0] = pinfo->relay_ends[0];
+		if (!pinfo->opts.splice)
+			fds[0] = open_infile(argv[1]);
+		fds[1] = pinfo->pipe_fds[1];
+		return (fds[0] == -1);
+	}
+	fds[0] = pinfo->pipe_fds[0];
+	fds[1] = pinfo->relay_ends[1];
+	if (!pinfo->opts.splice)
+		fds[1] = open_outfile(argv[4]);
+	return (fds[1] == -1);
+}
+
+/**
+ * @brief Closes the endpoint file opened by set_stage_fds(), if any.
+ *
+ * Relay pipe ends are left open, close_relay_ends() takes care of them.
+ *
+ * @param pinfo Pipeline information. pinfo->i is the argv index of the
+ *              command being launched.
+ * @param fds The [stdin_fd, stdout_fd] pair of the stage.
+ */
+static void	close_endpoint(t_pinfo *pinfo, int *fds)
+{
+	int	file_fd;
+
+	if (pinfo->opts.splice)
+		return ;
+	file_fd = fds[1];
+	if (pinfo->i == 2)
+		file_fd = fds[0];
+	if (file_fd != -1 && close(file_fd) == -1)
+		perror("Error closing file");
+}
+
+/**
+ * @brief Expresses the dup2()/close() wiring of a forked child as spawn file
+ *        actions.
+ *
+ * The endpoint file descriptor is opened with O_CLOEXEC, so only the pipe
+ * needs to be closed explicitly.
+ *
+ * @param actions The file actions object to initialize.
+ * @param fds The [stdin_fd, stdout_fd] pair of the stage.
+ * @param pipe_fds The pipe between both commands.
+ *
+ * @return 0 on success, 1 on failure. On failure actions is left destroyed.
+ */
+static int	set_file_actions(posix_spawn_file_actions_t *actions, int *fds,
+		int *pipe_fds)
+{
+	if (posix_spawn_file_actions_init(actions))
+		return (1);
+	if (posix_spawn_file_actions_adddup2(actions, fds[0], STDIN_FILENO)
+		|| posix_spawn_file_actions_adddup2(actions, fds[1], STDOUT_FILENO)
+		|| posix_spawn_file_actions_addclose(actions, pipe_fds[0])
+		|| posix_spawn_file_actions_addclose(actions, pipe_fds[1]))
+	{
+		posix_spawn_file_actions_destroy(actions);
+		return (1);
+	}
+	return (0);
+}
+
+/**
+ * @brief Spawns the planned command of a stage with its file actions.
+ *
+ * @param pinfo Pipeline information holding the pipe.
+ * @param stage The stage to spawn, resolved by plan_stages().
+ * @param fds The [stdin_fd, stdout_fd] pair of the stage.
+ *
+ * @return The PID of the new process, or -1 with an error message printed.
+ */
+static pid_t	spawn_cmd(t_pinfo *pinfo, t_stage *stage, int *fds)
+{
+	extern char					**environ;
+	posix_spawn_file_actions_t	actions;
+	pid_t						pid;
+	int							err;
+
+	if (set_file_actions(&actions, fds, pinfo->pipe_fds))
+		return (perror("Error preparing spawn"), -1);
+	err = posix_spawn(&pid, stage->path, &actions, NULL, stage->args,
+			environ);
+	posix_spawn_file_actions_destroy(&actions);
+	if (err)
+		return (ft_perror("Error executing command", err, 0), -1);
+	return (pid);
+}
+
+pid_t	handle_spawn(t_pinfo *pinfo, char *argv[])
+{
+	t_stage	*stage;
+	int		fds[2];
+	pid_t	pid;
+
+	stage = &pinfo->stages[pinfo->i - 2];
+	stage->status = EXIT_FAILURE;
+	if (set_stage_fds(pinfo, argv, fds))
+		return (close_endpoint(pinfo, fds), -1);
+	pid = spawn_cmd(pinfo, stage, fds);
+	close_endpoint(pinfo, fds);
+	return (pid);
+}
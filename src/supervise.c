@@ -0,0 +1,133 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   supervise.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 08:14:49 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 10:21:07 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * @brief Registers the pidfd of every launched stage in a new epoll
+ *        instance.
+ *
+ * @param pinfo Pipeline information.
+ * @return The epoll descriptor, or -1 if some stage cannot be watched, in
+ *         which case the stages are polled every SUPERVISE_POLL_MS instead.
+ */
+static int	watch_stages(t_pinfo *pinfo)
+{
+	struct epoll_event	event;
+	int					epfd;
+	size_t				i;
+
+	epfd = epoll_create1(EPOLL_CLOEXEC);
+	i = 0;
+	while (epfd != -1 && i < 2)
+	{
+		event.events = EPOLLIN;
+		event.data.u64 = i;
+		if (pinfo->stages[i].pid != -1 && !pinfo->stages[i].reaped
+			&& (pinfo->stages[i].pidfd == -1 || epoll_ctl(epfd, EPOLL_CTL_ADD,
+					pinfo->stages[i].pidfd, &event) == -1))
+		{
+			close(epfd);
+			epfd = -1;
+		}
+		++i;
+	}
+	return (epfd);
+}
+
+/**
+ * @brief Reaps a stage if it has exited, without blocking.
+ *
+ * @param pinfo Pipeline information.
+ * @param index Index of the stage, from 0.
+ * @return 1 if the stage is still running, 0 otherwise.
+ */
+static int	reap_stage(t_pinfo *pinfo, size_t index)
+{
+	t_stage			*stage;
+	struct rusage	usage;
+	int				status;
+	pid_t			pid;
+
+	stage = &pinfo->stages[index];
+	if (stage->pid == -1 || stage->reaped)
+		return (0);
+	pid = wait4(stage->pid, &status, WNOHANG, &usage);
+	if (pid == stage->pid)
+		set_stage_status(pinfo, index, status, &usage);
+	else if (pid == -1 && errno != EINTR)
+	{
+		perror("Error al esperar a los procesos hijos");
+		close(stage->pidfd);
+		stage->pidfd = -1;
+		stage->reaped = 1;
+	}
+	return (!stage->reaped);
+}
+
+size_t	reap_stages(t_pinfo *pinfo)
+{
+	size_t	running;
+	size_t	i;
+
+	running = 0;
+	i = 2;
+	while (i > 0)
+		running += reap_stage(pinfo, --i);
+	return (running);
+}
+
+/**
+ * @brief Runs the periodic work of the supervisor and tells how long it may
+ *        sleep.
+ *
+ * @param pinfo Pipeline information.
+ * @param epfd The epoll descriptor watching the stages, or -1.
+ * @return Milliseconds until the next deadline, auto-tuning sample or poll
+ *         of the stages, or -1 to sleep until a stage exits.
+ */
+static int	supervise_timeout(t_pinfo *pinfo, int epfd)
+{
+	int	timeout;
+
+	timeout = check_deadlines(pinfo);
+	if (tune_links(pinfo))
+		timeout = sooner(timeout, PIPE_TUNE_MS);
+	if (epfd == -1)
+		timeout = sooner(timeout, SUPERVISE_POLL_MS);
+	return (timeout);
+}
+
+int	wait_childs(t_pinfo *pinfo)
+{
+	struct epoll_event	event;
+	int					epfd;
+	int					timeout;
+
+	epfd = watch_stages(pinfo);
+	while (reap_stages(pinfo) > 0)
+	{
+		timeout = supervise_timeout(pinfo, epfd);
+		if (epfd != -1 && epoll_wait(epfd, &event, 1, timeout) == -1
+			&& errno != EINTR)
+		{
+			perror("Error al esperar a los procesos hijos");
+			close(epfd);
+			epfd = -1;
+		}
+		else if (epfd == -1)
+			poll(NULL, 0, timeout);
+	}
+	if (epfd != -1)
+		close(epfd);
+	return (pipeline_status(pinfo));
+}
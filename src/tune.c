@@ -0,0 +1,72 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   tune.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: pabmart2 <pabmart2@student.42malaga.com    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 08:02:57 by pabmart2          #+#    #+#             */
+/*   Updated: 2026/10/17 08:02:57 by pabmart2         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "pipex.h"
+
+/**
+ * @brief Tells whether a stage has exited, without reaping it.
+ *
+ * @param pid PID of the stage, or -1 if it was not launched.
+ * @return 1 if the stage is gone, 0 if it is still running.
+ */
+static int	stage_exited(pid_t pid)
+{
+	siginfo_t	info;
+
+	if (pid == -1)
+		return (1);
+	info.si_pid = 0;
+	if (waitid(P_PID, pid, &info, WEXITED | WNOHANG | WNOWAIT) == -1)
+		return (1);
+	return (info.si_pid != 0);
+}
+
+/**
+ * @brief Samples the fill level of an auto-tuned link and doubles its
+ *        capacity once it has been found full PIPE_TUNE_STREAK times in a
+ *        row.
+ *
+ * @param link The link to sample.
+ */
+static void	tune_link(t_link *link)
+{
+	int	avail;
+	int	size;
+
+	if (ioctl(link->rd, FIONREAD, &avail) == -1)
+		return ;
+	if (avail + PIPE_BUF < link->size)
+		link->streak = 0;
+	else if (++link->streak >= PIPE_TUNE_STREAK && link->size < link->max)
+	{
+		link->streak = 0;
+		size = link->size;
+		resize_link(link, link->rd, (long)size * 2);
+		link->grows += link->size > size;
+	}
+}
+
+int	tune_links(t_pinfo *pinfo)
+{
+	t_link	*link;
+
+	link = &pinfo->links[0];
+	if (link->rd == -1)
+		return (0);
+	if (elapsed_ns(&pinfo->tuned_at) < PIPE_TUNE_MS * 1000000L)
+		return (1);
+	clock_gettime(CLOCK_MONOTONIC, &pinfo->tuned_at);
+	if (stage_exited(pinfo->stages[1].pid))
+		return (close_link(link), 0);
+	tune_link(link);
+	return (1);
+}
@@ -6,7 +6,7 @@
 /*   By: pablo <pablo@student.42.fr>                +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/04/05 18:29:14 by pablo             #+#    #+#             */
-/*   Updated: 2025/05/22 22:09:20 by pablo            ###   ########.fr       */
+/*   Updated: 2026/10/17 08:41:42 by pabmart2         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -21,43 +21,39 @@ void	clean_pipe(int *pipe_fds)
 		status = 1;
 	if (close(pipe_fds[1]) == -1)
 		status = 1;
-	ft_free((void **)&pipe_fds);
 	if (status)
 		ft_perror("Fatal error closing pipes", 0, 0);
 }
 
-int	wait_childs(pid_t last_pid)
+void	set_stage_status(t_pinfo *pinfo, size_t index, int status,
+		struct rusage *usage)
 {
-	pid_t	pid;
-	int		status;
-	int		exit_status;
+	t_stage	*stage;
 
-	exit_status = 0;
-	pid = waitpid(-1, &status, 0);
-	while (pid > 0)
-	{
-		if (pid == last_pid)
-		{
-			if (WIFEXITED(status))
-				exit_status = WEXITSTATUS(status);
-			else if (WIFSIGNALED(status))
-				exit_status = WEXITSTATUS(status);
-		}
-		pid = waitpid(-1, &status, 0);
-	}
-	if (pid == -1 && errno != ECHILD)
-		perror("Error al esperar a los procesos hijos");
-	return (exit_status);
+	stage = &pinfo->stages[index];
+	stage->usage = *usage;
+	if (WIFEXITED(status))
+		stage->status = WEXITSTATUS(status);
+	else if (WIFSIGNALED(status))
+		stage->status = 128 + WTERMSIG(status);
+	stage->reaped = 1;
+	stage->deadline_ns = 0;
+	if (stage->pidfd != -1)
+		close(stage->pidfd);
+	stage->pidfd = -1;
+	if (index > 0)
+		close_link(&pinfo->links[index - 1]);
+	check_pipefail(pinfo, index);
 }
 
-int	*create_pipe(void)
+int	*create_pipe(t_arena *arena)
 {
 	int	*pipe_fds;
 
-	pipe_fds = malloc(sizeof(int) * 2);
+	pipe_fds = ft_arena_alloc(arena, sizeof(int) * 2);
 	if (!pipe_fds)
 		return (perror("Error allocating pipe"), NULL);
 	if (pipe(pipe_fds) == -1)
-		return (perror ("Error creating pipe"), free(pipe_fds), NULL);
+		return (perror ("Error creating pipe"), NULL);
 	return (pipe_fds);
 }
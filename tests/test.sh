@@ -0,0 +1,146 @@
+#!/bin/bash
+# Regression checks, run by `make test`.
+#
+# Runs the mandatory and bonus binaries on cases with a known exit status
+# and output, and prints one line per check:
+#
+#   pipefail   PIPEX_PIPEFAIL blames the stage that failed, not the upstream
+#              stages it killed with SIGPIPE
+#   heredoc    here_doc stops at the delimiter, also when it straddles a
+#              HEREDOC_CHUNK read, copied to a memfd or streamed
+#   dag        pipex dag wires unquoted "{name}" references and <, >, >>
+#              only, and leaves quoted ones to the command as plain text
+#   shards     PIPEX_SHARDS gives the output of the single pipeline, and a
+#              missing command leaves the outfile untouched
+#
+# Checks that depend on the order in which stages exit are repeated
+# TEST_RUNS times (default 20). The exit status is the number of failed
+# checks.
+#
+# Tunables (environment):
+#   TEST_RUNS   runs of the order-dependent checks   (default 20)
+#   TEST_DIR    scratch directory                    (default /tmp/pipex-test)
+
+set -u
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+PIPEX=$ROOT/build/pipex
+PIPEX_BONUS=$ROOT/build_bonus/pipex
+DIR=${TEST_DIR:-/tmp/pipex-test}
+RUNS=${TEST_RUNS:-20}
+FAILED=0
+
+# Prints the result of a check and counts it if it failed.
+# $1: name, $2: 0 if it passed, $3: what went wrong otherwise.
+report() {
+	if [ "$2" -eq 0 ]; then
+		echo "ok    $1"
+	else
+		echo "FAIL  $1: $3"
+		FAILED=$((FAILED + 1))
+	fi
+}
+
+# Runs a pipex command RUNS times and checks its exit status every time.
+# $1: name, $2: expected status, $3: environment, rest: the command.
+expect_status() {
+	local name=$1 want=$2 env=$3 got i
+	shift 3
+	for ((i = 0; i < RUNS; i++)); do
+		env $env "$@" 2>/dev/null
+		got=$?
+		[ "$got" -eq "$want" ] || break
+	done
+	report "$name" $((got != want)) "exit status $got, expected $want"
+}
+
+# Runs a bonus here_doc pipeline of two cats, both copied to a memfd and
+# streamed, and compares what it appends with the expected body.
+# $1: name, $2: file fed to pipex, $3: file with the expected output.
+expect_heredoc() {
+	local name=$1 input=$2 want=$3 stream
+	for stream in 0 1; do
+		rm -f "$DIR/out"
+		PIPEX_HEREDOC_STREAM=$stream "$PIPEX_BONUS" here_doc EOF cat cat \
+			"$DIR/out" < "$input" 2>/dev/null
+		cmp -s "$want" "$DIR/out"
+		report "$name (stream=$stream)" $? \
+			"$(stat -c %s "$DIR/out" 2>/dev/null || echo no) bytes written, \
+expected $(stat -c %s "$want")"
+	done
+}
+
+# Runs a bonus DAG description and compares its exit status and output.
+# $1: name, $2: description, $3: expected status, $4: expected output.
+expect_dag() {
+	local name=$1 got out
+	printf '%s\n' "$2" > "$DIR/dag"
+	out=$(cd "$DIR" && timeout 10 "$PIPEX_BONUS" dag dag 2>/dev/null)
+	got=$?
+	[ "$got" -eq "$3" ] && [ "$out" = "$4" ]
+	report "$name" $? "exit status $got and output '$out', expected $3 \
+and '$4'"
+}
+
+dag() {
+	expect_dag "dag: references" "a: echo 1
+b: echo 2
+c: paste {a} {b}" 0 "$(printf '1\t2')"
+	expect_dag "dag: quoted braces" "a: printf '1\\n2\\n'
+b: awk '{print \$1 * 2}' < {a}" 0 "$(printf '2\n4')"
+	expect_dag "dag: quoted operator" "a: printf 'x<y\\nz\\n'
+b: grep '<' < {a}" 0 "x<y"
+	expect_dag "dag: quoted reference" "a: echo 1 > a.out
+b: echo \"{a}\" \\> {a}x '>' \"b.out\"" 0 "{a} > {a}x > b.out"
+	expect_dag "dag: unknown reference" "a: cat {b}
+b: echo 1" 2 ""
+}
+
+shards() {
+	seq 1 200000 > "$DIR/sh_in"
+	grep 1 < "$DIR/sh_in" | tr 1 x > "$DIR/sh_want"
+	rm -f "$DIR/out"
+	PIPEX_SHARDS=4 "$PIPEX_BONUS" "$DIR/sh_in" "grep 1" "tr 1 x" "$DIR/out" \
+		2>/dev/null
+	cmp -s "$DIR/sh_want" "$DIR/out"
+	report "shards: output" $? "differs from the single pipeline"
+	echo keep > "$DIR/out"
+	PIPEX_SHARDS=4 "$PIPEX_BONUS" "$DIR/sh_in" "grep 1" pipex-no-such-cmd \
+		"$DIR/out" 2>/dev/null
+	[ "$?" -eq 127 ] && [ "$(cat "$DIR/out")" = keep ]
+	report "shards: missing command" $? "outfile truncated or status not 127"
+}
+
+heredoc() {
+	printf 'a\nEOFx\n EOF\nb\n' > "$DIR/hd_want"
+	{ cat "$DIR/hd_want"; printf 'EOF\nafter\n'; } > "$DIR/hd_in"
+	expect_heredoc "heredoc: delimiter" "$DIR/hd_in" "$DIR/hd_want"
+	# 65500 bytes of lines, then a line of 34 that ends the first 64 KiB
+	# read 2 bytes into the delimiter.
+	{ for _ in $(seq 655); do printf '%099d\n' 0; done
+		printf '%033d\n' 0; } > "$DIR/hd_want"
+	{ cat "$DIR/hd_want"; printf 'EOF\nafter\n'; } > "$DIR/hd_in"
+	expect_heredoc "heredoc: delimiter across reads" "$DIR/hd_in" \
+		"$DIR/hd_want"
+	{ head -c 70000 /dev/zero | tr '\0' x; echo EOF; } > "$DIR/hd_want"
+	{ cat "$DIR/hd_want"; printf 'EOF\nafter\n'; } > "$DIR/hd_in"
+	expect_heredoc "heredoc: line longer than a read" "$DIR/hd_in" \
+		"$DIR/hd_want"
+}
+
+pipefail() {
+	expect_status "pipefail: downstream failure" 1 PIPEX_PIPEFAIL=1 \
+		"$PIPEX" /dev/zero cat false "$DIR/out"
+	expect_status "pipefail: downstream failure (bonus)" 1 PIPEX_PIPEFAIL=1 \
+		"$PIPEX_BONUS" /dev/zero cat cat false "$DIR/out"
+	expect_status "pipefail: upstream SIGPIPE" 141 PIPEX_PIPEFAIL=1 \
+		"$PIPEX_BONUS" /dev/zero cat "head -c 1" "$DIR/out"
+	expect_status "pipefail: first stage" 1 PIPEX_PIPEFAIL=1 \
+		"$PIPEX" /dev/null false cat "$DIR/out"
+}
+
+mkdir -p "$DIR"
+pipefail
+heredoc
+dag
+shards
+exit $FAILED